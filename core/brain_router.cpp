@@ -32,6 +32,9 @@ const std::unordered_map<std::string, std::vector<std::string>> BrainRouter::sem
     {"body", {"pain", "hurt", "tired", "sick", "healthy", "strong", "weak", "heart", "breath", "body"}}
 };
 
+BrainRouter::BrainRouter() : BrainRouter(RoutingConfig{}) {
+}
+
 BrainRouter::BrainRouter(const RoutingConfig& config) : config_(config) {
 }
 
@@ -59,11 +59,13 @@ public:
     };
 
 public:
+    BrainRouter();
+
     /**
      * @brief Constructor
      * @param config Routing configuration
      */
-    explicit BrainRouter(const RoutingConfig& config = RoutingConfig{});
+    explicit BrainRouter(const RoutingConfig& config);
 
     /**
      * @brief Route tokens to brain regions
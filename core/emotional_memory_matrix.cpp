@@ -0,0 +1,118 @@
+#include "emotional_memory_matrix.hpp"
+#include <algorithm>
+
+namespace neurosim {
+
+EmotionalMemoryMatrix::EmotionalMemoryMatrix(size_t capacity)
+    : capacity_(std::max<size_t>(1, capacity)), count_(0), head_(0), next_id_(1) {
+}
+
+uint64_t EmotionalMemoryMatrix::push(const Eigen::Ref<const Eigen::VectorXd>& pattern, double value) {
+    if (embeddings_.rows() == 0) {
+        // Dimension is fixed by the first memory
+        Eigen::Index rows = static_cast<Eigen::Index>(capacity_);
+        embeddings_.setZero(rows, pattern.size());
+        values_.setZero(rows);
+        norms_.setZero(rows);
+    }
+
+    Eigen::Index dim = embeddings_.cols();
+    Eigen::Index overlap = std::min(dim, pattern.size());
+    Eigen::Index slot = static_cast<Eigen::Index>(head_);
+
+    auto row = embeddings_.row(slot);
+    row.setZero();
+    row.head(overlap) = pattern.head(overlap).transpose();
+    double norm = row.norm();
+    if (norm > 0.0) {
+        row /= norm;
+    }
+    norms_(slot) = norm;
+    values_(slot) = value;
+
+    head_ = (head_ + 1) % capacity_;
+    count_ = std::min(count_ + 1, capacity_);
+    return next_id_++;
+}
+
+bool EmotionalMemoryMatrix::setValue(uint64_t id, double value) {
+    if (!contains(id)) {
+        return false;
+    }
+    values_(static_cast<Eigen::Index>(slotOf(id))) = value;
+    return true;
+}
+
+void EmotionalMemoryMatrix::clear() {
+    count_ = 0;
+    head_ = 0;
+}
+
+void EmotionalMemoryMatrix::topK(const Eigen::Ref<const Eigen::VectorXd>& input, size_t k,
+                                 double min_similarity, std::vector<Hit>& hits) const {
+    hits.clear();
+    Eigen::Index dim = dimension();
+    if (count_ == 0 || k == 0 || dim == 0 || input.size() == 0) {
+        return;
+    }
+
+    Eigen::Index overlap = std::min(dim, input.size());
+    query_.resize(dim);
+    query_.head(overlap) = input.head(overlap);
+    query_.tail(dim - overlap).setZero();
+    double norm = query_.norm();
+    if (norm == 0.0) {
+        return;
+    }
+    query_ /= norm;
+
+    // One GEMV over the live rows; slots are filled from 0 until the first wrap
+    Eigen::Index rows = static_cast<Eigen::Index>(count_);
+    scores_.resize(rows);
+    scores_.noalias() = embeddings_.topRows(rows) * query_;
+
+    candidates_.clear();
+    for (Eigen::Index slot = 0; slot < rows; ++slot) {
+        if (scores_(slot) > min_similarity) {
+            candidates_.emplace_back(scores_(slot), static_cast<size_t>(slot));
+        }
+    }
+
+    size_t kept = std::min(k, candidates_.size());
+    std::partial_sort(candidates_.begin(), candidates_.begin() + static_cast<std::ptrdiff_t>(kept),
+                      candidates_.end(),
+                      [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    // Slot -> id: the newest memory (id next_id_ - 1) sits just before head_
+    for (size_t i = 0; i < kept; ++i) {
+        size_t slot = candidates_[i].second;
+        size_t age = (head_ + capacity_ - 1 - slot) % capacity_;
+
+        Hit hit;
+        hit.id = next_id_ - 1 - age;
+        hit.similarity = candidates_[i].first;
+        hit.value = values_(static_cast<Eigen::Index>(slot));
+        hits.push_back(hit);
+    }
+}
+
+bool EmotionalMemoryMatrix::contains(uint64_t id) const {
+    return id < next_id_ && next_id_ - id <= count_;
+}
+
+bool EmotionalMemoryMatrix::get(uint64_t id, Eigen::VectorXd& pattern, double& value) const {
+    if (!contains(id)) {
+        return false;
+    }
+    Eigen::Index slot = static_cast<Eigen::Index>(slotOf(id));
+    pattern = embeddings_.row(slot).transpose() * norms_(slot);
+    value = values_(slot);
+    return true;
+}
+
+size_t EmotionalMemoryMatrix::slotOf(uint64_t id) const {
+    size_t age = static_cast<size_t>(next_id_ - 1 - id);
+    return (head_ + capacity_ - 1 - age % capacity_) % capacity_;
+}
+
+} // namespace neurosim
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <Eigen/Dense>
+
+namespace neurosim {
+
+/**
+ * @brief Fixed-capacity ring buffer of prenormalized memory embeddings
+ *
+ * Memories are unit-norm rows of one row-major matrix with a parallel value
+ * column (emotional valence, fear strength, ...). When full, the oldest
+ * memory is overwritten in place, so insertion is O(dim) with no shifting.
+ * - Every memory gets a stable integer id (monotonic, never reused)
+ * - Lookup against all memories is one GEMV plus a partial sort (top-k)
+ * - Original norms are kept so patterns can be exported unnormalized
+ * - Patterns of a different length are zero-padded/truncated to the matrix
+ *   dimension (set by the first memory)
+ */
+class EmotionalMemoryMatrix {
+public:
+    using RowMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    /**
+     * @brief Lookup hit
+     */
+    struct Hit {
+        uint64_t id = 0;          ///< Stable memory id
+        double similarity = 0.0;  ///< Cosine similarity to the query
+        double value = 0.0;       ///< Stored value (e.g. valence)
+    };
+
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Maximum number of memories kept
+     */
+    explicit EmotionalMemoryMatrix(size_t capacity = 1000);
+
+    /**
+     * @brief Store a memory, overwriting the oldest one when full
+     * @param pattern Memory embedding (normalized on insertion)
+     * @param value Value column entry
+     * @return Id of the new memory
+     */
+    uint64_t push(const Eigen::Ref<const Eigen::VectorXd>& pattern, double value);
+
+    /**
+     * @brief Update the value of a live memory
+     * @return False if the id has been overwritten or never existed
+     */
+    bool setValue(uint64_t id, double value);
+
+    /**
+     * @brief Drop all memories (ids are not reused)
+     */
+    void clear();
+
+    /**
+     * @brief Find the k most similar memories
+     * @param input Query embedding
+     * @param k Maximum number of hits
+     * @param min_similarity Hits must exceed this cosine similarity
+     * @param hits Output, most similar first (reused to avoid allocation)
+     */
+    void topK(const Eigen::Ref<const Eigen::VectorXd>& input, size_t k, double min_similarity,
+              std::vector<Hit>& hits) const;
+
+    /**
+     * @brief Check whether an id is still stored
+     */
+    bool contains(uint64_t id) const;
+
+    /**
+     * @brief Export a memory
+     * @param id Memory id
+     * @param pattern Original (unnormalized) embedding
+     * @param value Stored value
+     * @return False if the id is no longer stored
+     */
+    bool get(uint64_t id, Eigen::VectorXd& pattern, double& value) const;
+
+    /**
+     * @brief Visit memories from oldest to newest
+     * @param fn Callable (uint64_t id, const Eigen::VectorXd& pattern, double value)
+     */
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        Eigen::VectorXd pattern;
+        uint64_t first_id = next_id_ - count_;
+        for (size_t i = 0; i < count_; ++i) {
+            uint64_t id = first_id + i;
+            size_t slot = slotOf(id);
+            pattern = embeddings_.row(static_cast<Eigen::Index>(slot)).transpose() *
+                      norms_(static_cast<Eigen::Index>(slot));
+            fn(id, pattern, values_(static_cast<Eigen::Index>(slot)));
+        }
+    }
+
+    size_t size() const { return count_; }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return count_ == 0; }
+    Eigen::Index dimension() const { return embeddings_.cols(); }
+
+private:
+    size_t capacity_;
+    RowMatrix embeddings_;       // capacity x dim, unit-norm rows
+    Eigen::VectorXd values_;     // Value column
+    Eigen::VectorXd norms_;      // Original norms for export
+    size_t count_;
+    size_t head_;                // Next slot to write
+    uint64_t next_id_;
+
+    // Scratch buffers reused across lookups
+    mutable Eigen::VectorXd query_;
+    mutable Eigen::VectorXd scores_;
+    mutable std::vector<std::pair<double, size_t>> candidates_;
+
+    size_t slotOf(uint64_t id) const;
+};
+
+} // namespace neurosim
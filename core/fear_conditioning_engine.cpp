@@ -0,0 +1,152 @@
+#include "fear_conditioning_engine.hpp"
+#include <algorithm>
+
+namespace neurosim {
+
+FearConditioningEngine::FearConditioningEngine() : FearConditioningEngine(LearningParams{}) {
+}
+
+FearConditioningEngine::FearConditioningEngine(const LearningParams& params, size_t subjects,
+                                               Eigen::Index dimension)
+    : params_(params) {
+    reset(subjects, dimension);
+}
+
+void FearConditioningEngine::reset(size_t subjects, Eigen::Index dimension) {
+    Eigen::Index rows = static_cast<Eigen::Index>(subjects);
+    weights_.setZero(rows, std::max<Eigen::Index>(0, dimension));
+    rate_scale_.setOnes(rows);
+    errors_.setZero(rows);
+    scaled_errors_.setZero(rows);
+}
+
+void FearConditioningEngine::setSubjectRateScale(const Eigen::Ref<const Eigen::VectorXd>& scale) {
+    Eigen::Index overlap = std::min(rate_scale_.size(), scale.size());
+    rate_scale_.head(overlap) = scale.head(overlap);
+}
+
+const Eigen::VectorXd& FearConditioningEngine::trial(const Eigen::Ref<const Eigen::VectorXd>& stimulus,
+                                                     double us_intensity) {
+    double rate = us_intensity > 0.0 ? params_.acquisition_rate : params_.extinction_rate;
+    applyTrial(stimulus, us_intensity, rate);
+    return errors_;
+}
+
+const Eigen::VectorXd& FearConditioningEngine::trial(const Eigen::Ref<const Eigen::VectorXd>& stimulus,
+                                                     double us_intensity, double rate) {
+    applyTrial(stimulus, us_intensity, rate);
+    return errors_;
+}
+
+const Eigen::VectorXd& FearConditioningEngine::trial(const RowMatrix& stimuli,
+                                                     const Eigen::Ref<const Eigen::VectorXd>& us_intensity) {
+    Eigen::Index rows = weights_.rows();
+    if (rows == 0 || stimuli.rows() != rows || us_intensity.size() != rows ||
+        !ensureDimension(stimuli.cols())) {
+        errors_.setZero(rows);
+        return errors_;
+    }
+
+    // Columns past the feature dimension are dropped; missing ones count as zero
+    Eigen::Index overlap = std::min(weights_.cols(), stimuli.cols());
+    auto x = stimuli.leftCols(overlap);
+    auto w = weights_.leftCols(overlap);
+
+    // delta_i = lambda_i - W_i . x_i
+    errors_ = us_intensity * params_.us_asymptote;
+    errors_ -= w.cwiseProduct(x).rowwise().sum();
+
+    // W_i += rate_i * delta_i * x_i, with the rate chosen per subject's trial type
+    scaled_errors_.resize(rows);
+    for (Eigen::Index i = 0; i < rows; ++i) {
+        double rate = us_intensity(i) > 0.0 ? params_.acquisition_rate : params_.extinction_rate;
+        scaled_errors_(i) = rate * rate_scale_(i) * errors_(i);
+    }
+    w += scaled_errors_.asDiagonal() * x;
+    return errors_;
+}
+
+void FearConditioningEngine::runSession(const RowMatrix& stimuli,
+                                        const Eigen::Ref<const Eigen::VectorXd>& us_intensity,
+                                        Eigen::MatrixXd* predictions) {
+    Eigen::Index trials = std::min(stimuli.rows(), us_intensity.size());
+    if (predictions) {
+        predictions->resize(weights_.rows(), trials);
+    }
+
+    for (Eigen::Index t = 0; t < trials; ++t) {
+        double us = us_intensity(t);
+        trial(stimuli.row(t).transpose(), us);
+
+        if (predictions) {
+            // V before the update = lambda - delta
+            predictions->col(t) = (us * params_.us_asymptote) - errors_.array();
+        }
+    }
+}
+
+void FearConditioningEngine::predict(const Eigen::Ref<const Eigen::VectorXd>& stimulus,
+                                     Eigen::VectorXd& predictions) const {
+    predictions.setZero(weights_.rows());
+    Eigen::Index dim = weights_.cols();
+    if (dim == 0 || stimulus.size() == 0) {
+        return;
+    }
+
+    if (stimulus.size() == dim) {
+        predictions.noalias() = weights_ * stimulus;
+        return;
+    }
+
+    Eigen::Index overlap = std::min(dim, stimulus.size());
+    padded_.setZero(dim);
+    padded_.head(overlap) = stimulus.head(overlap);
+    predictions.noalias() = weights_ * padded_;
+}
+
+double FearConditioningEngine::predict(const Eigen::Ref<const Eigen::VectorXd>& stimulus,
+                                       size_t subject) const {
+    Eigen::Index row = static_cast<Eigen::Index>(subject);
+    Eigen::Index dim = weights_.cols();
+    if (row >= weights_.rows() || dim == 0) {
+        return 0.0;
+    }
+
+    Eigen::Index overlap = std::min(dim, stimulus.size());
+    return weights_.row(row).head(overlap).dot(stimulus.head(overlap).transpose());
+}
+
+void FearConditioningEngine::applyTrial(const Eigen::Ref<const Eigen::VectorXd>& stimulus,
+                                        double us_intensity, double rate) {
+    if (weights_.rows() == 0 || !ensureDimension(stimulus.size())) {
+        errors_.setZero(weights_.rows());
+        return;
+    }
+
+    Eigen::Index dim = weights_.cols();
+    Eigen::Index overlap = std::min(dim, stimulus.size());
+    stimulus_.resize(dim);
+    stimulus_.head(overlap) = stimulus.head(overlap);
+    stimulus_.tail(dim - overlap).setZero();
+
+    // delta = lambda - W x for every subject at once
+    double lambda = us_intensity * params_.us_asymptote;
+    errors_.noalias() = weights_ * stimulus_;
+    errors_ = lambda - errors_.array();
+
+    // W += (rate .* delta) x^T
+    scaled_errors_ = rate * rate_scale_.cwiseProduct(errors_);
+    weights_.noalias() += scaled_errors_ * stimulus_.transpose();
+}
+
+bool FearConditioningEngine::ensureDimension(Eigen::Index size) {
+    if (weights_.cols() == 0) {
+        if (size == 0) {
+            return false;
+        }
+        weights_.setZero(weights_.rows(), size);
+    }
+    return true;
+}
+
+} // namespace neurosim
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <Eigen/Dense>
+
+namespace neurosim {
+
+/**
+ * @brief Batched Rescorla-Wagner fear conditioning/extinction
+ *
+ * CS-US associations are a weight matrix over stimulus features with one
+ * row per subject (or session), so a whole cohort learns at once:
+ * - Prediction for every subject is one GEMV: V = W x
+ * - Prediction error is a vector: delta = lambda - V
+ * - Update is one rank-1 step: W += (rate .* delta) x^T
+ *
+ * The shared-stimulus trial and runSession give every subject the same
+ * protocol. Cohorts on different protocols use the per-subject trial,
+ * which takes one stimulus row and US intensity per subject (row-wise
+ * dot products and updates instead of a GEMV).
+ *
+ * Reinforced trials (US present) use the acquisition rate and
+ * non-reinforced trials the extinction rate; per-subject rate scales allow
+ * heterogeneous cohorts. Stimuli of a different length are zero-padded/
+ * truncated to the feature dimension (set by the first stimulus if not
+ * given up front).
+ */
+class FearConditioningEngine {
+public:
+    using RowMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    /**
+     * @brief Learning parameters
+     */
+    struct LearningParams {
+        double acquisition_rate = 0.3;  ///< alpha*beta on reinforced trials
+        double extinction_rate = 0.1;   ///< alpha*beta on non-reinforced trials
+        double us_asymptote = 1.0;      ///< lambda for a unit-intensity US
+    };
+
+public:
+    FearConditioningEngine();
+    explicit FearConditioningEngine(const LearningParams& params, size_t subjects = 1,
+                                    Eigen::Index dimension = 0);
+
+    /**
+     * @brief Reset all associations to zero and set the batch shape
+     * @param subjects Rows of the weight matrix (subjects or sessions)
+     * @param dimension Stimulus feature dimension (0 = set by first stimulus)
+     */
+    void reset(size_t subjects, Eigen::Index dimension = 0);
+
+    /**
+     * @brief Per-subject multiplier on both learning rates (default 1)
+     */
+    void setSubjectRateScale(const Eigen::Ref<const Eigen::VectorXd>& scale);
+
+    /**
+     * @brief Run one trial for every subject
+     * @param stimulus CS feature vector
+     * @param us_intensity US intensity (0 = non-reinforced/extinction trial)
+     * @return Prediction errors, one per subject (valid until the next call)
+     */
+    const Eigen::VectorXd& trial(const Eigen::Ref<const Eigen::VectorXd>& stimulus,
+                                 double us_intensity);
+
+    /**
+     * @brief Run one trial with an explicit learning rate
+     */
+    const Eigen::VectorXd& trial(const Eigen::Ref<const Eigen::VectorXd>& stimulus,
+                                 double us_intensity, double rate);
+
+    /**
+     * @brief Run one trial with a separate stimulus for every subject
+     * @param stimuli Row i = CS presented to subject i (rows must equal subjects())
+     * @param us_intensity US intensity per subject (0 = non-reinforced)
+     * @return Prediction errors, one per subject (valid until the next call)
+     */
+    const Eigen::VectorXd& trial(const RowMatrix& stimuli,
+                                 const Eigen::Ref<const Eigen::VectorXd>& us_intensity);
+
+    /**
+     * @brief Run a session of trials for every subject (shared protocol)
+     * @param stimuli Trial stimuli, row t = CS of trial t
+     * @param us_intensity US intensity per trial
+     * @param predictions Optional subjects x trials log of V before each trial
+     */
+    void runSession(const RowMatrix& stimuli, const Eigen::Ref<const Eigen::VectorXd>& us_intensity,
+                    Eigen::MatrixXd* predictions = nullptr);
+
+    /**
+     * @brief Predicted fear for every subject
+     * @param stimulus CS feature vector
+     * @param predictions Output, one per subject
+     */
+    void predict(const Eigen::Ref<const Eigen::VectorXd>& stimulus, Eigen::VectorXd& predictions) const;
+
+    /**
+     * @brief Predicted fear for one subject
+     */
+    double predict(const Eigen::Ref<const Eigen::VectorXd>& stimulus, size_t subject = 0) const;
+
+    const RowMatrix& weights() const { return weights_; }
+    const LearningParams& params() const { return params_; }
+    void setParams(const LearningParams& params) { params_ = params; }
+    size_t subjects() const { return static_cast<size_t>(weights_.rows()); }
+    Eigen::Index dimension() const { return weights_.cols(); }
+
+private:
+    LearningParams params_;
+    RowMatrix weights_;         // subjects x features
+    Eigen::VectorXd rate_scale_;
+
+    // Scratch buffers reused across trials
+    Eigen::VectorXd stimulus_;
+    Eigen::VectorXd errors_;
+    Eigen::VectorXd scaled_errors_;
+    mutable Eigen::VectorXd padded_;
+
+    void applyTrial(const Eigen::Ref<const Eigen::VectorXd>& stimulus, double us_intensity, double rate);
+    bool ensureDimension(Eigen::Index size);
+};
+
+} // namespace neurosim
@@ -1,21 +1,355 @@
 #include "flashback_overlay.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
-// Stub implementation for flashback overlay
+// Flashback overlay implementation
 // Owner: Darrell Mesa (darrell.mesa@pm-ss.org)
 
 namespace neurosim {
 
-FlashbackOverlay::FlashbackOverlay() {
-    // Stub constructor
+FlashbackOverlay::FlashbackOverlay() : FlashbackOverlay(FlashbackConfig{}) {
 }
 
-bool FlashbackOverlay::checkTrigger(const Eigen::VectorXd&) {
-    // Stub implementation
-    return false;
+FlashbackOverlay::FlashbackOverlay(const FlashbackConfig& config)
+    : config_(config),
+      trigger_window_(config.trigger_window_steps, config.trigger_window_decay),
+      template_index_dirty_(true), window_above_threshold_(false),
+      current_time_(0.0), flashback_start_time_(0.0), last_hypervigilance_scan_(0.0),
+      active_duration_ms_(0.0) {
 }
 
-void FlashbackOverlay::addTraumaTemplate(const Eigen::VectorXd&, double) {
-    // Stub implementation
+bool FlashbackOverlay::checkTrigger(const Eigen::VectorXd& input_pattern) {
+    if (template_matrix_.empty()) {
+        return false;
+    }
+
+    // Generalization only matters once it would pass both the threshold and
+    // the current hypervigilance, so clusters below that are never scored
+    double generalization_floor = std::numeric_limits<double>::infinity();
+    if (config_.trauma_generalization > 0.0) {
+        generalization_floor = std::max(config_.generalization_threshold,
+                                        current_state_.hypervigilance_level) /
+                               config_.trauma_generalization;
+    }
+
+    auto match = templateIndex().query(input_pattern, generalization_floor, config_.trigger_early_exit);
+    if (match.triggered_template < 0) {
+        // Sub-threshold near-matches of a trauma family still raise hypervigilance
+        double generalization = config_.trauma_generalization * match.generalization;
+        if (generalization >= config_.generalization_threshold &&
+            generalization > current_state_.hypervigilance_level) {
+            current_state_.hypervigilance_level = generalization;
+            if (current_state_.phase == FlashbackPhase::Idle) {
+                current_state_.phase = FlashbackPhase::Decaying;
+            }
+        }
+        return false;
+    }
+
+    TraumaTemplate& triggered = trauma_templates_[static_cast<size_t>(match.triggered_template)];
+    updateTraumaTemplateStats(triggered);
+    initiateFlashback(triggered);
+    current_state_.intensity = std::min(1.0, match.score * triggered.emotional_intensity);
+
+    return true;
+}
+
+FlashbackOverlay::FlashbackState FlashbackOverlay::processFlashback(double dt) {
+    if (current_state_.phase == FlashbackPhase::Idle) {
+        // Nothing evolves at baseline; just move the clock
+        current_time_ += dt;
+        return current_state_;
+    }
+
+    advancePhase(std::max(0.0, dt));
+    return current_state_;
+}
+
+bool FlashbackOverlay::checkWindowedTrigger(const Eigen::VectorXd& input_pattern) {
+    if (template_matrix_.empty()) {
+        return false;
+    }
+
+    template_matrix_.computeScores(input_pattern, step_scores_);
+    const Eigen::VectorXd& window_scores = trigger_window_.push(step_scores_);
+
+    // Pick the template exceeding its threshold by the widest margin
+    Eigen::Index best = 0;
+    bool above = (window_scores - template_matrix_.thresholds()).maxCoeff(&best) >= 0.0;
+
+    // A window staying above threshold triggers once, on the rising edge,
+    // and not on top of a trigger already pending this step
+    bool rising = above && !window_above_threshold_;
+    window_above_threshold_ = above;
+    if (!rising || current_state_.phase == FlashbackPhase::Triggered) {
+        return false;
+    }
+
+    TraumaTemplate& triggered = trauma_templates_[static_cast<size_t>(best)];
+    updateTraumaTemplateStats(triggered);
+    initiateFlashback(triggered);
+    current_state_.intensity = std::min(1.0, window_scores(best) * triggered.emotional_intensity);
+
+    return true;
+}
+
+void FlashbackOverlay::addTraumaTemplate(const Eigen::VectorXd& trauma_pattern,
+                                        double trigger_threshold,
+                                        const std::string& trauma_type) {
+    addTraumaTemplate(TraumaTemplateLibrary::instance().intern(trauma_pattern),
+                      trigger_threshold, trauma_type);
+}
+
+void FlashbackOverlay::addTraumaTemplate(const TraumaTemplateHandle& trauma_pattern,
+                                        double trigger_threshold,
+                                        const std::string& trauma_type) {
+    TraumaTemplate trauma_template;
+    trauma_template.pattern = trauma_pattern;
+    trauma_template.trigger_threshold = trigger_threshold;
+    trauma_template.trauma_type = trauma_type;
+    trauma_template.is_primary_trauma = trauma_templates_.empty();
+
+    trauma_templates_.push_back(std::move(trauma_template));
+    template_matrix_.add(trauma_pattern, trigger_threshold);
+    trigger_window_.reset(static_cast<Eigen::Index>(trauma_templates_.size()));
+    window_above_threshold_ = false;
+    template_index_dirty_ = true;
+}
+
+void FlashbackOverlay::addCombatTrauma(const Eigen::VectorXd& combat_scenario,
+                                      double intensity,
+                                      const std::string& location) {
+    // Combat hypervigilance lowers the similarity needed to trigger
+    double threshold = 0.8;
+    if (config_.combat_ptsd_mode) {
+        threshold /= std::max(1.0, config_.combat_hypervigilance);
+    }
+
+    addTraumaTemplate(combat_scenario, threshold, "combat");
+
+    TraumaTemplate& combat_template = trauma_templates_.back();
+    combat_template.emotional_intensity = intensity;
+    combat_template.contextual_cues.push_back(location);
+}
+
+void FlashbackOverlay::updateConfig(const FlashbackConfig& config) {
+    bool window_changed = config.trigger_window_steps != config_.trigger_window_steps ||
+                          config.trigger_window_decay != config_.trigger_window_decay;
+    config_ = config;
+
+    if (window_changed) {
+        trigger_window_.configure(config_.trigger_window_steps, config_.trigger_window_decay);
+        window_above_threshold_ = false;
+    }
+}
+
+void FlashbackOverlay::clearTraumaTemplates() {
+    trauma_templates_.clear();
+    template_matrix_.clear();
+    trigger_window_.reset(0);
+    window_above_threshold_ = false;
+    template_index_.clear();
+    template_index_dirty_ = true;
+}
+
+std::vector<FlashbackOverlay::FlashbackState> FlashbackOverlay::getFlashbackHistory() const {
+    return flashback_history_;
+}
+
+void FlashbackOverlay::applyGroundingTechnique(double grounding_strength) {
+    double strength = std::max(0.0, std::min(1.0, grounding_strength));
+
+    current_state_.intensity *= (1.0 - strength);
+    current_state_.hypervigilance_level *= (1.0 - 0.5 * strength);
+    current_state_.dissociation_active = false;
+
+    // Grounding ends re-experiencing; what remains relaxes toward baseline
+    if (current_state_.phase == FlashbackPhase::Triggered ||
+        current_state_.phase == FlashbackPhase::Active) {
+        current_state_.phase = FlashbackPhase::Decaying;
+        current_state_.flashback_active = false;
+        current_state_.memory_flooding = false;
+    }
+}
+
+const TraumaClusterIndex& FlashbackOverlay::templateIndex() {
+    // Build the centroid tree once per template set, then search it per query
+    if (template_index_dirty_) {
+        template_index_.build(template_matrix_.sharedPatterns(), template_matrix_.thresholds());
+        template_index_dirty_ = false;
+    }
+    return template_index_;
+}
+
+void FlashbackOverlay::initiateFlashback(const TraumaTemplate& triggered_template) {
+    if (current_state_.flashback_active) {
+        flashback_history_.push_back(current_state_);
+        pruneOldHistory();
+    }
+
+    flashback_start_time_ = current_time_;
+    current_state_.phase = FlashbackPhase::Triggered;
+    current_state_.flashback_active = true;
+    current_state_.duration_ms = 0.0;
+    current_state_.trigger_type = triggered_template.trauma_type;
+    current_state_.sensory_intrusions = triggered_template.sensory_markers;
+    current_state_.fight_flight_active = true;
+}
+
+void FlashbackOverlay::updateTraumaTemplateStats(TraumaTemplate& trauma_template) {
+    trauma_template.activation_frequency += 1.0;
+    trauma_template.last_activation = current_time_;
+}
+
+void FlashbackOverlay::advancePhase(double dt) {
+    double remaining = dt;
+
+    // Walk phase boundaries inside dt; each segment is integrated in closed form
+    while (remaining > 0.0 || current_state_.phase == FlashbackPhase::Triggered) {
+        switch (current_state_.phase) {
+            case FlashbackPhase::Idle:
+                current_time_ += remaining;
+                remaining = 0.0;
+                break;
+
+            case FlashbackPhase::Triggered: {
+                double intensity = current_state_.intensity;
+                double gain = config_.combat_ptsd_mode ? config_.combat_hypervigilance : 1.0;
+
+                current_state_.phase = FlashbackPhase::Active;
+                current_state_.duration_ms = 0.0;
+                current_state_.hypervigilance_level = std::max(current_state_.hypervigilance_level,
+                                                               std::min(1.0, intensity * gain));
+                current_state_.memory_flooding = config_.enable_memory_flooding &&
+                                                 intensity > config_.memory_flooding_threshold;
+                processDissociation(intensity);
+
+                flashback_start_time_ = current_time_;
+                active_duration_ms_ = config_.flashback_duration_base * std::max(0.1, intensity);
+                break;
+            }
+
+            case FlashbackPhase::Active: {
+                double step = std::min(remaining, active_duration_ms_ - current_state_.duration_ms);
+                updatePhysiologicalResponse(current_state_.intensity, step);
+                current_state_.duration_ms += step;
+                current_time_ += step;
+                remaining -= step;
+
+                if (current_state_.duration_ms >= active_duration_ms_) {
+                    current_state_.phase = FlashbackPhase::Decaying;
+                    current_state_.flashback_active = false;
+                    current_state_.dissociation_active = false;
+                    current_state_.memory_flooding = false;
+
+                    flashback_history_.push_back(current_state_);
+                    pruneOldHistory();
+                }
+                break;
+            }
+
+            case FlashbackPhase::Decaying:
+                updatePhysiologicalResponse(current_state_.intensity, remaining);
+                updateFlashbackIntensity(remaining);
+                updateHypervigilance(remaining);
+                current_time_ += remaining;
+                remaining = 0.0;
+
+                if (reachedBaseline()) {
+                    returnToBaseline();
+                }
+                break;
+        }
+    }
+
+    current_state_.fight_flight_active = current_state_.phase == FlashbackPhase::Active ||
+                                         current_state_.simulated_heart_rate > 100.0;
+}
+
+void FlashbackOverlay::updateFlashbackIntensity(double dt) {
+    // Exponential decay, rate given per second
+    current_state_.intensity *= std::exp(-config_.flashback_intensity_decay * dt / 1000.0);
+}
+
+void FlashbackOverlay::updateHypervigilance(double dt) {
+    current_state_.hypervigilance_level *= std::exp(-config_.hypervigilance_decay * dt / 1000.0);
+}
+
+void FlashbackOverlay::updatePhysiologicalResponse(double intensity, double dt) {
+    // Targets follow intensity, which is constant while Active and decays exponentially after
+    double intensity_rate = current_state_.phase == FlashbackPhase::Decaying
+        ? config_.flashback_intensity_decay / 1000.0 : 0.0;
+
+    double heart_rate_excess = current_state_.simulated_heart_rate - BASELINE_HEART_RATE;
+    heart_rate_excess = relaxTowardDecayingTarget(
+        heart_rate_excess, calculateHeartRateResponse(intensity) - BASELINE_HEART_RATE,
+        intensity_rate, HEART_RATE_TAU_MS, dt);
+    current_state_.simulated_heart_rate = BASELINE_HEART_RATE + heart_rate_excess;
+
+    current_state_.stress_hormone_level = relaxTowardDecayingTarget(
+        current_state_.stress_hormone_level, calculateStressHormoneLevel(intensity),
+        intensity_rate, STRESS_HORMONE_TAU_MS, dt);
+}
+
+double FlashbackOverlay::calculateHeartRateResponse(double intensity) const {
+    return BASELINE_HEART_RATE + 80.0 * intensity;
+}
+
+double FlashbackOverlay::calculateStressHormoneLevel(double intensity) const {
+    return intensity;
+}
+
+double FlashbackOverlay::relaxTowardDecayingTarget(double value, double target_amplitude,
+                                                   double target_decay_rate, double tau, double dt) {
+    // Exact solution of dy/dt = (A * exp(-k t) - y) / tau over dt
+    double a = 1.0 / tau;
+    double relax = std::exp(-a * dt);
+
+    if (std::abs(a - target_decay_rate) < 1e-12) {
+        return value * relax + target_amplitude * a * dt * relax;
+    }
+
+    double target = std::exp(-target_decay_rate * dt);
+    return value * relax + target_amplitude * a * (target - relax) / (a - target_decay_rate);
+}
+
+bool FlashbackOverlay::reachedBaseline() const {
+    return current_state_.intensity < BASELINE_EPSILON &&
+           current_state_.hypervigilance_level < BASELINE_EPSILON &&
+           current_state_.stress_hormone_level < BASELINE_EPSILON &&
+           std::abs(current_state_.simulated_heart_rate - BASELINE_HEART_RATE) <
+               BASELINE_EPSILON * BASELINE_HEART_RATE;
+}
+
+void FlashbackOverlay::returnToBaseline() {
+    current_state_.phase = FlashbackPhase::Idle;
+    current_state_.flashback_active = false;
+    current_state_.intensity = 0.0;
+    current_state_.duration_ms = 0.0;
+    current_state_.hypervigilance_level = 0.0;
+    current_state_.simulated_heart_rate = BASELINE_HEART_RATE;
+    current_state_.stress_hormone_level = 0.0;
+    current_state_.fight_flight_active = false;
+    current_state_.dissociation_active = false;
+    current_state_.memory_flooding = false;
+    current_state_.active_memories.clear();
+    current_state_.sensory_intrusions.clear();
+}
+
+void FlashbackOverlay::processDissociation(double trigger_intensity) {
+    current_state_.dissociation_active = shouldTriggerDissociation(trigger_intensity);
+}
+
+bool FlashbackOverlay::shouldTriggerDissociation(double intensity) const {
+    return config_.enable_dissociation && intensity > config_.dissociation_threshold;
+}
+
+void FlashbackOverlay::pruneOldHistory() {
+    if (flashback_history_.size() > MAX_HISTORY_SIZE) {
+        flashback_history_.erase(flashback_history_.begin(),
+                                 flashback_history_.end() - MAX_HISTORY_SIZE);
+    }
 }
 
 } // namespace neurosim
@@ -4,6 +4,9 @@
 #include <string>
 #include <memory>
 #include <Eigen/Dense>
+#include "trauma_template_matrix.hpp"
+#include "streaming_trigger_detector.hpp"
+#include "trauma_cluster_index.hpp"
 
 namespace neurosim {
 
@@ -24,7 +27,7 @@ public:
      * @brief Trauma template for pattern matching
      */
     struct TraumaTemplate {
-        Eigen::VectorXd pattern_embedding;      ///< Trauma-associated pattern
+        TraumaTemplateHandle pattern;           ///< Shared trauma-associated pattern (unit norm)
         double trigger_threshold = 0.8;         ///< Sensitivity for activation
         double emotional_intensity = 1.0;       ///< Emotional charge of trauma
         std::vector<std::string> sensory_markers; ///< Associated sensory cues
@@ -40,10 +43,24 @@ public:
         double avoidance_strength = 0.0;        ///< Tendency to avoid related stimuli
     };
 
+    /**
+     * @brief Flashback episode phase
+     * 
+     * Idle -> Triggered (on trigger) -> Active (for the episode duration)
+     * -> Decaying (closed-form relaxation) -> Idle (once back at baseline).
+     */
+    enum class FlashbackPhase {
+        Idle,        ///< At baseline; processing costs nothing
+        Triggered,   ///< Trigger detected, episode starts on the next step
+        Active,      ///< Re-experiencing; intensity held, physiology driven
+        Decaying     ///< Intensity, hypervigilance and physiology relaxing
+    };
+
     /**
      * @brief Flashback state information
      */
     struct FlashbackState {
+        FlashbackPhase phase = FlashbackPhase::Idle; ///< Current episode phase
         bool flashback_active = false;          ///< Whether flashback is occurring
         double intensity = 0.0;                 ///< Flashback intensity (0-1)
         double duration_ms = 0.0;               ///< How long flashback has been active
@@ -78,6 +95,10 @@ public:
         bool enable_dissociation = true;        ///< Whether to simulate dissociation
         bool enable_memory_flooding = true;     ///< Whether to simulate memory flooding
         double trauma_generalization = 0.3;     ///< How broadly trauma generalizes
+        double generalization_threshold = 0.1;  ///< Minimum generalization that raises hypervigilance
+        bool trigger_early_exit = false;        ///< Stop matching at the first triggered template cluster
+        size_t trigger_window_steps = 10;       ///< Inputs accumulated by windowed trigger detection
+        double trigger_window_decay = 0.9;      ///< Per-step weight decay inside the trigger window
         
         // Combat PTSD specific (for your background)
         bool combat_ptsd_mode = false;          ///< Enable combat-specific patterns
@@ -86,22 +107,54 @@ public:
     };
 
 public:
+    FlashbackOverlay();
+
     /**
      * @brief Constructor
      * @param config Flashback system configuration
      */
-    explicit FlashbackOverlay(const FlashbackConfig& config = FlashbackConfig{});
+    explicit FlashbackOverlay(const FlashbackConfig& config);
 
     /**
      * @brief Check if current input triggers a flashback
+     *
+     * Searches the template cluster tree, scoring only clusters that could
+     * trigger or raise hypervigilance. Without a trigger, generalization of
+     * at least generalization_threshold raises hypervigilance.
+     *
      * @param input_pattern Current sensory/cognitive input
      * @return Whether flashback was triggered
      */
     bool checkTrigger(const Eigen::VectorXd& input_pattern);
 
+    /**
+     * @brief Check for a trigger that builds up over recent inputs
+     * 
+     * Accumulates per-template similarity over a decayed sliding window of
+     * the last trigger_window_steps inputs. Cost per call is one template
+     * GEMV plus O(templates), independent of the window length. A trigger
+     * fires when the window first rises above a template threshold; it
+     * re-arms once every window score has dropped below its threshold.
+     * 
+     * @param input_pattern Newest sensory/cognitive input
+     * @return Whether a windowed trigger score rose above its template threshold
+     */
+    bool checkWindowedTrigger(const Eigen::VectorXd& input_pattern);
+
+    /**
+     * @brief Get per-template windowed trigger scores from the last windowed check
+     * @return Normalized window scores (one per trauma template)
+     */
+    const Eigen::VectorXd& getWindowedTriggerScores() const { return trigger_window_.getWindowScores(); }
+
     /**
      * @brief Process ongoing flashback state
-     * @param dt Time step in milliseconds
+     * 
+     * Advances the phase state machine over dt in closed form, so one call
+     * with a large dt is equivalent to many small steps. In the Idle phase
+     * only the clock advances.
+     * 
+     * @param dt Time step in milliseconds (any length)
      * @return Current flashback state
      */
     FlashbackState processFlashback(double dt = 1.0);
@@ -116,6 +169,16 @@ public:
                           double trigger_threshold = 0.8,
                           const std::string& trauma_type = "general");
 
+    /**
+     * @brief Add a shared library trauma template for trigger detection
+     * @param trauma_pattern Library handle (not copied)
+     * @param trigger_threshold Sensitivity threshold
+     * @param trauma_type Type of trauma
+     */
+    void addTraumaTemplate(const TraumaTemplateHandle& trauma_pattern,
+                          double trigger_threshold = 0.8,
+                          const std::string& trauma_type = "general");
+
     /**
      * @brief Add combat-specific trauma template
      * @param combat_scenario Combat scenario embedding
@@ -140,6 +203,12 @@ public:
      */
     const FlashbackState& getCurrentState() const { return current_state_; }
 
+    /**
+     * @brief Get current episode phase
+     * @return Current phase
+     */
+    FlashbackPhase getPhase() const { return current_state_.phase; }
+
     /**
      * @brief Update configuration
      * @param config New configuration
@@ -185,19 +254,27 @@ public:
 private:
     FlashbackConfig config_;
     std::vector<TraumaTemplate> trauma_templates_;
+    TraumaTemplateMatrix template_matrix_;   // Prenormalized patterns, row i = trauma_templates_[i]
+    StreamingTriggerDetector trigger_window_; // Sliding-window per-template trigger sums
+    Eigen::VectorXd step_scores_;            // Scratch buffer for per-step template scores
+    TraumaClusterIndex template_index_;      // Centroid tree over template_matrix_, rebuilt lazily
+    bool template_index_dirty_;
+    bool window_above_threshold_;            // A window score was above threshold at the last windowed check
     FlashbackState current_state_;
     std::vector<FlashbackState> flashback_history_;
     
     double current_time_;
     double flashback_start_time_;
     double last_hypervigilance_scan_;
+    double active_duration_ms_;             // Length of the current Active phase
     
     // Core processing methods
-    double calculateTriggerMatch(const Eigen::VectorXd& input, 
-                               const TraumaTemplate& template) const;
     void initiateFlashback(const TraumaTemplate& triggered_template);
     void updateFlashbackIntensity(double dt);
     void updateHypervigilance(double dt);
+    void advancePhase(double dt);
+    bool reachedBaseline() const;
+    void returnToBaseline();
     
     // Combat PTSD specific methods
     void applyCombatPTSDModifications();
@@ -209,23 +286,32 @@ private:
     bool shouldTriggerDissociation(double intensity) const;
     
     // Memory flooding simulation
-    void processMemoryFlooding(const TraumaTemplate& template);
-    std::vector<std::string> generateFloodingMemories(const TraumaTemplate& template) const;
+    void processMemoryFlooding(const TraumaTemplate& trauma_template);
+    std::vector<std::string> generateFloodingMemories(const TraumaTemplate& trauma_template) const;
     
     // Physiological response simulation
     void updatePhysiologicalResponse(double intensity, double dt);
     double calculateHeartRateResponse(double intensity) const;
     double calculateStressHormoneLevel(double intensity) const;
+    static double relaxTowardDecayingTarget(double value, double target_amplitude,
+                                            double target_decay_rate, double tau, double dt);
     
     // Utility methods
-    void updateTraumaTemplateStats(TraumaTemplate& template);
+    void updateTraumaTemplateStats(TraumaTemplate& trauma_template);
     void pruneOldHistory();
-    double calculateGeneralizationEffect(const Eigen::VectorXd& input) const;
+    const TraumaClusterIndex& templateIndex();
     std::vector<std::string> extractSensoryMarkers(const Eigen::VectorXd& input) const;
     
     // Combat-specific trigger patterns (based on Operation Phantom Fury context)
     static const std::vector<std::string> combat_trigger_words_;
     static const std::vector<std::string> fallujah_contextual_cues_;
+
+    // Baseline physiology and relaxation time constants
+    static constexpr double BASELINE_HEART_RATE = 70.0;   // bpm
+    static constexpr double HEART_RATE_TAU_MS = 10000.0;  // ms
+    static constexpr double STRESS_HORMONE_TAU_MS = 60000.0; // ms
+    static constexpr double BASELINE_EPSILON = 0.01;
+    static constexpr size_t MAX_HISTORY_SIZE = 1000;
 };
 
 } // namespace neurosim
@@ -0,0 +1,203 @@
+#include "memory_index.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace neurosim {
+
+MemoryIndex::MemoryIndex(double time_bucket_ms)
+    : time_bucket_ms_(time_bucket_ms > 0.0 ? time_bucket_ms : 1000.0) {
+}
+
+void MemoryIndex::insert(size_t slot, bool traumatic, bool fragmented,
+                         double timestamp, double intrusion_probability) {
+    ensureCapacity(slot);
+    if (slot_intrusion_bucket_[slot] != NO_BUCKET) {
+        erase(slot);
+    }
+
+    setBit(live_, slot);
+    live_count_++;
+
+    if (traumatic) setBit(traumatic_, slot);
+    if (fragmented) setBit(fragmented_, slot);
+
+    size_t intrusion_bucket = intrusionBucket(intrusion_probability);
+    setBit(intrusion_[intrusion_bucket], slot);
+    slot_intrusion_bucket_[slot] = static_cast<uint32_t>(intrusion_bucket);
+
+    int64_t time_bucket = timeBucket(timestamp);
+    setBucketBit(time_buckets_[time_bucket], slot);
+    slot_time_bucket_[slot] = time_bucket;
+}
+
+void MemoryIndex::erase(size_t slot) {
+    if (slot >= slot_intrusion_bucket_.size() || slot_intrusion_bucket_[slot] == NO_BUCKET) {
+        return;
+    }
+
+    clearBit(live_, slot);
+    clearBit(traumatic_, slot);
+    clearBit(fragmented_, slot);
+    clearBit(intrusion_[slot_intrusion_bucket_[slot]], slot);
+
+    auto bucket_it = time_buckets_.find(slot_time_bucket_[slot]);
+    if (bucket_it != time_buckets_.end()) {
+        clearBucketBit(bucket_it->second, slot);
+        if (popcount(bucket_it->second.words) == 0) {
+            time_buckets_.erase(bucket_it);
+        }
+    }
+
+    slot_intrusion_bucket_[slot] = NO_BUCKET;
+    live_count_--;
+}
+
+void MemoryIndex::clear() {
+    live_.clear();
+    traumatic_.clear();
+    fragmented_.clear();
+    for (auto& bucket : intrusion_) {
+        bucket.clear();
+    }
+    time_buckets_.clear();
+    slot_time_bucket_.clear();
+    slot_intrusion_bucket_.clear();
+    live_count_ = 0;
+}
+
+void MemoryIndex::setTimeBucketWidth(double time_bucket_ms) {
+    if (time_bucket_ms > 0.0 && time_bucket_ms != time_bucket_ms_) {
+        time_bucket_ms_ = time_bucket_ms;
+        clear();
+    }
+}
+
+MemoryIndex::Bitmap MemoryIndex::select(const Filter& filter) const {
+    Bitmap result = live_;
+
+    if (filter.traumatic_only) {
+        for (size_t w = 0; w < result.size(); ++w) result[w] &= traumatic_[w];
+    }
+
+    if (filter.fragmented_only) {
+        for (size_t w = 0; w < result.size(); ++w) result[w] &= fragmented_[w];
+    }
+
+    if (filter.min_intrusion_probability > 0.0) {
+        Bitmap intrusion_mask(result.size(), 0);
+        for (size_t b = intrusionBucket(filter.min_intrusion_probability); b < INTRUSION_BUCKETS; ++b) {
+            for (size_t w = 0; w < intrusion_mask.size(); ++w) intrusion_mask[w] |= intrusion_[b][w];
+        }
+        for (size_t w = 0; w < result.size(); ++w) result[w] &= intrusion_mask[w];
+    }
+
+    if (filter.hasTimeRange()) {
+        Bitmap time_mask(result.size(), 0);
+        if (filter.min_timestamp <= filter.max_timestamp) {
+            auto first = filter.min_timestamp > std::numeric_limits<double>::lowest()
+                ? time_buckets_.lower_bound(timeBucket(filter.min_timestamp))
+                : time_buckets_.begin();
+            auto last = filter.max_timestamp < std::numeric_limits<double>::max()
+                ? time_buckets_.upper_bound(timeBucket(filter.max_timestamp))
+                : time_buckets_.end();
+
+            for (auto it = first; it != last; ++it) {
+                const BucketBitmap& bucket = it->second;
+                for (size_t w = 0; w < bucket.words.size(); ++w) {
+                    time_mask[bucket.word_offset + w] |= bucket.words[w];
+                }
+            }
+        }
+        for (size_t w = 0; w < result.size(); ++w) result[w] &= time_mask[w];
+    }
+
+    return result;
+}
+
+size_t MemoryIndex::popcount(const Bitmap& bitmap) {
+    size_t count = 0;
+    for (uint64_t word : bitmap) {
+#if defined(_MSC_VER)
+        count += static_cast<size_t>(__popcnt64(word));
+#else
+        count += static_cast<size_t>(__builtin_popcountll(word));
+#endif
+    }
+    return count;
+}
+
+int64_t MemoryIndex::timeBucket(double timestamp) const {
+    return static_cast<int64_t>(std::floor(timestamp / time_bucket_ms_));
+}
+
+size_t MemoryIndex::intrusionBucket(double intrusion_probability) {
+    double clamped = std::max(0.0, std::min(1.0, intrusion_probability));
+    return std::min(INTRUSION_BUCKETS - 1,
+                    static_cast<size_t>(clamped * static_cast<double>(INTRUSION_BUCKETS)));
+}
+
+void MemoryIndex::ensureCapacity(size_t slot) {
+    size_t words = slot / 64 + 1;
+    if (live_.size() < words) {
+        live_.resize(words, 0);
+        traumatic_.resize(words, 0);
+        fragmented_.resize(words, 0);
+        for (auto& bucket : intrusion_) {
+            bucket.resize(words, 0);
+        }
+    }
+    if (slot_intrusion_bucket_.size() <= slot) {
+        slot_time_bucket_.resize(slot + 1, 0);
+        slot_intrusion_bucket_.resize(slot + 1, NO_BUCKET);
+    }
+}
+
+void MemoryIndex::setBit(Bitmap& bitmap, size_t slot) {
+    bitmap[slot / 64] |= (uint64_t{1} << (slot % 64));
+}
+
+void MemoryIndex::clearBit(Bitmap& bitmap, size_t slot) {
+    bitmap[slot / 64] &= ~(uint64_t{1} << (slot % 64));
+}
+
+void MemoryIndex::setBucketBit(BucketBitmap& bucket, size_t slot) {
+    size_t word = slot / 64;
+
+    // Memories land in time buckets in formation order, so each bucket
+    // only spans a narrow contiguous word range
+    if (bucket.words.empty()) {
+        bucket.word_offset = word;
+        bucket.words.assign(1, 0);
+    } else if (word < bucket.word_offset) {
+        bucket.words.insert(bucket.words.begin(), bucket.word_offset - word, 0);
+        bucket.word_offset = word;
+    } else if (word >= bucket.word_offset + bucket.words.size()) {
+        bucket.words.resize(word - bucket.word_offset + 1, 0);
+    }
+
+    bucket.words[word - bucket.word_offset] |= (uint64_t{1} << (slot % 64));
+}
+
+void MemoryIndex::clearBucketBit(BucketBitmap& bucket, size_t slot) {
+    size_t word = slot / 64;
+    if (word < bucket.word_offset || word >= bucket.word_offset + bucket.words.size()) {
+        return;
+    }
+    bucket.words[word - bucket.word_offset] &= ~(uint64_t{1} << (slot % 64));
+}
+
+unsigned MemoryIndex::countTrailingZeros(uint64_t word) {
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward64(&index, word);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+}
+
+} // namespace neurosim
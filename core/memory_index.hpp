@@ -0,0 +1,155 @@
+#pragma once
+
+#include <vector>
+#include <map>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+
+namespace neurosim {
+
+/**
+ * @brief Bitmap indexes over memory trace metadata
+ *
+ * Maintains one bit per memory slot for:
+ * - Traumatic and fragmented flags
+ * - Timestamp buckets (fixed-width, sparse per bucket)
+ * - Intrusion probability deciles
+ *
+ * Filters are resolved with word-wide AND/OR over the bitmaps so that
+ * filtered retrieval only touches the embeddings of surviving candidates.
+ * Candidates from partially covered timestamp/intrusion buckets are a
+ * superset; callers refine them with an exact per-trace check.
+ */
+class MemoryIndex {
+public:
+    using Bitmap = std::vector<uint64_t>;
+
+    /**
+     * @brief Metadata filter for memory queries
+     */
+    struct Filter {
+        bool traumatic_only = false;            ///< Only traumatic memories
+        bool fragmented_only = false;           ///< Only fragmented memories
+        double min_timestamp = std::numeric_limits<double>::lowest(); ///< Inclusive lower time bound
+        double max_timestamp = std::numeric_limits<double>::max();    ///< Inclusive upper time bound
+        double min_intrusion_probability = 0.0; ///< Minimum intrusion probability
+
+        bool hasTimeRange() const {
+            return min_timestamp > std::numeric_limits<double>::lowest() ||
+                   max_timestamp < std::numeric_limits<double>::max();
+        }
+    };
+
+public:
+    /**
+     * @brief Constructor
+     * @param time_bucket_ms Width of timestamp buckets in milliseconds
+     */
+    explicit MemoryIndex(double time_bucket_ms = 1000.0);
+
+    /**
+     * @brief Index metadata for a memory slot
+     * @param slot Position of the trace in the owning container
+     * @param traumatic Trauma flag
+     * @param fragmented Fragmentation flag
+     * @param timestamp Formation time
+     * @param intrusion_probability Intrusion probability (0-1)
+     */
+    void insert(size_t slot, bool traumatic, bool fragmented,
+                double timestamp, double intrusion_probability);
+
+    /**
+     * @brief Remove a slot from all bitmaps
+     * @param slot Slot to remove
+     */
+    void erase(size_t slot);
+
+    /**
+     * @brief Drop all indexed slots
+     */
+    void clear();
+
+    /**
+     * @brief Resolve a filter to a candidate bitmap
+     * @param filter Metadata filter
+     * @return Bitmap of candidate slots (superset at bucket edges)
+     */
+    Bitmap select(const Filter& filter) const;
+
+    /**
+     * @brief Number of indexed slots
+     */
+    size_t size() const { return live_count_; }
+
+    /**
+     * @brief Number of slots flagged traumatic
+     */
+    size_t traumaticCount() const { return popcount(traumatic_); }
+
+    /**
+     * @brief Number of slots flagged fragmented
+     */
+    size_t fragmentedCount() const { return popcount(fragmented_); }
+
+    /**
+     * @brief Change timestamp bucket width (requires re-inserting slots)
+     * @param time_bucket_ms New bucket width in milliseconds
+     */
+    void setTimeBucketWidth(double time_bucket_ms);
+
+    /**
+     * @brief Visit every set bit of a bitmap in ascending slot order
+     * @param bitmap Bitmap to scan
+     * @param visit Callable taking the slot index
+     */
+    template <typename Visitor>
+    static void forEach(const Bitmap& bitmap, Visitor&& visit) {
+        for (size_t w = 0; w < bitmap.size(); ++w) {
+            uint64_t word = bitmap[w];
+            while (word != 0) {
+                visit(w * 64 + countTrailingZeros(word));
+                word &= word - 1;
+            }
+        }
+    }
+
+    static size_t popcount(const Bitmap& bitmap);
+
+private:
+    /**
+     * @brief Bitmap covering a contiguous word range (timestamp buckets)
+     */
+    struct BucketBitmap {
+        size_t word_offset = 0;
+        Bitmap words;
+    };
+
+    static constexpr size_t INTRUSION_BUCKETS = 10;
+    static constexpr uint32_t NO_BUCKET = std::numeric_limits<uint32_t>::max();
+
+    double time_bucket_ms_;
+    size_t live_count_ = 0;
+
+    Bitmap live_;
+    Bitmap traumatic_;
+    Bitmap fragmented_;
+    Bitmap intrusion_[INTRUSION_BUCKETS];
+    std::map<int64_t, BucketBitmap> time_buckets_;
+
+    // Per-slot bucket keys so erase() can clear without scanning buckets
+    std::vector<int64_t> slot_time_bucket_;
+    std::vector<uint32_t> slot_intrusion_bucket_;
+
+    int64_t timeBucket(double timestamp) const;
+    static size_t intrusionBucket(double intrusion_probability);
+    void ensureCapacity(size_t slot);
+
+    static void setBit(Bitmap& bitmap, size_t slot);
+    static void clearBit(Bitmap& bitmap, size_t slot);
+    static void setBucketBit(BucketBitmap& bucket, size_t slot);
+    static void clearBucketBit(BucketBitmap& bucket, size_t slot);
+    static unsigned countTrailingZeros(uint64_t word);
+};
+
+} // namespace neurosim
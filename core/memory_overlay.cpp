@@ -1,16 +1,233 @@
 #include "memory_overlay.hpp"
+#include <algorithm>
+#include <cmath>
 
-// Stub implementation for memory overlay
+// Memory overlay implementation
 // Owner: Darrell Mesa (darrell.mesa@pm-ss.org)
 
 namespace neurosim {
 
-MemoryOverlay::MemoryOverlay() {
-    // Stub constructor
+MemoryOverlay::MemoryOverlay() : MemoryOverlay(MemoryConfig{}) {
+}
+
+MemoryOverlay::MemoryOverlay(const MemoryConfig& config)
+    : config_(config), memory_index_(config.index_time_bucket_ms), oldest_slot_(0), current_time_(0.0) {
+}
+
+MemoryOverlay::MemoryTrace MemoryOverlay::formMemory(const Eigen::VectorXd& content_embedding,
+                                                    double emotional_valence,
+                                                    const std::vector<std::string>& sensory_details,
+                                                    double timestamp) {
+    current_time_ = std::max(current_time_, timestamp);
+
+    MemoryTrace memory;
+    memory.content_embedding = content_embedding;
+    memory.emotional_valence = emotional_valence;
+    memory.sensory_details = sensory_details;
+    memory.timestamp = timestamp;
+    memory.last_accessed = timestamp;
+
+    storeMemory(memory);
+    return memory;
+}
+
+MemoryOverlay::RetrievalResult MemoryOverlay::retrieveMemories(const Eigen::VectorXd& retrieval_cue,
+                                                              size_t max_memories) {
+    return retrieveMemories(retrieval_cue, MemoryFilter{}, max_memories);
+}
+
+MemoryOverlay::RetrievalResult MemoryOverlay::retrieveMemories(const Eigen::VectorXd& retrieval_cue,
+                                                              const MemoryFilter& filter,
+                                                              size_t max_memories) {
+    RetrievalResult result;
+    if (retrieval_cue.size() == 0 || max_memories == 0) {
+        return result;
+    }
+
+    // Prune by metadata before any embedding math
+    std::vector<std::pair<double, size_t>> scored;
+    MemoryIndex::forEach(memory_index_.select(filter), [&](size_t index) {
+        const MemoryTrace& memory = memory_traces_[index];
+        if (!matchesFilter(memory, filter)) return;
+
+        double similarity = calculateMemorySimilarity(retrieval_cue, memory);
+        if (similarity >= config_.retrieval_threshold) {
+            scored.emplace_back(similarity, index);
+        }
+    });
+
+    size_t count = std::min(max_memories, scored.size());
+    std::partial_sort(scored.begin(), scored.begin() + count, scored.end(),
+                      [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    double total_similarity = 0.0;
+    size_t fragmented = 0;
+    for (size_t i = 0; i < count; ++i) {
+        MemoryTrace& memory = memory_traces_[scored[i].second];
+        updateAccessTimestamp(memory, current_time_);
+
+        total_similarity += scored[i].first;
+        if (memory.is_fragmented) fragmented++;
+        if (memory.is_traumatic && memory.intrusion_probability > config_.ptsd_intrusion_rate) {
+            result.intrusion_occurred = true;
+            recent_intrusions_.push_back(scored[i].second);
+        }
+
+        result.retrieved_memories.push_back(memory);
+    }
+
+    if (count > 0) {
+        result.retrieval_confidence = total_similarity / count;
+        result.completeness = 1.0 - 0.5 * static_cast<double>(fragmented) / count;
+        result.accuracy = result.retrieval_confidence * result.completeness;
+    }
+
+    return result;
+}
+
+std::vector<size_t> MemoryOverlay::findMemories(const MemoryFilter& filter) const {
+    std::vector<size_t> indices;
+    MemoryIndex::forEach(memory_index_.select(filter), [&](size_t index) {
+        if (matchesFilter(memory_traces_[index], filter)) {
+            indices.push_back(index);
+        }
+    });
+    return indices;
+}
+
+void MemoryOverlay::addTraumaticMemory(const Eigen::VectorXd& trauma_content,
+                                      double fragmentation_level,
+                                      double intrusion_probability) {
+    MemoryTrace memory;
+    memory.content_embedding = trauma_content;
+    memory.emotional_valence = -1.0;
+    memory.consolidation_strength = 1.0;
+    memory.timestamp = current_time_;
+    memory.last_accessed = current_time_;
+    memory.is_traumatic = true;
+    memory.is_fragmented = fragmentation_level > 0.5;
+    memory.intrusion_probability = intrusion_probability;
+
+    storeMemory(std::move(memory));
 }
 
 void MemoryOverlay::clearMemory() {
-    // Stub implementation
+    memory_traces_.clear();
+    recent_intrusions_.clear();
+    memory_index_.clear();
+    oldest_slot_ = 0;
+}
+
+void MemoryOverlay::updateConfig(const MemoryConfig& config) {
+    bool rebucket = config.index_time_bucket_ms != config_.index_time_bucket_ms;
+    config_ = config;
+
+    if (rebucket) {
+        memory_index_.setTimeBucketWidth(config_.index_time_bucket_ms);
+        rebuildIndex();
+    }
+    pruneOldMemories();
+}
+
+MemoryOverlay::MemoryStats MemoryOverlay::getMemoryStats() const {
+    MemoryStats stats;
+    stats.total_memories = memory_traces_.size();
+    stats.traumatic_memories = memory_index_.traumaticCount();
+    stats.fragmented_memories = memory_index_.fragmentedCount();
+    stats.recent_intrusions = recent_intrusions_.size();
+
+    if (!memory_traces_.empty()) {
+        double total_consolidation = 0.0;
+        double total_valence = 0.0;
+        for (const auto& memory : memory_traces_) {
+            total_consolidation += memory.consolidation_strength;
+            total_valence += memory.emotional_valence;
+        }
+        stats.average_consolidation = total_consolidation / memory_traces_.size();
+        stats.average_emotional_valence = total_valence / memory_traces_.size();
+    }
+
+    return stats;
+}
+
+double MemoryOverlay::calculateMemorySimilarity(const Eigen::VectorXd& cue,
+                                               const MemoryTrace& memory) const {
+    const Eigen::VectorXd& content = memory.content_embedding;
+    if (cue.size() == 0 || content.size() != cue.size()) return 0.0;
+
+    double norm_product = cue.norm() * content.norm();
+    if (norm_product == 0.0) return 0.0;
+
+    return std::max(0.0, cue.dot(content) / norm_product);
+}
+
+void MemoryOverlay::storeMemory(MemoryTrace memory) {
+    if (config_.max_memory_traces == 0) return;
+
+    if (memory_traces_.size() < config_.max_memory_traces) {
+        memory_traces_.push_back(std::move(memory));
+        reindexMemory(memory_traces_.size() - 1);
+        return;
+    }
+
+    // At capacity: overwrite the oldest slot and re-index only that slot
+    size_t slot = oldest_slot_;
+    oldest_slot_ = (oldest_slot_ + 1) % memory_traces_.size();
+    recent_intrusions_.erase(
+        std::remove(recent_intrusions_.begin(), recent_intrusions_.end(), slot),
+        recent_intrusions_.end());
+    memory_traces_[slot] = std::move(memory);
+    reindexMemory(slot);
+}
+
+void MemoryOverlay::pruneOldMemories() {
+    // Only needed when the capacity changes: unroll the ring into formation
+    // order so that it can grow or shrink from the oldest end
+    if (oldest_slot_ == 0 && memory_traces_.size() <= config_.max_memory_traces) return;
+
+    size_t count = memory_traces_.size();
+    size_t rotation = oldest_slot_;
+    std::rotate(memory_traces_.begin(), memory_traces_.begin() + rotation, memory_traces_.end());
+    oldest_slot_ = 0;
+
+    size_t excess = count > config_.max_memory_traces ? count - config_.max_memory_traces : 0;
+    memory_traces_.erase(memory_traces_.begin(), memory_traces_.begin() + excess);
+
+    std::vector<size_t> remapped;
+    for (size_t index : recent_intrusions_) {
+        size_t position = (index + count - rotation) % count;
+        if (position >= excess) {
+            remapped.push_back(position - excess);
+        }
+    }
+    recent_intrusions_ = std::move(remapped);
+
+    rebuildIndex();
+}
+
+void MemoryOverlay::rebuildIndex() {
+    memory_index_.clear();
+    for (size_t i = 0; i < memory_traces_.size(); ++i) {
+        reindexMemory(i);
+    }
+}
+
+void MemoryOverlay::reindexMemory(size_t index) {
+    const MemoryTrace& memory = memory_traces_[index];
+    memory_index_.insert(index, memory.is_traumatic, memory.is_fragmented,
+                         memory.timestamp, memory.intrusion_probability);
+}
+
+bool MemoryOverlay::matchesFilter(const MemoryTrace& memory, const MemoryFilter& filter) {
+    if (filter.traumatic_only && !memory.is_traumatic) return false;
+    if (filter.fragmented_only && !memory.is_fragmented) return false;
+    if (memory.timestamp < filter.min_timestamp || memory.timestamp > filter.max_timestamp) return false;
+    return memory.intrusion_probability >= filter.min_intrusion_probability;
+}
+
+void MemoryOverlay::updateAccessTimestamp(MemoryTrace& memory, double timestamp) {
+    memory.last_accessed = timestamp;
+    memory.retrieval_frequency += 1.0;
 }
 
 } // namespace neurosim
@@ -5,6 +5,7 @@
 #include <memory>
 #include <unordered_map>
 #include <Eigen/Dense>
+#include "memory_index.hpp"
 
 namespace neurosim {
 
@@ -60,8 +61,14 @@ public:
         double ptsd_avoidance_strength = 0.5;   ///< Memory avoidance tendency
         
         size_t max_memory_traces = 10000;       ///< Maximum stored memories
+        double index_time_bucket_ms = 1000.0;   ///< Timestamp bucket width for metadata index
     };
 
+    /**
+     * @brief Metadata filter applied before similarity search
+     */
+    using MemoryFilter = MemoryIndex::Filter;
+
     /**
      * @brief Memory retrieval result
      */
@@ -78,11 +85,13 @@ public:
     };
 
 public:
+    MemoryOverlay();
+
     /**
      * @brief Constructor
      * @param config Memory system configuration
      */
-    explicit MemoryOverlay(const MemoryConfig& config = MemoryConfig{});
+    explicit MemoryOverlay(const MemoryConfig& config);
 
     /**
      * @brief Form new memory from current experience
@@ -106,6 +115,28 @@ public:
     RetrievalResult retrieveMemories(const Eigen::VectorXd& retrieval_cue,
                                    size_t max_memories = 5);
 
+    /**
+     * @brief Retrieve memories matching a metadata filter
+     * 
+     * The filter is resolved against the bitmap index first, so embedding
+     * similarity is only computed for memories that pass it.
+     * 
+     * @param retrieval_cue Cue for memory retrieval
+     * @param filter Metadata filter (trauma/fragmentation flags, time range, intrusion)
+     * @param max_memories Maximum number of memories to retrieve
+     * @return Retrieval result
+     */
+    RetrievalResult retrieveMemories(const Eigen::VectorXd& retrieval_cue,
+                                   const MemoryFilter& filter,
+                                   size_t max_memories = 5);
+
+    /**
+     * @brief Find memories matching a metadata filter without similarity search
+     * @param filter Metadata filter
+     * @return Indices into getAllMemories() in ascending order
+     */
+    std::vector<size_t> findMemories(const MemoryFilter& filter) const;
+
     /**
      * @brief Consolidate memories over time
      * @param dt Time step for consolidation
@@ -139,6 +170,11 @@ public:
 
     /**
      * @brief Get all stored memory traces
+     *
+     * Once max_memory_traces is reached each new trace overwrites the
+     * oldest one in place, so the order is formation order only up to
+     * a rotation.
+     *
      * @return Vector of all memories
      */
     const std::vector<MemoryTrace>& getAllMemories() const { return memory_traces_; }
@@ -172,6 +208,9 @@ private:
     MemoryConfig config_;
     std::vector<MemoryTrace> memory_traces_;
     std::vector<size_t> recent_intrusions_; // Track recent intrusive memories
+    MemoryIndex memory_index_;               // Bitmap index over trace metadata
+    size_t oldest_slot_;                     // Ring position overwritten next once at capacity
+    double current_time_;
     
     // Internal processing methods
     double calculateMemorySimilarity(const Eigen::VectorXd& cue, 
@@ -196,7 +235,11 @@ private:
     void performReconsolidation(MemoryTrace& memory);
     
     // Utility methods
+    void storeMemory(MemoryTrace memory);
     void pruneOldMemories();
+    void rebuildIndex();
+    void reindexMemory(size_t index);
+    static bool matchesFilter(const MemoryTrace& memory, const MemoryFilter& filter);
     std::vector<size_t> findSimilarMemories(const Eigen::VectorXd& content, 
                                           double threshold) const;
     double calculateEmotionalWeight(double valence) const;
@@ -5,6 +5,9 @@
 
 namespace neurosim {
 
+MultiModalFusion::MultiModalFusion() : MultiModalFusion(FusionConfig{}) {
+}
+
 MultiModalFusion::MultiModalFusion(const FusionConfig& config) : config_(config) {
 }
 
@@ -90,28 +93,28 @@ Eigen::VectorXd MultiModalFusion::performWeightedFusion(const SensoryInput& inpu
     if (input.visual.size() > 0) {
         Eigen::VectorXd visual_resized = Eigen::VectorXd::Zero(max_size);
         visual_resized.head(std::min(max_size, static_cast<size_t>(input.visual.size()))) = 
-            input.visual.head(std::min(static_cast<int>(max_size), input.visual.size()));
+            input.visual.head(std::min(static_cast<Eigen::Index>(max_size), input.visual.size()));
         fused_embedding += config_.visual_weight * visual_resized;
     }
     
     if (input.auditory.size() > 0) {
         Eigen::VectorXd auditory_resized = Eigen::VectorXd::Zero(max_size);
         auditory_resized.head(std::min(max_size, static_cast<size_t>(input.auditory.size()))) = 
-            input.auditory.head(std::min(static_cast<int>(max_size), input.auditory.size()));
+            input.auditory.head(std::min(static_cast<Eigen::Index>(max_size), input.auditory.size()));
         fused_embedding += config_.auditory_weight * auditory_resized;
     }
     
     if (input.vestibular.size() > 0) {
         Eigen::VectorXd vestibular_resized = Eigen::VectorXd::Zero(max_size);
         vestibular_resized.head(std::min(max_size, static_cast<size_t>(input.vestibular.size()))) = 
-            input.vestibular.head(std::min(static_cast<int>(max_size), input.vestibular.size()));
+            input.vestibular.head(std::min(static_cast<Eigen::Index>(max_size), input.vestibular.size()));
         fused_embedding += config_.vestibular_weight * vestibular_resized;
     }
     
     if (input.interoceptive.size() > 0) {
         Eigen::VectorXd interoceptive_resized = Eigen::VectorXd::Zero(max_size);
         interoceptive_resized.head(std::min(max_size, static_cast<size_t>(input.interoceptive.size()))) = 
-            input.interoceptive.head(std::min(static_cast<int>(max_size), input.interoceptive.size()));
+            input.interoceptive.head(std::min(static_cast<Eigen::Index>(max_size), input.interoceptive.size()));
         fused_embedding += config_.interoceptive_weight * interoceptive_resized;
     }
     
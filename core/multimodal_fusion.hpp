@@ -80,11 +80,13 @@ public:
     };
 
 public:
+    MultiModalFusion();
+
     /**
      * @brief Constructor
      * @param config Fusion configuration
      */
-    explicit MultiModalFusion(const FusionConfig& config = FusionConfig{});
+    explicit MultiModalFusion(const FusionConfig& config);
 
     /**
      * @brief Fuse multi-modal sensory inputs
@@ -0,0 +1,158 @@
+#include "region_connectivity.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+
+namespace neurosim {
+
+RegionConnectivity::RegionConnectivity() : RegionConnectivity(ConnectivityConfig{}) {
+}
+
+RegionConnectivity::RegionConnectivity(const ConnectivityConfig& config)
+    : config_(config), dirty_(true), tick_(0) {
+}
+
+size_t RegionConnectivity::addRegion(const std::string& name) {
+    auto it = index_.find(name);
+    if (it != index_.end()) {
+        return it->second;
+    }
+
+    size_t index = names_.size();
+    names_.push_back(name);
+    index_[name] = index;
+    dirty_ = true;
+    return index;
+}
+
+size_t RegionConnectivity::indexOf(const std::string& name) const {
+    auto it = index_.find(name);
+    return it != index_.end() ? it->second : npos;
+}
+
+bool RegionConnectivity::connect(const std::string& source, const std::string& target,
+                                 double weight, double delay_ms) {
+    size_t from = indexOf(source);
+    size_t to = indexOf(target);
+    if (from == npos || to == npos) {
+        return false;
+    }
+
+    edges_.push_back({from, to, weight, delayTicks(delay_ms)});
+    dirty_ = true;
+    return true;
+}
+
+size_t RegionConnectivity::connectListed(const std::string& source, const std::vector<std::string>& targets) {
+    size_t added = 0;
+    for (const auto& target : targets) {
+        added += connect(source, target, config_.default_weight, config_.default_delay_ms) ? 1 : 0;
+    }
+    return added;
+}
+
+bool RegionConnectivity::loadFromJson(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+
+    nlohmann::json mappings = nlohmann::json::parse(file, nullptr, false);
+    if (mappings.is_discarded() || !mappings.contains("brain_regions")) {
+        return false;
+    }
+
+    for (const auto& [source, region] : mappings["brain_regions"].items()) {
+        if (!region.contains("connections")) {
+            continue;
+        }
+        for (const auto& entry : region["connections"]) {
+            if (entry.is_string()) {
+                connect(source, entry.get<std::string>(), config_.default_weight, config_.default_delay_ms);
+            } else if (entry.is_object() && entry.contains("target")) {
+                connect(source, entry["target"].get<std::string>(),
+                        entry.value("weight", config_.default_weight),
+                        entry.value("delay_ms", config_.default_delay_ms));
+            }
+        }
+    }
+    return true;
+}
+
+const Eigen::VectorXd& RegionConnectivity::propagate(const Eigen::Ref<const Eigen::VectorXd>& outputs) {
+    if (dirty_) {
+        rebuild();
+    }
+
+    network_input_.setZero();
+    if (history_.empty()) {
+        return network_input_;
+    }
+
+    // Newest outputs take the current ring slot (age 0)
+    size_t slots = history_.size();
+    size_t slot = tick_ % slots;
+    Eigen::Index overlap = std::min<Eigen::Index>(outputs.size(), history_[slot].size());
+    history_[slot].setZero();
+    history_[slot].head(overlap) = outputs.head(overlap);
+
+    for (size_t m = 0; m < weights_.size(); ++m) {
+        size_t age = delays_[m] - 1;
+        if (age > tick_) {
+            continue;  // Not enough history yet
+        }
+        network_input_.noalias() += weights_[m] * history_[(tick_ - age) % slots];
+    }
+
+    ++tick_;
+    return network_input_;
+}
+
+void RegionConnectivity::reset() {
+    for (auto& outputs : history_) {
+        outputs.setZero();
+    }
+    tick_ = 0;
+}
+
+size_t RegionConnectivity::maxDelayTicks() const {
+    size_t max_delay = 0;
+    for (const auto& edge : edges_) {
+        max_delay = std::max(max_delay, edge.delay_ticks);
+    }
+    return max_delay;
+}
+
+size_t RegionConnectivity::delayTicks(double delay_ms) const {
+    double ticks = config_.tick_ms > 0.0 ? std::round(delay_ms / config_.tick_ms) : 1.0;
+    return static_cast<size_t>(std::max(1.0, ticks));
+}
+
+void RegionConnectivity::rebuild() {
+    dirty_ = false;
+    Eigen::Index n = static_cast<Eigen::Index>(names_.size());
+
+    // Group edges by delay; duplicate edges are summed by setFromTriplets
+    std::map<size_t, std::vector<Eigen::Triplet<double>>> by_delay;
+    for (const auto& edge : edges_) {
+        by_delay[edge.delay_ticks].emplace_back(static_cast<Eigen::Index>(edge.target),
+                                                static_cast<Eigen::Index>(edge.source), edge.weight);
+    }
+
+    weights_.clear();
+    delays_.clear();
+    for (const auto& [delay, triplets] : by_delay) {
+        SparseMatrix matrix(n, n);
+        matrix.setFromTriplets(triplets.begin(), triplets.end());
+        weights_.push_back(std::move(matrix));
+        delays_.push_back(delay);
+    }
+
+    history_.assign(maxDelayTicks(), Eigen::VectorXd::Zero(n));
+    network_input_.setZero(n);
+    tick_ = 0;
+}
+
+} // namespace neurosim
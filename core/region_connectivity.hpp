@@ -0,0 +1,129 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <cstddef>
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+namespace neurosim {
+
+/**
+ * @brief Sparse weighted inter-region coupling with per-edge delays
+ *
+ * Regions are numbered in registration order. Edges are grouped by delay
+ * (in ticks) into one sparse row-major matrix per distinct delay, and the
+ * region outputs of the last max-delay ticks are kept in a ring. Each tick
+ * propagate() returns the network input of every region as
+ *   u = sum_d W_d * y(t - d + 1)
+ * so outputs passed now reach the targets' next step for a one-tick delay.
+ * Cost per tick is O(edges + regions * distinct delays).
+ *
+ * Edges come from RegionConfig::connected_regions (default weight/delay)
+ * or from the "connections" lists of brain_region_mappings.json, whose
+ * entries are either a region name or an object
+ * {"target": name, "weight": w, "delay_ms": d}. Edges to regions that are
+ * not registered are ignored.
+ */
+class RegionConnectivity {
+public:
+    using SparseMatrix = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+    /**
+     * @brief Coupling defaults
+     */
+    struct ConnectivityConfig {
+        double default_weight = 0.1;      ///< Weight of edges given by name only
+        double default_delay_ms = 10.0;   ///< Delay of edges given by name only
+        double tick_ms = 1.0;             ///< Duration of one propagate() call
+    };
+
+    /**
+     * @brief Directed edge
+     */
+    struct Edge {
+        size_t source;
+        size_t target;
+        double weight;
+        size_t delay_ticks;
+    };
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+public:
+    RegionConnectivity();
+    explicit RegionConnectivity(const ConnectivityConfig& config);
+
+    /**
+     * @brief Register a region (no-op if already registered)
+     * @return Index of the region
+     */
+    size_t addRegion(const std::string& name);
+
+    /**
+     * @brief Index of a region, or npos
+     */
+    size_t indexOf(const std::string& name) const;
+
+    /**
+     * @brief Add (or accumulate onto) an edge
+     * @param source Sending region
+     * @param target Receiving region
+     * @param weight Coupling weight
+     * @param delay_ms Conduction delay (at least one tick)
+     * @return False if either region is unknown
+     */
+    bool connect(const std::string& source, const std::string& target, double weight, double delay_ms);
+
+    /**
+     * @brief Add default-weight edges from a region to each listed target
+     * @return Number of edges added
+     */
+    size_t connectListed(const std::string& source, const std::vector<std::string>& targets);
+
+    /**
+     * @brief Add the edges listed in a region mapping file
+     * @param path Path to brain_region_mappings.json
+     * @return False if the file cannot be read or parsed
+     */
+    bool loadFromJson(const std::string& path);
+
+    /**
+     * @brief Propagate one tick of region outputs
+     * @param outputs Current output of every region (by index; missing entries are 0)
+     * @return Network input of every region (valid until the next call)
+     */
+    const Eigen::VectorXd& propagate(const Eigen::Ref<const Eigen::VectorXd>& outputs);
+
+    /**
+     * @brief Clear the delay ring (edges are kept)
+     */
+    void reset();
+
+    size_t regionCount() const { return names_.size(); }
+    const std::vector<std::string>& regionNames() const { return names_; }
+    const std::vector<Edge>& edges() const { return edges_; }
+    size_t edgeCount() const { return edges_.size(); }
+    size_t maxDelayTicks() const;
+    const ConnectivityConfig& getConfig() const { return config_; }
+
+private:
+    ConnectivityConfig config_;
+    std::vector<std::string> names_;
+    std::unordered_map<std::string, size_t> index_;
+    std::vector<Edge> edges_;
+
+    // Built lazily from edges_
+    bool dirty_;
+    std::vector<SparseMatrix> weights_;   // One matrix per distinct delay
+    std::vector<size_t> delays_;          // Delay of each matrix (ticks)
+    std::vector<Eigen::VectorXd> history_; // Ring of past outputs (age 0..max delay - 1)
+    size_t tick_;
+    Eigen::VectorXd network_input_;
+
+    size_t delayTicks(double delay_ms) const;
+    void rebuild();
+};
+
+} // namespace neurosim
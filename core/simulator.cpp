@@ -3,31 +3,22 @@
 #include "multimodal_fusion.hpp"
 #include "memory_overlay.hpp"
 #include "flashback_overlay.hpp"
+#include "region_connectivity.hpp"
 #include "../regions/amygdala.hpp"
 #include "../regions/hippocampus.hpp"
 #include "../regions/insula.hpp"
 #include "../regions/prefrontal.hpp"
 #include "../regions/cerebellum.hpp"
+#include "../regions/microcircuit_bank.hpp"
 #include <iostream>
 #include <sstream>
 #include <algorithm>
 
-// Temporary implementations for missing classes
-class MemoryOverlay {
-public:
-    MemoryOverlay() = default;
-    void clearMemory() {}
-};
-
-class FlashbackOverlay {
-public:
-    FlashbackOverlay() = default;
-    bool checkTrigger(const Eigen::VectorXd&) { return false; }
-    void addTraumaTemplate(const Eigen::VectorXd&, double) {}
-};
-
 namespace neurosim {
 
+NeuroSimulator::NeuroSimulator() : NeuroSimulator(Config{}) {
+}
+
 NeuroSimulator::NeuroSimulator(const Config& config) 
     : config_(config), current_time_(0.0) {
     
@@ -65,6 +56,7 @@ void NeuroSimulator::initializeBrainRegions() {
     base_config.circuit_config.ptsd_mode = config_.ptsd_overlay;
     base_config.circuit_config.ei_ratio = config_.excitation_ratio;
     base_config.circuit_config.inhibition_delay_ms = config_.inhibition_delay;
+    base_config.circuit_config.noise_seed = config_.noise_seed;
     
     // Initialize Amygdala
     base_config.region_name = "Amygdala";
@@ -74,18 +66,36 @@ void NeuroSimulator::initializeBrainRegions() {
     amygdala_config.ptsd_trauma_sensitivity = config_.ptsd_overlay ? 2.0 : 1.0;
     brain_regions_["Amygdala"] = std::make_unique<Amygdala>(base_config, amygdala_config);
     
-    // Initialize other regions (simplified for now)
+    // Initialize Hippocampus
     base_config.region_name = "Hippocampus";
-    brain_regions_["Hippocampus"] = std::make_unique<BrainRegion>(base_config);
+    Hippocampus::HippocampusConfig hippocampus_config;
+    hippocampus_config.autism_detail_enhancement = config_.autism_mode;
+    hippocampus_config.ptsd_fragmentation = config_.ptsd_overlay;
+    brain_regions_["Hippocampus"] = std::make_unique<Hippocampus>(base_config, hippocampus_config);
+    
+    // Initialize PFC (working memory and top-down inhibition)
+    base_config.region_name = "PFC";
+    PrefrontalCortex::PFCConfig pfc_config;
+    pfc_config.autism_executive_differences = config_.autism_mode;
+    pfc_config.ptsd_executive_dysfunction = config_.ptsd_overlay;
+    auto prefrontal = std::make_unique<PrefrontalCortex>(base_config, pfc_config);
+    prefrontal_ = prefrontal.get();
+    brain_regions_["PFC"] = std::move(prefrontal);
+    
+    // Initialize Cerebellum (forward model of the region drives)
+    base_config.region_name = "Cerebellum";
+    Cerebellum::CerebellumConfig cerebellum_config;
+    cerebellum_config.autism_timing_differences = config_.autism_mode;
+    cerebellum_config.ptsd_hypervigilance_effects = config_.ptsd_overlay;
+    auto cerebellum = std::make_unique<Cerebellum>(base_config, cerebellum_config);
+    cerebellum_ = cerebellum.get();
+    brain_regions_["Cerebellum"] = std::move(cerebellum);
+    
+    // Initialize other regions (simplified for now)
     
     base_config.region_name = "Insula";
     brain_regions_["Insula"] = std::make_unique<BrainRegion>(base_config);
     
-    base_config.region_name = "PFC";
-    brain_regions_["PFC"] = std::make_unique<BrainRegion>(base_config);
-    
-    base_config.region_name = "Cerebellum";
-    brain_regions_["Cerebellum"] = std::make_unique<BrainRegion>(base_config);
     
     base_config.region_name = "STG";
     brain_regions_["STG"] = std::make_unique<BrainRegion>(base_config);
@@ -93,6 +103,39 @@ void NeuroSimulator::initializeBrainRegions() {
     base_config.region_name = "ACC";
     brain_regions_["ACC"] = std::make_unique<BrainRegion>(base_config);
     
+    // Every region's microcircuit is advanced once per tick by the simulator;
+    // connectivity indices follow the same order so network input maps onto regions
+    region_connectivity_ = std::make_unique<RegionConnectivity>();
+    bool bank_supported = config_.circuit_bank;
+    for (const auto& [name, region] : brain_regions_) {
+        const auto& circuit_config = region->getConfig().circuit_config;
+        region->setDeferredStepping(true);
+        region_connectivity_->addRegion(name);
+        network_regions_.push_back(region.get());
+        bank_supported = bank_supported && MicroCircuitBank::supports(circuit_config) &&
+                         circuit_config.noise_seed == base_config.circuit_config.noise_seed;
+    }
+    
+    // On request, and when the bank reproduces every region's circuit, back
+    // them with one bank (slots in network order, seeded like the regions)
+    // and step all of them together
+    if (bank_supported) {
+        circuit_bank_ = std::make_shared<MicroCircuitBank>(base_config.circuit_config.noise_seed);
+        circuit_bank_->reserve(network_regions_.size());
+        for (BrainRegion* region : network_regions_) {
+            region->attachToBank(circuit_bank_);
+        }
+    }
+    for (const auto& [name, region] : brain_regions_) {
+        region_connectivity_->connectListed(name, region->getConfig().connected_regions);
+    }
+    if (!region_connectivity_->loadFromJson(config_.region_map_path) && config_.log_level == "DEBUG") {
+        std::cout << "Region map not loaded: " << config_.region_map_path << std::endl;
+    }
+    region_outputs_.setZero(static_cast<Eigen::Index>(network_regions_.size()));
+    amygdala_index_ = region_connectivity_->indexOf("Amygdala");
+    insula_index_ = region_connectivity_->indexOf("Insula");
+    
     // Register regions with brain router
     for (const auto& [name, region] : brain_regions_) {
         brain_router_->registerBrainRegion(name, region);
@@ -100,6 +143,13 @@ void NeuroSimulator::initializeBrainRegions() {
 }
 
 NeuroSimulator::SimulationState NeuroSimulator::process(const MultiModalInput& input) {
+    // Inputs stamped after the next step leave the regions idle until then
+    if (config_.idle_across_gaps) {
+        double gap = input.timestamp - (current_time_ + 1.0);
+        if (gap > 0.0) {
+            advanceIdle(gap);
+        }
+    }
     current_time_ += 1.0; // Increment simulation time
     
     SimulationState state;
@@ -129,14 +179,42 @@ NeuroSimulator::SimulationState NeuroSimulator::process(const MultiModalInput& i
     for (const auto& activation : region_activations) {
         if (brain_regions_.find(activation.region_name) != brain_regions_.end()) {
             double region_output = brain_regions_[activation.region_name]->processInput(
-                activation.activation_strength, 1.0);
+                activation.activation_strength, fused_representation.unified_embedding, 1.0);
             state.region_activations[activation.region_name] = region_output;
         }
     }
     
+    // Propagate region outputs along inter-region connections, then advance
+    // all region microcircuits with the staged inputs
+    for (size_t i = 0; i < network_regions_.size(); ++i) {
+        region_outputs_(static_cast<Eigen::Index>(i)) = network_regions_[i]->getCurrentActivation();
+    }
+    cerebellum_->observeDrives(region_outputs_);
+    network_input_ = region_connectivity_->propagate(region_outputs_);
+    
+    // Top-down inhibition from the PFC onto the limbic microcircuits
+    const auto& top_down = prefrontal_->getTopDownSignals();
+    if (amygdala_index_ != RegionConnectivity::npos) {
+        network_input_(static_cast<Eigen::Index>(amygdala_index_)) -= top_down.amygdala_inhibition;
+    }
+    if (insula_index_ != RegionConnectivity::npos) {
+        network_input_(static_cast<Eigen::Index>(insula_index_)) -= top_down.insula_inhibition;
+    }
+    for (size_t i = 0; i < network_regions_.size(); ++i) {
+        network_regions_[i]->stageInput(network_input_(static_cast<Eigen::Index>(i)));
+        network_regions_[i]->stepMicrocircuit(1.0);
+    }
+    if (circuit_bank_) {
+        circuit_bank_->step(1.0);
+    }
+    
     // Step 4: Check for flashback triggers (PTSD)
     if (config_.ptsd_overlay) {
-        state.flashback_triggered = flashback_overlay_->checkTrigger(fused_representation.unified_embedding);
+        // Single-input matches and triggers that build up over recent inputs
+        const Eigen::VectorXd& embedding = fused_representation.unified_embedding;
+        bool immediate = flashback_overlay_->checkTrigger(embedding);
+        bool windowed = flashback_overlay_->checkWindowedTrigger(embedding);
+        state.flashback_triggered = immediate || windowed;
         if (state.flashback_triggered) {
             // Enhance amygdala activation during flashback
             if (state.region_activations.find("Amygdala") != state.region_activations.end()) {
@@ -172,6 +250,16 @@ NeuroSimulator::SimulationState NeuroSimulator::process(const MultiModalInput& i
     return state;
 }
 
+void NeuroSimulator::advanceIdle(double duration) {
+    if (duration <= 0.0) {
+        return;
+    }
+    for (BrainRegion* region : network_regions_) {
+        region->idleMicrocircuit(duration, 1.0);
+    }
+    current_time_ += duration;
+}
+
 NeuroSimulator::SimulationState NeuroSimulator::processText(const std::string& text) {
     MultiModalInput input;
     input.text_tokens = text;
@@ -299,16 +387,20 @@ void NeuroSimulator::clearMemory() {
 }
 
 void NeuroSimulator::addTraumaMemory(const Eigen::VectorXd& trauma_embedding, double trigger_threshold) {
+    addTraumaMemory(TraumaTemplateLibrary::instance().intern(trauma_embedding), trigger_threshold);
+}
+
+void NeuroSimulator::addTraumaMemory(const TraumaTemplateHandle& trauma_template, double trigger_threshold) {
     if (flashback_overlay_) {
-        flashback_overlay_->addTraumaTemplate(trauma_embedding, trigger_threshold);
+        flashback_overlay_->addTraumaTemplate(trauma_template, trigger_threshold);
     }
     
-    // Also add to amygdala if available
+    // Also add to amygdala if available (same shared handle, no copy)
     auto amygdala_it = brain_regions_.find("Amygdala");
     if (amygdala_it != brain_regions_.end()) {
         auto* amygdala = dynamic_cast<Amygdala*>(amygdala_it->second.get());
         if (amygdala) {
-            amygdala->addTraumaTemplate(trauma_embedding, trigger_threshold);
+            amygdala->addTraumaTemplate(trauma_template, trigger_threshold);
         }
     }
 }
@@ -322,6 +414,10 @@ void NeuroSimulator::reset() {
         // This would require a reset method in BrainRegion
     }
     
+    if (region_connectivity_) {
+        region_connectivity_->reset();
+    }
+    
     if (brain_router_) {
         brain_router_->clearHistory();
     }
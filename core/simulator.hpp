@@ -1,11 +1,13 @@
 #pragma once
 
 #include <memory>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <unordered_map>
 #include <nlohmann/json.hpp>
 #include <Eigen/Dense>
+#include "trauma_template_library.hpp"
 
 namespace neurosim {
 
@@ -15,6 +17,10 @@ class MultiModalFusion;
 class MemoryOverlay;
 class FlashbackOverlay;
 class BrainRegion;
+class MicroCircuitBank;
+class RegionConnectivity;
+class PrefrontalCortex;
+class Cerebellum;
 
 /**
  * @brief Main NeuroSim Engine - simulates neurocognitive interactions
@@ -39,6 +45,10 @@ public:
         double memory_threshold = 0.7;     ///< Threshold for memory formation
         double flashback_sensitivity = 0.5; ///< Sensitivity to trauma triggers
         std::string log_level = "INFO";     ///< Logging verbosity
+        std::string region_map_path = "data/region_maps/brain_region_mappings.json"; ///< Inter-region connections
+        bool idle_across_gaps = false;      ///< Read input timestamps as absolute ms and idle regions across gaps
+        bool circuit_bank = false;          ///< Step region microcircuits together in a MicroCircuitBank (Euler only; drops per-region history, modulations and detectors)
+        uint64_t noise_seed = 0;            ///< Microcircuit noise seed (0 = nondeterministic)
     };
 
     /**
@@ -78,11 +88,13 @@ public:
     };
 
 public:
+    NeuroSimulator();
+
     /**
      * @brief Constructor
      * @param config Simulation configuration
      */
-    explicit NeuroSimulator(const Config& config = Config{});
+    explicit NeuroSimulator(const Config& config);
     
     /**
      * @brief Destructor
@@ -91,11 +103,30 @@ public:
 
     /**
      * @brief Process a single simulation step
+     *
+     * Each step advances simulated time by 1 ms. With
+     * Config::idle_across_gaps, the input timestamp is absolute simulated
+     * time, and an input stamped later than the next step first idles the
+     * regions across the gap (see advanceIdle()). Otherwise the timestamp
+     * is only passed on to fusion.
+     *
      * @param input Multi-modal input data
      * @return Current simulation state
      */
     SimulationState process(const MultiModalInput& input);
 
+    /**
+     * @brief Advance every region across a gap without input
+     *
+     * Region microcircuits are fast-forwarded (MicroCircuit::fastForward,
+     * through the bank slot with Config::circuit_bank) instead of being
+     * stepped once per ms; network propagation and top-down inhibition are
+     * held off during the gap.
+     *
+     * @param duration Gap length in milliseconds
+     */
+    void advanceIdle(double duration);
+
     /**
      * @brief Process text-only input (simplified interface)
      * @param text Input text
@@ -140,6 +171,17 @@ public:
      */
     void addTraumaMemory(const Eigen::VectorXd& trauma_embedding, double trigger_threshold = 0.8);
 
+    /**
+     * @brief Add a shared library trauma template for PTSD simulation
+     * 
+     * The template is referenced by handle from both the flashback overlay
+     * and the amygdala, so cohorts sharing it store it once per process.
+     * 
+     * @param trauma_template Handle from TraumaTemplateLibrary
+     * @param trigger_threshold Sensitivity threshold for triggering
+     */
+    void addTraumaMemory(const TraumaTemplateHandle& trauma_template, double trigger_threshold = 0.8);
+
     /**
      * @brief Reset simulation to initial state
      */
@@ -155,15 +197,25 @@ private:
     std::unique_ptr<FlashbackOverlay> flashback_overlay_;
     
     // Brain regions
-    std::unordered_map<std::string, std::unique_ptr<BrainRegion>> brain_regions_;
+    std::unordered_map<std::string, std::shared_ptr<BrainRegion>> brain_regions_; // Shared with the router
+    std::shared_ptr<MicroCircuitBank> circuit_bank_; // Circuit state of all regions with Config::circuit_bank (else null)
+    std::unique_ptr<RegionConnectivity> region_connectivity_; // Indexed like network_regions_
+    std::vector<BrainRegion*> network_regions_;      // Regions in connectivity index order, stepped together
+    Eigen::VectorXd region_outputs_;
+    Eigen::VectorXd network_input_;                  // Propagated region outputs, one per network region
+    PrefrontalCortex* prefrontal_ = nullptr;         // Owned by brain_regions_; source of top-down inhibition
+    size_t amygdala_index_ = 0;                      // Network regions receiving top-down inhibition
+    size_t insula_index_ = 0;
+    Cerebellum* cerebellum_ = nullptr;               // Owned by brain_regions_; forward model of region drives
     
     // Simulation state
-    double current_time_;
+    double current_time_;                            // ms, one per process() step
     std::vector<SimulationState> memory_traces_;
     
     // Internal methods
     void initializeBrainRegions();
     void updateMicrocircuitState(SimulationState& state);
+    std::string generateResponse(const SimulationState& state);
     void logState(const SimulationState& state) const;
 };
 
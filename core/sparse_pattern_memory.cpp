@@ -0,0 +1,282 @@
+#include "sparse_pattern_memory.hpp"
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace neurosim {
+
+namespace {
+inline size_t popcount64(uint64_t word) {
+#if defined(_MSC_VER)
+    return static_cast<size_t>(__popcnt64(word));
+#else
+    return static_cast<size_t>(__builtin_popcountll(word));
+#endif
+}
+
+// Index of the lowest set bit (word must be nonzero)
+inline unsigned countTrailingZeros(uint64_t word) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+}
+}
+
+SparsePatternMemory::SparsePatternMemory() : SparsePatternMemory(Config{}) {
+}
+
+SparsePatternMemory::SparsePatternMemory(const Config& config)
+    : config_(config), words_((std::max<size_t>(1, config.code_bits) + 63) / 64), dimension_(0),
+      count_(0), head_(0), next_id_(1) {
+    config_.capacity = std::max<size_t>(1, config_.capacity);
+    config_.fan_in = std::max<size_t>(1, config_.fan_in);
+    config_.active_bits = std::max<size_t>(1, std::min(config_.active_bits, codeBits()));
+}
+
+void SparsePatternMemory::encode(const Eigen::Ref<const Eigen::VectorXd>& pattern, Code& code, size_t active_bits) {
+    code.assign(words_, 0);
+    if (dimension_ == 0) {
+        if (pattern.size() == 0) {
+            return;
+        }
+        buildProjection(pattern.size());
+    }
+    if (pattern.squaredNorm() == 0.0) {
+        return;
+    }
+
+    // Drive of every code unit through its fixed sparse +-1 inputs
+    size_t units = codeBits();
+    size_t fan_in = config_.fan_in;
+    Eigen::Index available = std::min(dimension_, pattern.size());
+    drive_.resize(units);
+    for (size_t unit = 0; unit < units; ++unit) {
+        const uint32_t* inputs = &inputs_[unit * fan_in];
+        const int8_t* signs = &signs_[unit * fan_in];
+        double drive = 0.0;
+        for (size_t j = 0; j < fan_in; ++j) {
+            if (static_cast<Eigen::Index>(inputs[j]) < available) {
+                drive += signs[j] * pattern(static_cast<Eigen::Index>(inputs[j]));
+            }
+        }
+        drive_[unit] = drive;
+    }
+
+    // k-winners-take-all (ties go to the lower unit, so codes are deterministic)
+    size_t k = std::min(active_bits > 0 ? active_bits : config_.active_bits, units);
+    winners_.resize(units);
+    std::iota(winners_.begin(), winners_.end(), 0u);
+    std::nth_element(winners_.begin(), winners_.begin() + static_cast<std::ptrdiff_t>(k), winners_.end(),
+                     [this](uint32_t a, uint32_t b) {
+                         return drive_[a] > drive_[b] || (drive_[a] == drive_[b] && a < b);
+                     });
+    for (size_t i = 0; i < k; ++i) {
+        code[winners_[i] / 64] |= uint64_t{1} << (winners_[i] % 64);
+    }
+}
+
+uint64_t SparsePatternMemory::store(const Code& code, double value) {
+    size_t slot = head_;
+    if (codes_.size() < (slot + 1) * words_) {
+        // Storage grows with use up to the capacity
+        codes_.resize((slot + 1) * words_, 0);
+        values_.resize(slot + 1, 0.0);
+        overlaps_.resize(slot + 1, 0);
+    }
+    if (postings_.empty()) {
+        postings_.resize(codeBits());
+    }
+
+    uint64_t* words = &codes_[slot * words_];
+    if (count_ == config_.capacity) {
+        // The overwritten episode is the oldest, i.e. the front of each of its lists
+        for (size_t w = 0; w < words_; ++w) {
+            for (uint64_t bits = words[w]; bits != 0; bits &= bits - 1) {
+                Postings& list = postings_[w * 64 + static_cast<size_t>(countTrailingZeros(bits))];
+                if (++list.front * 2 >= list.slots.size()) {
+                    list.slots.erase(list.slots.begin(), list.slots.begin() + static_cast<std::ptrdiff_t>(list.front));
+                    list.front = 0;
+                }
+            }
+        }
+    }
+
+    size_t copied = std::min(words_, code.size());
+    std::copy(code.begin(), code.begin() + static_cast<std::ptrdiff_t>(copied), words);
+    std::fill(words + copied, words + words_, 0);
+    values_[slot] = value;
+    for (size_t w = 0; w < words_; ++w) {
+        for (uint64_t bits = words[w]; bits != 0; bits &= bits - 1) {
+            postings_[w * 64 + static_cast<size_t>(countTrailingZeros(bits))].slots.push_back(static_cast<uint32_t>(slot));
+        }
+    }
+
+    head_ = (head_ + 1) % config_.capacity;
+    count_ = std::min(count_ + 1, config_.capacity);
+    return next_id_++;
+}
+
+bool SparsePatternMemory::recall(const Code& cue, Hit& hit) const {
+    countOverlaps(cue);
+    if (touched_.empty()) {
+        return false;
+    }
+
+    size_t best_slot = touched_[0];
+    for (uint32_t slot : touched_) {
+        if (overlaps_[slot] > overlaps_[best_slot] ||
+            (overlaps_[slot] == overlaps_[best_slot] && newer(slot, best_slot))) {
+            best_slot = slot;
+        }
+    }
+
+    hit.id = idOf(best_slot);
+    hit.overlap = overlaps_[best_slot];
+    hit.similarity = static_cast<double>(hit.overlap) / static_cast<double>(activeBits(cue));
+    hit.value = values_[best_slot];
+    resetOverlaps();
+    return true;
+}
+
+void SparsePatternMemory::topK(const Code& cue, size_t k, size_t min_overlap, std::vector<Hit>& hits) const {
+    hits.clear();
+    if (k == 0) {
+        return;
+    }
+    countOverlaps(cue);
+    if (touched_.empty()) {
+        return;
+    }
+
+    candidates_.clear();
+    for (uint32_t slot : touched_) {
+        if (overlaps_[slot] >= min_overlap) {
+            candidates_.emplace_back(overlaps_[slot], slot);
+        }
+    }
+    resetOverlaps();
+
+    // Largest overlap first, newer episodes first among equals
+    size_t keep = std::min(k, candidates_.size());
+    std::partial_sort(candidates_.begin(), candidates_.begin() + static_cast<std::ptrdiff_t>(keep), candidates_.end(),
+                      [this](const std::pair<size_t, size_t>& a, const std::pair<size_t, size_t>& b) {
+                          return a.first > b.first || (a.first == b.first && newer(a.second, b.second));
+                      });
+
+    double cue_bits = static_cast<double>(activeBits(cue));
+    hits.reserve(keep);
+    for (size_t i = 0; i < keep; ++i) {
+        size_t slot = candidates_[i].second;
+        Hit hit;
+        hit.id = idOf(slot);
+        hit.overlap = candidates_[i].first;
+        hit.similarity = static_cast<double>(hit.overlap) / cue_bits;
+        hit.value = values_[slot];
+        hits.push_back(hit);
+    }
+}
+
+bool SparsePatternMemory::get(uint64_t id, Code& code, double& value) const {
+    if (!contains(id)) {
+        return false;
+    }
+    size_t slot = slotOf(id);
+    code.assign(codes_.begin() + static_cast<std::ptrdiff_t>(slot * words_),
+                codes_.begin() + static_cast<std::ptrdiff_t>((slot + 1) * words_));
+    value = values_[slot];
+    return true;
+}
+
+bool SparsePatternMemory::contains(uint64_t id) const {
+    return id < next_id_ && next_id_ - id <= count_;
+}
+
+void SparsePatternMemory::clear() {
+    count_ = 0;
+    head_ = 0;
+    for (Postings& list : postings_) {
+        list.slots.clear();
+        list.front = 0;
+    }
+}
+
+size_t SparsePatternMemory::overlap(const Code& a, const Code& b) {
+    size_t shared = 0;
+    size_t words = std::min(a.size(), b.size());
+    for (size_t w = 0; w < words; ++w) {
+        shared += popcount64(a[w] & b[w]);
+    }
+    return shared;
+}
+
+size_t SparsePatternMemory::activeBits(const Code& code) {
+    size_t active = 0;
+    for (uint64_t word : code) {
+        active += popcount64(word);
+    }
+    return active;
+}
+
+void SparsePatternMemory::buildProjection(Eigen::Index dimension) {
+    dimension_ = dimension;
+    size_t connections = codeBits() * config_.fan_in;
+    inputs_.resize(connections);
+    signs_.resize(connections);
+
+    std::mt19937_64 generator(config_.seed);
+    std::uniform_int_distribution<uint32_t> input(0, static_cast<uint32_t>(dimension - 1));
+    for (size_t i = 0; i < connections; ++i) {
+        inputs_[i] = input(generator);
+        signs_[i] = (generator() & 1) ? 1 : -1;
+    }
+}
+
+size_t SparsePatternMemory::slotOf(uint64_t id) const {
+    size_t age = static_cast<size_t>(next_id_ - 1 - id);
+    return (head_ + config_.capacity - 1 - age % config_.capacity) % config_.capacity;
+}
+
+uint64_t SparsePatternMemory::idOf(size_t slot) const {
+    return next_id_ - 1 - (head_ + config_.capacity - 1 - slot) % config_.capacity;
+}
+
+void SparsePatternMemory::countOverlaps(const Code& cue) const {
+    // Only episodes sharing an active unit with the cue are touched
+    touched_.clear();
+    if (postings_.empty()) {
+        return;
+    }
+    size_t words = std::min(words_, cue.size());
+    for (size_t w = 0; w < words; ++w) {
+        for (uint64_t bits = cue[w]; bits != 0; bits &= bits - 1) {
+            const Postings& list = postings_[w * 64 + static_cast<size_t>(countTrailingZeros(bits))];
+            for (size_t i = list.front; i < list.slots.size(); ++i) {
+                uint32_t slot = list.slots[i];
+                if (overlaps_[slot]++ == 0) {
+                    touched_.push_back(slot);
+                }
+            }
+        }
+    }
+}
+
+void SparsePatternMemory::resetOverlaps() const {
+    for (uint32_t slot : touched_) {
+        overlaps_[slot] = 0;
+    }
+}
+
+bool SparsePatternMemory::newer(size_t a, size_t b) const {
+    return (head_ + config_.capacity - 1 - a) % config_.capacity <
+           (head_ + config_.capacity - 1 - b) % config_.capacity;
+}
+
+} // namespace neurosim
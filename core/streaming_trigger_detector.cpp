@@ -0,0 +1,66 @@
+#include "streaming_trigger_detector.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace neurosim {
+
+StreamingTriggerDetector::StreamingTriggerDetector(size_t window_steps, double decay)
+    : window_steps_(1), decay_(1.0), decay_pow_window_(1.0),
+      head_(0), filled_(0), weight_sum_(0.0) {
+    configure(window_steps, decay);
+}
+
+void StreamingTriggerDetector::configure(size_t window_steps, double decay) {
+    window_steps_ = std::max<size_t>(1, window_steps);
+    decay_ = (decay > 0.0 && decay <= 1.0) ? decay : 1.0;
+    decay_pow_window_ = std::pow(decay_, static_cast<double>(window_steps_));
+    reset(running_.size());
+}
+
+void StreamingTriggerDetector::reset(Eigen::Index template_count) {
+    history_.setZero(template_count, static_cast<Eigen::Index>(window_steps_));
+    running_.setZero(template_count);
+    window_scores_.setZero(template_count);
+    head_ = 0;
+    filled_ = 0;
+    weight_sum_ = 0.0;
+}
+
+const Eigen::VectorXd& StreamingTriggerDetector::push(const Eigen::VectorXd& step_scores) {
+    if (step_scores.size() != running_.size()) {
+        reset(step_scores.size());
+    }
+
+    auto slot = history_.col(static_cast<Eigen::Index>(head_));
+
+    // Add the newest step, subtract the one leaving the window
+    if (filled_ == window_steps_) {
+        running_ = decay_ * running_ + step_scores - decay_pow_window_ * slot;
+    } else {
+        running_ = decay_ * running_ + step_scores;
+        weight_sum_ = decay_ * weight_sum_ + 1.0;
+        filled_++;
+    }
+    slot = step_scores;
+
+    head_ = (head_ + 1) % window_steps_;
+    if (head_ == 0 && filled_ == window_steps_) {
+        resum();
+    }
+
+    window_scores_ = running_ / weight_sum_;
+    return window_scores_;
+}
+
+void StreamingTriggerDetector::resum() {
+    // Exact re-accumulation once per wrap: newest step sits just before head_
+    running_.setZero();
+    double weight = 1.0;
+    for (size_t k = 0; k < filled_; ++k) {
+        size_t column = (head_ + window_steps_ - 1 - k) % window_steps_;
+        running_ += weight * history_.col(static_cast<Eigen::Index>(column));
+        weight *= decay_;
+    }
+}
+
+} // namespace neurosim
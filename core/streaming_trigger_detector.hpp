@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <Eigen/Dense>
+
+namespace neurosim {
+
+/**
+ * @brief Sliding-window accumulation of per-template trigger scores
+ *
+ * Triggers usually build up over several inputs rather than a single one.
+ * For every template this keeps the decayed window sum
+ *
+ *     S_t = sum_{k=0}^{W-1} decay^k * s_{t-k}
+ *
+ * updated in O(templates) per step as S_t = decay * S_{t-1} + s_t - decay^W * s_{t-W},
+ * independent of the window length W. The expired scores come from a ring
+ * buffer of past per-step scores; the sums are re-accumulated exactly once
+ * per window wrap so add/subtract rounding cannot drift.
+ */
+class StreamingTriggerDetector {
+public:
+    /**
+     * @brief Constructor
+     * @param window_steps Number of steps in the window (>= 1)
+     * @param decay Per-step weight decay in (0, 1]
+     */
+    explicit StreamingTriggerDetector(size_t window_steps = 10, double decay = 1.0);
+
+    /**
+     * @brief Change window length/decay (clears accumulated state)
+     */
+    void configure(size_t window_steps, double decay);
+
+    /**
+     * @brief Clear the window and size it for a template count
+     * @param template_count Number of templates scored per step
+     */
+    void reset(Eigen::Index template_count);
+
+    /**
+     * @brief Add one step of per-template scores
+     * @param step_scores Scores of the newest input (one per template)
+     * @return Window scores normalized by the sum of active weights
+     */
+    const Eigen::VectorXd& push(const Eigen::VectorXd& step_scores);
+
+    /**
+     * @brief Normalized window scores after the last push
+     */
+    const Eigen::VectorXd& getWindowScores() const { return window_scores_; }
+
+    size_t getWindowSteps() const { return window_steps_; }
+    double getDecay() const { return decay_; }
+    size_t getFilledSteps() const { return filled_; }
+
+private:
+    size_t window_steps_;
+    double decay_;
+    double decay_pow_window_;   // decay^W, weight of the expiring step
+
+    Eigen::MatrixXd history_;   // templates x W ring of per-step scores (one column per step)
+    Eigen::VectorXd running_;   // Decayed window sums
+    Eigen::VectorXd window_scores_;
+    size_t head_;               // Column the next step is written to
+    size_t filled_;
+    double weight_sum_;
+
+    void resum();
+};
+
+} // namespace neurosim
@@ -0,0 +1,258 @@
+#include "trauma_cluster_index.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace neurosim {
+
+TraumaClusterIndex::TraumaClusterIndex() : TraumaClusterIndex(IndexConfig{}) {
+}
+
+TraumaClusterIndex::TraumaClusterIndex(const IndexConfig& config)
+    : config_(config), depth_(0) {
+    config_.branching_factor = std::max<size_t>(2, config_.branching_factor);
+    config_.leaf_size = std::max<size_t>(1, config_.leaf_size);
+}
+
+void TraumaClusterIndex::build(const TraumaTemplateLibrary::MatrixHandle& patterns,
+                               const Eigen::Ref<const Eigen::VectorXd>& thresholds) {
+    clear();
+    if (!patterns || patterns->rows() == 0 || thresholds.size() != patterns->rows()) {
+        return;
+    }
+
+    patterns_ = patterns;
+    thresholds_ = thresholds;
+    std::vector<size_t> members(static_cast<size_t>(patterns_->rows()));
+    for (size_t i = 0; i < members.size(); ++i) {
+        members[i] = i;
+    }
+    buildNode(std::move(members), 1);
+}
+
+void TraumaClusterIndex::clear() {
+    nodes_.clear();
+    patterns_.reset();
+    thresholds_.resize(0);
+    depth_ = 0;
+}
+
+TraumaClusterIndex::QueryResult TraumaClusterIndex::query(const Eigen::Ref<const Eigen::VectorXd>& input,
+                                                          double generalization_floor,
+                                                          bool first_match) const {
+    QueryResult result;
+    if (nodes_.empty() || input.size() == 0) {
+        return result;
+    }
+
+    Eigen::Index dim = patterns_->cols();
+    Eigen::Index overlap = std::min(dim, input.size());
+    Eigen::VectorXd& q = query_;
+    q.setZero(dim);
+    q.head(overlap) = input.head(overlap);
+    double norm = q.norm();
+    if (norm == 0.0) {
+        return result;
+    }
+    q /= norm;
+
+    double best_margin = 0.0;
+    bool done = false;
+
+    // A node is worth expanding if some member could still beat the best
+    // trigger margin, or its leaves could still raise the generalization
+    auto worthVisiting = [&](const Node& node, double bound) {
+        if (done) {
+            return false;
+        }
+        if (result.triggered_template < 0) {
+            return bound >= node.min_threshold ||
+                   bound > std::max(generalization_floor, result.generalization);
+        }
+        return bound - node.min_threshold > best_margin;
+    };
+
+    // Best-first over similarity upper bounds (max-heap)
+    auto& frontier = frontier_;
+    frontier.clear();
+    frontier.emplace_back(similarityBound(nodes_[0], nodes_[0].centroid.dot(q)), 0);
+    result.clusters_visited = 1;
+
+    while (!frontier.empty()) {
+        std::pop_heap(frontier.begin(), frontier.end());
+        auto [bound, index] = frontier.back();
+        frontier.pop_back();
+
+        const Node& node = nodes_[index];
+        if (!worthVisiting(node, bound)) {
+            continue;
+        }
+
+        if (!node.children.empty()) {
+            for (size_t child : node.children) {
+                const Node& child_node = nodes_[child];
+                double child_bound = similarityBound(child_node, child_node.centroid.dot(q));
+                if (worthVisiting(child_node, child_bound)) {
+                    frontier.emplace_back(child_bound, child);
+                    std::push_heap(frontier.begin(), frontier.end());
+                }
+            }
+            result.clusters_visited += node.children.size();
+            continue;
+        }
+
+        if (result.triggered_template < 0) {
+            // Closest any member can be, discounted by the cluster's own
+            // spread so broad clusters generalize weakly
+            double generalization = std::min(1.0, std::max(0.0, bound)) * std::max(0.0, std::cos(node.radius));
+            if (generalization > generalization_floor) {
+                result.generalization = std::max(result.generalization, generalization);
+            }
+        }
+
+        if (bound < node.min_threshold) {
+            continue;
+        }
+        for (size_t member : node.members) {
+            Eigen::Index row = static_cast<Eigen::Index>(member);
+            double similarity = patterns_->row(row).dot(q);
+            double margin = similarity - thresholds_(row);
+            if (margin >= 0.0 && (result.triggered_template < 0 || margin > best_margin)) {
+                result.triggered_template = static_cast<long>(member);
+                result.score = similarity;
+                best_margin = margin;
+            }
+        }
+        done = first_match && result.triggered_template >= 0;
+    }
+
+    return result;
+}
+
+size_t TraumaClusterIndex::buildNode(std::vector<size_t> members, size_t level) {
+    size_t index = nodes_.size();
+    nodes_.emplace_back();
+    finishNode(nodes_[index], members);
+    depth_ = std::max(depth_, level);
+
+    if (members.size() <= config_.leaf_size) {
+        nodes_[index].members = std::move(members);
+        return index;
+    }
+
+    auto groups = splitMembers(members);
+    if (groups.size() < 2) {
+        // Degenerate split (duplicates); keep as an oversized leaf
+        nodes_[index].members = std::move(members);
+        return index;
+    }
+
+    for (auto& group : groups) {
+        size_t child = buildNode(std::move(group), level + 1);
+        nodes_[index].children.push_back(child);
+    }
+    return index;
+}
+
+void TraumaClusterIndex::finishNode(Node& node, const std::vector<size_t>& members) const {
+    Eigen::VectorXd sum = Eigen::VectorXd::Zero(patterns_->cols());
+    for (size_t member : members) {
+        sum += patterns_->row(static_cast<Eigen::Index>(member)).transpose();
+    }
+
+    double norm = sum.norm();
+    node.centroid = norm > 0.0 ? Eigen::VectorXd(sum / norm)
+                               : Eigen::VectorXd(patterns_->row(static_cast<Eigen::Index>(members.front())).transpose());
+
+    double min_similarity = 1.0;
+    for (size_t member : members) {
+        min_similarity = std::min(min_similarity,
+                                  patterns_->row(static_cast<Eigen::Index>(member)).dot(node.centroid));
+    }
+    node.radius = angleBetween(min_similarity);
+
+    node.min_threshold = std::numeric_limits<double>::infinity();
+    for (size_t member : members) {
+        node.min_threshold = std::min(node.min_threshold, thresholds_(static_cast<Eigen::Index>(member)));
+    }
+}
+
+std::vector<std::vector<size_t>> TraumaClusterIndex::splitMembers(const std::vector<size_t>& members) const {
+    size_t k = std::min(config_.branching_factor, members.size());
+    Eigen::Index dim = patterns_->cols();
+
+    // Deterministic farthest-point seeding
+    RowMatrix centroids(static_cast<Eigen::Index>(k), dim);
+    centroids.row(0) = patterns_->row(static_cast<Eigen::Index>(members.front()));
+    std::vector<double> best_similarity(members.size(), -2.0);
+    for (size_t c = 1; c < k; ++c) {
+        size_t farthest = 0;
+        for (size_t i = 0; i < members.size(); ++i) {
+            double similarity = patterns_->row(static_cast<Eigen::Index>(members[i]))
+                                    .dot(centroids.row(static_cast<Eigen::Index>(c - 1)));
+            best_similarity[i] = std::max(best_similarity[i], similarity);
+            if (best_similarity[i] < best_similarity[farthest]) {
+                farthest = i;
+            }
+        }
+        centroids.row(static_cast<Eigen::Index>(c)) = patterns_->row(static_cast<Eigen::Index>(members[farthest]));
+    }
+
+    // Gather members into a contiguous block so each Lloyd step is one GEMM
+    RowMatrix block(static_cast<Eigen::Index>(members.size()), dim);
+    for (size_t i = 0; i < members.size(); ++i) {
+        block.row(static_cast<Eigen::Index>(i)) = patterns_->row(static_cast<Eigen::Index>(members[i]));
+    }
+
+    std::vector<size_t> assignment(members.size(), 0);
+    for (size_t iteration = 0; iteration < config_.kmeans_iterations; ++iteration) {
+        Eigen::MatrixXd similarity = block * centroids.transpose();
+
+        bool changed = iteration == 0;
+        for (size_t i = 0; i < members.size(); ++i) {
+            Eigen::Index best = 0;
+            similarity.row(static_cast<Eigen::Index>(i)).maxCoeff(&best);
+            if (assignment[i] != static_cast<size_t>(best)) {
+                assignment[i] = static_cast<size_t>(best);
+                changed = true;
+            }
+        }
+        if (!changed) {
+            break;
+        }
+
+        RowMatrix sums = RowMatrix::Zero(static_cast<Eigen::Index>(k), dim);
+        for (size_t i = 0; i < members.size(); ++i) {
+            sums.row(static_cast<Eigen::Index>(assignment[i])) += block.row(static_cast<Eigen::Index>(i));
+        }
+        for (Eigen::Index c = 0; c < static_cast<Eigen::Index>(k); ++c) {
+            double norm = sums.row(c).norm();
+            if (norm > 0.0) {
+                centroids.row(c) = sums.row(c) / norm;
+            }
+        }
+    }
+
+    std::vector<std::vector<size_t>> groups(k);
+    for (size_t i = 0; i < members.size(); ++i) {
+        groups[assignment[i]].push_back(members[i]);
+    }
+    groups.erase(std::remove_if(groups.begin(), groups.end(),
+                                [](const auto& group) { return group.empty(); }),
+                 groups.end());
+    return groups;
+}
+
+double TraumaClusterIndex::angleBetween(double cosine) {
+    return std::acos(std::max(-1.0, std::min(1.0, cosine)));
+}
+
+double TraumaClusterIndex::similarityBound(const Node& node, double centroid_similarity) {
+    // Angular triangle inequality: no member is closer than the centroid
+    // angle minus the radius (slack covers rounding in the stored radius)
+    constexpr double kSlack = 1e-9;
+    double gap = std::max(0.0, angleBetween(centroid_similarity) - node.radius);
+    return std::cos(gap) + kSlack;
+}
+
+} // namespace neurosim
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <Eigen/Dense>
+#include "trauma_template_library.hpp"
+
+namespace neurosim {
+
+/**
+ * @brief Hierarchical spherical k-means tree over trauma templates
+ *
+ * Templates are unit-norm, so clustering uses cosine similarity. Every
+ * node stores a unit-norm centroid, an angular radius covering its
+ * members and the lowest trigger threshold among them. The centroid angle
+ * minus the radius bounds the similarity of every member, so a best-first
+ * search skips whole clusters that can neither trigger nor raise the
+ * generalization:
+ * - The triggered template is exact (same as scanning every template)
+ * - Generalization is bounded from a leaf's centroid and radius, so it
+ *   also responds to near-matches of a whole template family
+ * - Cost falls toward O(depth * branching * dim) when inputs are far from
+ *   most template families, and stays O(templates * dim) at worst
+ */
+class TraumaClusterIndex {
+public:
+    using RowMatrix = TraumaTemplateLibrary::RowMatrix;
+
+    /**
+     * @brief Tree construction/search parameters
+     */
+    struct IndexConfig {
+        size_t branching_factor = 8;   ///< Children per internal node
+        size_t leaf_size = 16;         ///< Max templates per leaf
+        size_t kmeans_iterations = 10; ///< Lloyd iterations per split
+    };
+
+    /**
+     * @brief Query result
+     */
+    struct QueryResult {
+        long triggered_template = -1;  ///< Template with the largest margin over its threshold (-1 if none)
+        double score = 0.0;            ///< Cosine similarity of the triggered template
+        double generalization = 0.0;   ///< Best leaf similarity bound, discounted by cluster spread (0-1);
+                                       ///< only searched while nothing has triggered
+        size_t clusters_visited = 0;   ///< Nodes scored during the search
+    };
+
+public:
+    TraumaClusterIndex();
+    explicit TraumaClusterIndex(const IndexConfig& config);
+
+    /**
+     * @brief Build the tree over unit-norm template rows
+     * @param patterns Shared template matrix (row i = template i); referenced, not copied
+     * @param thresholds Trigger threshold per template
+     */
+    void build(const TraumaTemplateLibrary::MatrixHandle& patterns,
+               const Eigen::Ref<const Eigen::VectorXd>& thresholds);
+
+    /**
+     * @brief Drop the tree
+     */
+    void clear();
+
+    /**
+     * @brief Find the triggered template and the generalization for an input
+     * @param input Query embedding (any norm; padded/truncated to the tree dimension)
+     * @param generalization_floor Leaves whose bound cannot exceed this are not
+     *        searched for generalization (result stays 0 below it)
+     * @param first_match Stop at the first leaf with a triggered template
+     * @return Triggered template and generalization estimate
+     */
+    QueryResult query(const Eigen::Ref<const Eigen::VectorXd>& input,
+                      double generalization_floor = 0.0, bool first_match = false) const;
+
+    bool empty() const { return nodes_.empty(); }
+    size_t nodeCount() const { return nodes_.size(); }
+    size_t depth() const { return depth_; }
+
+private:
+    struct Node {
+        Eigen::VectorXd centroid;      // Unit-norm mean direction
+        double radius = 0.0;           // Max angle (radians) from centroid to a member
+        double min_threshold = 0.0;    // Lowest member trigger threshold
+        std::vector<size_t> children;  // Empty for leaves
+        std::vector<size_t> members;   // Template rows (leaves only)
+    };
+
+    IndexConfig config_;
+    std::vector<Node> nodes_;
+    TraumaTemplateLibrary::MatrixHandle patterns_;
+    Eigen::VectorXd thresholds_;
+    size_t depth_;
+
+    // Scratch buffers reused across queries
+    mutable Eigen::VectorXd query_;
+    mutable std::vector<std::pair<double, size_t>> frontier_;
+
+    size_t buildNode(std::vector<size_t> members, size_t level);
+    void finishNode(Node& node, const std::vector<size_t>& members) const;
+    std::vector<std::vector<size_t>> splitMembers(const std::vector<size_t>& members) const;
+    static double angleBetween(double cosine);
+    static double similarityBound(const Node& node, double centroid_similarity);
+};
+
+} // namespace neurosim
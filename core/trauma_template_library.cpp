@@ -0,0 +1,201 @@
+#include "trauma_template_library.hpp"
+#include <algorithm>
+
+namespace neurosim {
+
+TraumaTemplateLibrary& TraumaTemplateLibrary::instance() {
+    static TraumaTemplateLibrary library;
+    return library;
+}
+
+TraumaTemplateHandle TraumaTemplateLibrary::intern(const Eigen::VectorXd& pattern) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return internLocked(pattern, std::string());
+}
+
+TraumaTemplateHandle TraumaTemplateLibrary::named(const std::string& name,
+                                                  const std::function<Eigen::VectorXd()>& factory) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = by_name_.find(name);
+    if (it != by_name_.end()) {
+        if (auto existing = it->second.lock()) {
+            return existing;
+        }
+    }
+
+    TraumaTemplateHandle handle = internLocked(factory(), name);
+    by_name_[name] = handle;
+    return handle;
+}
+
+TraumaTemplateHandle TraumaTemplateLibrary::find(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = by_name_.find(name);
+    return it != by_name_.end() ? it->second.lock() : nullptr;
+}
+
+TraumaTemplateLibrary::MatrixHandle TraumaTemplateLibrary::matrix(
+    const std::vector<TraumaTemplateHandle>& handles) {
+    if (handles.empty()) {
+        return nullptr;
+    }
+
+    std::vector<uint64_t> key = matrixKey(handles);
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (auto existing = findMatrixLocked(key)) {
+        return existing;
+    }
+
+    // Build once; every simulator with the same template list shares it
+    Eigen::Index dim = handles.front()->embedding.size();
+    RowMatrix built(static_cast<Eigen::Index>(handles.size()), dim);
+    for (size_t i = 0; i < handles.size(); ++i) {
+        fitRow(handles[i]->embedding, built.row(static_cast<Eigen::Index>(i)));
+    }
+    return storeMatrixLocked(key, std::move(built));
+}
+
+TraumaTemplateLibrary::MatrixHandle TraumaTemplateLibrary::adopt(
+    const std::vector<TraumaTemplateHandle>& handles, RowMatrix&& rows) {
+    if (handles.empty()) {
+        return nullptr;
+    }
+
+    std::vector<uint64_t> key = matrixKey(handles);
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (auto existing = findMatrixLocked(key)) {
+        return existing;
+    }
+
+    rows.conservativeResize(static_cast<Eigen::Index>(handles.size()), Eigen::NoChange);
+    return storeMatrixLocked(key, std::move(rows));
+}
+
+void TraumaTemplateLibrary::fitRow(const Eigen::VectorXd& embedding, Eigen::Ref<Eigen::RowVectorXd> row) {
+    Eigen::Index overlap = std::min(row.size(), embedding.size());
+    row.setZero();
+    row.head(overlap) = embedding.head(overlap).transpose();
+
+    double norm = row.norm();
+    if (norm > 0.0) {
+        row /= norm;
+    }
+}
+
+std::vector<uint64_t> TraumaTemplateLibrary::matrixKey(const std::vector<TraumaTemplateHandle>& handles) {
+    std::vector<uint64_t> key;
+    key.reserve(handles.size());
+    for (const auto& handle : handles) {
+        key.push_back(handle->id);
+    }
+    return key;
+}
+
+TraumaTemplateLibrary::MatrixHandle TraumaTemplateLibrary::findMatrixLocked(
+    const std::vector<uint64_t>& key) const {
+    auto it = matrices_.find(key);
+    return it != matrices_.end() ? it->second.lock() : nullptr;
+}
+
+TraumaTemplateLibrary::MatrixHandle TraumaTemplateLibrary::storeMatrixLocked(
+    const std::vector<uint64_t>& key, RowMatrix&& rows) {
+    MatrixHandle shared = std::make_shared<const RowMatrix>(std::move(rows));
+    matrices_[key] = shared;
+    purgeExpiredLocked();
+    return shared;
+}
+
+TraumaTemplateLibrary::LibraryStats TraumaTemplateLibrary::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    LibraryStats stats;
+    for (const auto& [hash, entries] : by_content_) {
+        for (const auto& entry : entries) {
+            if (auto pattern = entry.lock()) {
+                stats.live_templates++;
+                stats.stored_doubles += static_cast<size_t>(pattern->embedding.size());
+            }
+        }
+    }
+    for (const auto& [key, entry] : matrices_) {
+        if (auto shared = entry.lock()) {
+            stats.live_matrices++;
+            stats.stored_doubles += static_cast<size_t>(shared->size());
+        }
+    }
+    return stats;
+}
+
+TraumaTemplateHandle TraumaTemplateLibrary::internLocked(const Eigen::VectorXd& pattern,
+                                                         const std::string& name) {
+    Eigen::VectorXd normalized = pattern;
+    double norm = normalized.norm();
+    if (norm > 0.0) {
+        normalized /= norm;
+    }
+
+    // Identical content (after normalization) resolves to the same entry,
+    // whatever it is called; named() records other names as aliases
+    uint64_t hash = hashContent(normalized);
+    auto& bucket = by_content_[hash];
+    for (const auto& entry : bucket) {
+        auto existing = entry.lock();
+        if (existing && existing->embedding.size() == normalized.size() &&
+            existing->embedding == normalized) {
+            return existing;
+        }
+    }
+
+    auto created = std::make_shared<TraumaPattern>();
+    created->id = next_id_++;
+    created->name = name;
+    created->embedding = std::move(normalized);
+
+    TraumaTemplateHandle handle = created;
+    bucket.push_back(handle);
+    purgeExpiredLocked();
+    return handle;
+}
+
+void TraumaTemplateLibrary::purgeExpiredLocked() {
+    size_t entries = by_content_.size() + by_name_.size() + matrices_.size();
+    if (entries < purge_watermark_) {
+        return;
+    }
+
+    for (auto it = by_content_.begin(); it != by_content_.end();) {
+        auto& bucket = it->second;
+        bucket.erase(std::remove_if(bucket.begin(), bucket.end(),
+                                    [](const auto& entry) { return entry.expired(); }),
+                     bucket.end());
+        it = bucket.empty() ? by_content_.erase(it) : std::next(it);
+    }
+    for (auto it = by_name_.begin(); it != by_name_.end();) {
+        it = it->second.expired() ? by_name_.erase(it) : std::next(it);
+    }
+    for (auto it = matrices_.begin(); it != matrices_.end();) {
+        it = it->second.expired() ? matrices_.erase(it) : std::next(it);
+    }
+
+    // Amortize: next purge once the live set has doubled
+    entries = by_content_.size() + by_name_.size() + matrices_.size();
+    purge_watermark_ = std::max<size_t>(64, entries * 2);
+}
+
+uint64_t TraumaTemplateLibrary::hashContent(const Eigen::VectorXd& pattern) {
+    // FNV-1a over the raw coefficient bytes
+    uint64_t hash = 1469598103934665603ULL;
+    const auto* bytes = reinterpret_cast<const unsigned char*>(pattern.data());
+    size_t length = static_cast<size_t>(pattern.size()) * sizeof(double);
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash ^ static_cast<uint64_t>(pattern.size());
+}
+
+} // namespace neurosim
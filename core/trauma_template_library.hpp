@@ -0,0 +1,143 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <map>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+#include <Eigen/Dense>
+
+namespace neurosim {
+
+/**
+ * @brief Immutable, unit-norm trauma pattern shared by handle
+ */
+struct TraumaPattern {
+    uint64_t id = 0;                 ///< Process-unique template id
+    std::string name;                ///< Name it was created under (empty if anonymous; see TraumaTemplateLibrary::named)
+    Eigen::VectorXd embedding;       ///< Unit-norm pattern (zero if the input was zero)
+};
+
+/**
+ * @brief Reference-counted handle to a shared trauma pattern
+ */
+using TraumaTemplateHandle = std::shared_ptr<const TraumaPattern>;
+
+/**
+ * @brief Process-wide library of immutable trauma templates
+ *
+ * Simulators reference templates by handle instead of holding their own
+ * copies, so a cohort sharing a template (e.g. the Fallujah combat
+ * template) stores it once per process:
+ * - Patterns are interned by content; identical embeddings share one entry
+ * - Named templates are created once and returned by name afterwards; a
+ *   name whose content is already interned becomes an alias of that entry
+ * - Template matrices for a given ordered set of templates are interned
+ *   too, so simulators with the same template list share one contiguous
+ *   matching matrix
+ *
+ * Entries are held through weak references and are released when the last
+ * simulator drops its handle. All methods are thread-safe.
+ */
+class TraumaTemplateLibrary {
+public:
+    using RowMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+    using MatrixHandle = std::shared_ptr<const RowMatrix>;
+
+    /**
+     * @brief Get the process-wide library
+     */
+    static TraumaTemplateLibrary& instance();
+
+    /**
+     * @brief Intern a pattern by content
+     * @param pattern Template embedding (normalized on first insertion)
+     * @return Handle shared with every other caller interning the same content
+     */
+    TraumaTemplateHandle intern(const Eigen::VectorXd& pattern);
+
+    /**
+     * @brief Get a named template, creating it on first use
+     *
+     * If the factory's embedding is already interned (anonymously or under
+     * another name), the name becomes an alias of that entry, which keeps
+     * the name it was created under.
+     *
+     * @param name Library name (e.g. "fallujah_combat")
+     * @param factory Produces the embedding if the name is not yet present
+     * @return Shared handle
+     */
+    TraumaTemplateHandle named(const std::string& name,
+                               const std::function<Eigen::VectorXd()>& factory);
+
+    /**
+     * @brief Look up a named template
+     * @return Handle, or nullptr if no live template has that name
+     */
+    TraumaTemplateHandle find(const std::string& name) const;
+
+    /**
+     * @brief Get the shared matching matrix for an ordered template list
+     *
+     * Row i is handles[i]'s embedding fitted to the first template's
+     * dimension (see fitRow).
+     *
+     * @param handles Ordered template handles
+     * @return Shared immutable matrix
+     */
+    MatrixHandle matrix(const std::vector<TraumaTemplateHandle>& handles);
+
+    /**
+     * @brief Intern a matrix the caller already built for a template list
+     *
+     * Returns the shared matrix for the same list if one is live, otherwise
+     * takes ownership of the caller's rows instead of building them again.
+     *
+     * @param handles Ordered template handles
+     * @param rows Rows built with fitRow; rows past handles.size() are dropped
+     * @return Shared immutable matrix
+     */
+    MatrixHandle adopt(const std::vector<TraumaTemplateHandle>& handles, RowMatrix&& rows);
+
+    /**
+     * @brief Write an embedding into a matrix row of a different length
+     *
+     * Zero-pads or truncates to the row length and renormalizes, so rows of
+     * truncated templates stay unit-norm.
+     */
+    static void fitRow(const Eigen::VectorXd& embedding, Eigen::Ref<Eigen::RowVectorXd> row);
+
+    /**
+     * @brief Library statistics
+     */
+    struct LibraryStats {
+        size_t live_templates = 0;   ///< Templates still referenced by someone
+        size_t live_matrices = 0;    ///< Template matrices still referenced
+        size_t stored_doubles = 0;   ///< Embedding storage held by live entries
+    };
+    LibraryStats getStats() const;
+
+private:
+    TraumaTemplateLibrary() = default;
+
+    mutable std::mutex mutex_;
+    uint64_t next_id_ = 1;
+
+    std::unordered_map<uint64_t, std::vector<std::weak_ptr<const TraumaPattern>>> by_content_;
+    std::unordered_map<std::string, std::weak_ptr<const TraumaPattern>> by_name_;
+    std::map<std::vector<uint64_t>, std::weak_ptr<const RowMatrix>> matrices_;
+    size_t purge_watermark_ = 64;
+
+    static std::vector<uint64_t> matrixKey(const std::vector<TraumaTemplateHandle>& handles);
+    MatrixHandle findMatrixLocked(const std::vector<uint64_t>& key) const;
+    MatrixHandle storeMatrixLocked(const std::vector<uint64_t>& key, RowMatrix&& rows);
+
+    TraumaTemplateHandle internLocked(const Eigen::VectorXd& pattern, const std::string& name);
+    void purgeExpiredLocked();
+    static uint64_t hashContent(const Eigen::VectorXd& pattern);
+};
+
+} // namespace neurosim
@@ -0,0 +1,165 @@
+#include "trauma_template_matrix.hpp"
+#include <algorithm>
+
+namespace neurosim {
+
+TraumaTemplateMatrix::TraumaTemplateMatrix(Eigen::Index block_rows)
+    : count_(0), block_rows_(std::max<Eigen::Index>(1, block_rows)) {
+}
+
+size_t TraumaTemplateMatrix::add(const Eigen::VectorXd& pattern, double threshold) {
+    return add(TraumaTemplateLibrary::instance().intern(pattern), threshold);
+}
+
+size_t TraumaTemplateMatrix::add(const TraumaTemplateHandle& pattern, double threshold) {
+    if (patterns_) {
+        // First add after the matrix was shared: continue in a private copy
+        rows_.resize(thresholds_.size(), patterns_->cols());
+        rows_.topRows(patterns_->rows()) = *patterns_;
+        patterns_.reset();
+    } else if (count_ == 0) {
+        rows_.resize(thresholds_.size(), pattern->embedding.size());
+    }
+
+    reserve(count_ + 1);
+
+    // Append one unit-norm row; the library interns the batch on the next query
+    TraumaTemplateLibrary::fitRow(pattern->embedding, rows_.row(static_cast<Eigen::Index>(count_)));
+    handles_.push_back(pattern);
+    thresholds_(static_cast<Eigen::Index>(count_)) = threshold;
+    return count_++;
+}
+
+void TraumaTemplateMatrix::reserve(size_t rows) {
+    Eigen::Index capacity = thresholds_.size();
+    if (static_cast<Eigen::Index>(rows) <= capacity) {
+        return;
+    }
+
+    // Grow geometrically so repeated add() calls stay amortized O(dim)
+    Eigen::Index new_capacity = std::max<Eigen::Index>(static_cast<Eigen::Index>(rows),
+                                                       std::max<Eigen::Index>(8, capacity * 2));
+    if (!patterns_) {
+        rows_.conservativeResize(new_capacity, Eigen::NoChange);
+    }
+    thresholds_.conservativeResize(new_capacity);
+    handles_.reserve(static_cast<size_t>(new_capacity));
+}
+
+void TraumaTemplateMatrix::setThreshold(size_t index, double threshold) {
+    if (index < count_) {
+        thresholds_(static_cast<Eigen::Index>(index)) = threshold;
+    }
+}
+
+void TraumaTemplateMatrix::clear() {
+    patterns_.reset();
+    rows_.resize(0, 0);
+    handles_.clear();
+    thresholds_.resize(0);
+    count_ = 0;
+}
+
+TraumaTemplateMatrix::RowMatrix::ConstRowsBlockXpr TraumaTemplateMatrix::patterns() const {
+    const RowMatrix& rows = patterns_ ? *patterns_ : rows_;
+    return rows.topRows(static_cast<Eigen::Index>(count_));
+}
+
+const TraumaTemplateLibrary::MatrixHandle& TraumaTemplateMatrix::sharedPatterns() {
+    if (!patterns_ && count_ > 0) {
+        // Intern once per batch of adds and release the private buffer
+        patterns_ = TraumaTemplateLibrary::instance().adopt(handles_, std::move(rows_));
+        rows_ = RowMatrix();
+    }
+    return patterns_;
+}
+
+void TraumaTemplateMatrix::computeScores(const Eigen::Ref<const Eigen::VectorXd>& input, Eigen::VectorXd& scores) const {
+    scores.resize(static_cast<Eigen::Index>(count_));
+    if (!prepareQuery(input)) {
+        scores.setZero();
+        return;
+    }
+
+    scores.noalias() = patterns() * query_;
+    scores = scores.cwiseMax(0.0);
+}
+
+TraumaTemplateMatrix::Match TraumaTemplateMatrix::findTriggered(const Eigen::Ref<const Eigen::VectorXd>& input,
+                                                                bool early_exit) const {
+    Match match;
+    if (!prepareQuery(input)) {
+        return match;
+    }
+
+    Eigen::Index rows = static_cast<Eigen::Index>(count_);
+    Eigen::Index block = early_exit ? block_rows_ : rows;
+    double best_margin = 0.0;
+
+    for (Eigen::Index start = 0; start < rows; start += block) {
+        Eigen::Index n = std::min(block, rows - start);
+
+        // One GEMV per block, then a vector compare against the thresholds
+        scores_.resize(n);
+        scores_.noalias() = patterns().middleRows(start, n) * query_;
+        match.max_score = std::max(match.max_score, scores_.maxCoeff());
+
+        for (Eigen::Index i = 0; i < n; ++i) {
+            double margin = scores_(i) - thresholds_(start + i);
+            if (margin >= 0.0 && (match.index < 0 || margin > best_margin)) {
+                match.index = static_cast<long>(start + i);
+                match.score = scores_(i);
+                best_margin = margin;
+            }
+        }
+
+        if (early_exit && match.index >= 0) {
+            break;
+        }
+    }
+
+    match.max_score = std::max(0.0, match.max_score);
+    return match;
+}
+
+double TraumaTemplateMatrix::maxScore(const Eigen::Ref<const Eigen::VectorXd>& input) const {
+    if (count_ == 0 || !prepareQuery(input)) {
+        return 0.0;
+    }
+
+    scores_.resize(static_cast<Eigen::Index>(count_));
+    scores_.noalias() = patterns() * query_;
+    return std::max(0.0, scores_.maxCoeff());
+}
+
+size_t TraumaTemplateMatrix::countAbove(const Eigen::Ref<const Eigen::VectorXd>& input, double threshold) const {
+    if (count_ == 0 || !prepareQuery(input)) {
+        return 0;
+    }
+
+    scores_.resize(static_cast<Eigen::Index>(count_));
+    scores_.noalias() = patterns() * query_;
+    return static_cast<size_t>((scores_.array() > threshold).count());
+}
+
+bool TraumaTemplateMatrix::prepareQuery(const Eigen::Ref<const Eigen::VectorXd>& input) const {
+    Eigen::Index dim = dimension();
+    if (count_ == 0 || dim == 0 || input.size() == 0) {
+        return false;
+    }
+
+    Eigen::Index overlap = std::min(dim, input.size());
+    query_.resize(dim);
+    query_.head(overlap) = input.head(overlap);
+    query_.tail(dim - overlap).setZero();
+
+    double norm = query_.norm();
+    if (norm == 0.0) {
+        return false;
+    }
+
+    query_ /= norm;
+    return true;
+}
+
+} // namespace neurosim
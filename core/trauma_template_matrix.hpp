@@ -0,0 +1,151 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <Eigen/Dense>
+#include "trauma_template_library.hpp"
+
+namespace neurosim {
+
+/**
+ * @brief Contiguous, prenormalized store of trauma templates
+ *
+ * Templates are kept as unit-norm rows of one row-major matrix with a
+ * parallel threshold vector, so matching an input against every template
+ * is a single GEMV followed by a vector compare. Patterns come from the
+ * TraumaTemplateLibrary; adds append one row to a private buffer with
+ * geometric growth, and sharedPatterns() interns the buffer with the
+ * library once per batch of adds so every holder of the same template list
+ * shares one matrix. Only thresholds are per-instance.
+ *
+ * Queries only read the rows, but reuse per-instance scratch buffers: an
+ * instance is used from one thread at a time (the library is thread-safe).
+ * - No per-pair norm recomputation
+ * - Optional block-wise early exit on the first triggered template
+ * - Inputs and templates of a different length are zero-padded/truncated
+ *   to the matrix dimension (set by the first template)
+ */
+class TraumaTemplateMatrix {
+public:
+    using RowMatrix = TraumaTemplateLibrary::RowMatrix;
+
+    /**
+     * @brief Match result for a single query
+     */
+    struct Match {
+        long index = -1;          ///< Triggered template (-1 if none)
+        double score = 0.0;       ///< Cosine similarity of the triggered template
+        double max_score = 0.0;   ///< Best similarity over all scanned templates
+    };
+
+public:
+    /**
+     * @brief Constructor
+     * @param block_rows Rows scored per block when early exit is enabled
+     */
+    explicit TraumaTemplateMatrix(Eigen::Index block_rows = 64);
+
+    /**
+     * @brief Add a template
+     * @param pattern Template embedding (normalized on insertion)
+     * @param threshold Cosine similarity required to trigger
+     * @return Row index of the new template
+     */
+    size_t add(const Eigen::VectorXd& pattern, double threshold);
+
+    /**
+     * @brief Add a shared library template
+     * @param pattern Library handle
+     * @param threshold Cosine similarity required to trigger
+     * @return Row index of the new template
+     */
+    size_t add(const TraumaTemplateHandle& pattern, double threshold);
+
+    /**
+     * @brief Reserve row capacity ahead of a batch of adds
+     */
+    void reserve(size_t rows);
+
+    /**
+     * @brief Change the trigger threshold of a template
+     */
+    void setThreshold(size_t index, double threshold);
+
+    /**
+     * @brief Remove all templates
+     */
+    void clear();
+
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    Eigen::Index dimension() const { return patterns_ ? patterns_->cols() : rows_.cols(); }
+
+    /**
+     * @brief Normalized template rows, one per template
+     */
+    RowMatrix::ConstRowsBlockXpr patterns() const;
+
+    /**
+     * @brief Shared handle to the template matrix (nullptr when empty)
+     *
+     * Interns the rows added since the last call with the library, so this
+     * is the one point where the matrix changes representation.
+     */
+    const TraumaTemplateLibrary::MatrixHandle& sharedPatterns();
+
+    /**
+     * @brief Library handles, one per row
+     */
+    const std::vector<TraumaTemplateHandle>& handles() const { return handles_; }
+
+    /**
+     * @brief Trigger thresholds, one per template
+     */
+    Eigen::VectorBlock<const Eigen::VectorXd> thresholds() const {
+        return thresholds_.head(static_cast<Eigen::Index>(count_));
+    }
+
+    /**
+     * @brief Cosine similarity of the input against every template
+     * @param input Query embedding
+     * @param scores Output vector (resized to size())
+     */
+    void computeScores(const Eigen::Ref<const Eigen::VectorXd>& input, Eigen::VectorXd& scores) const;
+
+    /**
+     * @brief Find a triggered template
+     * @param input Query embedding
+     * @param early_exit Stop at the first block containing a triggered template
+     * @return Triggered template with the largest margin over its threshold
+     *         (within the first triggering block when early_exit is set)
+     */
+    Match findTriggered(const Eigen::Ref<const Eigen::VectorXd>& input, bool early_exit = false) const;
+
+    /**
+     * @brief Largest cosine similarity over all templates
+     */
+    double maxScore(const Eigen::Ref<const Eigen::VectorXd>& input) const;
+
+    /**
+     * @brief Number of templates whose score exceeds a common threshold
+     */
+    size_t countAbove(const Eigen::Ref<const Eigen::VectorXd>& input, double threshold) const;
+
+private:
+    // Interned matrix once the last batch of adds has been shared; until
+    // then the live rows are the first count_ rows of rows_
+    TraumaTemplateLibrary::MatrixHandle patterns_;
+    RowMatrix rows_;                         // capacity rows; released once interned
+    std::vector<TraumaTemplateHandle> handles_;
+    Eigen::VectorXd thresholds_;             // capacity entries; first count_ are live
+    size_t count_;
+    Eigen::Index block_rows_;
+
+    // Scratch buffers reused across queries to keep matching allocation-free
+    mutable Eigen::VectorXd query_;
+    mutable Eigen::VectorXd scores_;
+
+    bool prepareQuery(const Eigen::Ref<const Eigen::VectorXd>& input) const;
+};
+
+} // namespace neurosim
@@ -26,6 +26,9 @@ const std::vector<std::string> AudioToEmbedding::threat_sounds_ = {
     "explosion", "gunfire", "scream", "crash", "alarm"
 };
 
+AudioToEmbedding::AudioToEmbedding() : AudioToEmbedding(AudioConfig{}) {
+}
+
 AudioToEmbedding::AudioToEmbedding(const AudioConfig& config) : config_(config) {
 }
 
@@ -110,11 +110,13 @@ public:
     };
 
 public:
+    AudioToEmbedding();
+
     /**
      * @brief Constructor
      * @param config Audio processing configuration
      */
-    explicit AudioToEmbedding(const AudioConfig& config = AudioConfig{});
+    explicit AudioToEmbedding(const AudioConfig& config);
 
     /**
      * @brief Process audio input and generate embedding
@@ -22,6 +22,9 @@ const std::vector<std::string> ImageToEmbedding::threat_objects_ = {
     "weapon", "fire", "smoke", "debris", "unknown_figure"
 };
 
+ImageToEmbedding::ImageToEmbedding() : ImageToEmbedding(VisualConfig{}) {
+}
+
 ImageToEmbedding::ImageToEmbedding(const VisualConfig& config) : config_(config) {
 }
 
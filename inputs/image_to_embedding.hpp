@@ -93,11 +93,13 @@ public:
     };
 
 public:
+    ImageToEmbedding();
+
     /**
      * @brief Constructor
      * @param config Visual processing configuration
      */
-    explicit ImageToEmbedding(const VisualConfig& config = VisualConfig{});
+    explicit ImageToEmbedding(const VisualConfig& config);
 
     /**
      * @brief Process visual input and generate embedding
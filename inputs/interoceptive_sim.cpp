@@ -22,6 +22,9 @@ const std::vector<std::string> InteroceptiveSim::signal_types_ = {
     "cardiovascular", "respiratory", "gastrointestinal", "thermoregulatory", "pain"
 };
 
+InteroceptiveSim::InteroceptiveSim() : InteroceptiveSim(InteroceptiveConfig{}) {
+}
+
 InteroceptiveSim::InteroceptiveSim(const InteroceptiveConfig& config) : config_(config) {
 }
 
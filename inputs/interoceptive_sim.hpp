@@ -133,11 +133,13 @@ public:
     };
 
 public:
+    InteroceptiveSim();
+
     /**
      * @brief Constructor
      * @param config Interoceptive processing configuration
      */
-    explicit InteroceptiveSim(const InteroceptiveConfig& config = InteroceptiveConfig{});
+    explicit InteroceptiveSim(const InteroceptiveConfig& config);
 
     /**
      * @brief Process interoceptive input and generate embedding
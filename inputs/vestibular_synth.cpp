@@ -18,6 +18,9 @@ const std::vector<std::string> VestibularSynth::motion_directions_ = {
     "forward", "backward", "left", "right", "up", "down", "rotational"
 };
 
+VestibularSynth::VestibularSynth() : VestibularSynth(VestibularConfig{}) {
+}
+
 VestibularSynth::VestibularSynth(const VestibularConfig& config) : config_(config) {
 }
 
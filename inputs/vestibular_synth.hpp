@@ -118,11 +118,13 @@ public:
     };
 
 public:
+    VestibularSynth();
+
     /**
      * @brief Constructor
      * @param config Vestibular processing configuration
      */
-    explicit VestibularSynth(const VestibularConfig& config = VestibularConfig{});
+    explicit VestibularSynth(const VestibularConfig& config);
 
     /**
      * @brief Process vestibular input and generate embedding
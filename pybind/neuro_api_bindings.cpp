@@ -23,10 +23,13 @@ PYBIND11_MODULE(neurosim_py, m) {
         .def(py::init<const NeuroSimulator::Config&>(), py::arg("config") = NeuroSimulator::Config{})
         .def("process", &NeuroSimulator::process, "Process multi-modal input")
         .def("process_text", &NeuroSimulator::processText, "Process text-only input")
+        .def("advance_idle", &NeuroSimulator::advanceIdle, py::arg("duration"),
+             "Advance all regions across a gap without input (ms)")
         .def("export_to_json", &NeuroSimulator::exportToJson, "Export state to JSON")
         .def("get_memory_traces", &NeuroSimulator::getMemoryTraces, "Get memory traces")
         .def("clear_memory", &NeuroSimulator::clearMemory, "Clear all memory")
-        .def("add_trauma_memory", &NeuroSimulator::addTraumaMemory, "Add trauma memory")
+        .def("add_trauma_memory", py::overload_cast<const Eigen::VectorXd&, double>(&NeuroSimulator::addTraumaMemory),
+             "Add trauma memory")
         .def("update_config", &NeuroSimulator::updateConfig, "Update configuration")
         .def("get_config", &NeuroSimulator::getConfig, "Get current configuration")
         .def("reset", &NeuroSimulator::reset, "Reset simulation");
@@ -40,7 +43,10 @@ PYBIND11_MODULE(neurosim_py, m) {
         .def_readwrite("inhibition_delay", &NeuroSimulator::Config::inhibition_delay)
         .def_readwrite("memory_threshold", &NeuroSimulator::Config::memory_threshold)
         .def_readwrite("flashback_sensitivity", &NeuroSimulator::Config::flashback_sensitivity)
-        .def_readwrite("log_level", &NeuroSimulator::Config::log_level);
+        .def_readwrite("log_level", &NeuroSimulator::Config::log_level)
+        .def_readwrite("idle_across_gaps", &NeuroSimulator::Config::idle_across_gaps)
+        .def_readwrite("circuit_bank", &NeuroSimulator::Config::circuit_bank)
+        .def_readwrite("noise_seed", &NeuroSimulator::Config::noise_seed);
 
     // NeuroSimulator::SimulationState
     py::class_<NeuroSimulator::SimulationState>(m, "SimulationState")
@@ -209,10 +215,14 @@ PYBIND11_MODULE(neurosim_py, m) {
     }, "Create combat PTSD-specific configuration");
 
     m.def("add_fallujah_trauma_template", [](NeuroSimulator& sim) {
-        // Create a trauma template based on Operation Phantom Fury context
-        Eigen::VectorXd trauma_embedding = Eigen::VectorXd::Random(512);
-        // In a real implementation, this would be based on actual combat scenarios
-        sim.addTraumaMemory(trauma_embedding, 0.7);
+        // Create a trauma template based on Operation Phantom Fury context.
+        // Shared through the template library: created once per process,
+        // referenced by handle from every simulator in the cohort.
+        auto trauma_template = TraumaTemplateLibrary::instance().named("fallujah_combat", []() {
+            // In a real implementation, this would be based on actual combat scenarios
+            return Eigen::VectorXd(Eigen::VectorXd::Random(512));
+        });
+        sim.addTraumaMemory(trauma_template, 0.7);
     }, "Add Fallujah combat trauma template");
 }
 
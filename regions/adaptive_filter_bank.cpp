@@ -0,0 +1,79 @@
+#include "adaptive_filter_bank.hpp"
+#include <algorithm>
+
+namespace neurosim {
+
+AdaptiveFilterBank::AdaptiveFilterBank() : AdaptiveFilterBank(Config{}) {
+}
+
+AdaptiveFilterBank::AdaptiveFilterBank(const Config& config)
+    : config_(config), channels_(0), head_(0) {
+    config_.taps = std::max<size_t>(1, config_.taps);
+    config_.forgetting_factor = std::max(1e-3, std::min(1.0, config_.forgetting_factor));
+}
+
+const Eigen::VectorXd& AdaptiveFilterBank::step(const Eigen::Ref<const Eigen::VectorXd>& observed) {
+    if (observed.size() != channels_) {
+        resize(observed.size());
+    }
+    if (channels_ == 0) {
+        return prediction_;
+    }
+
+    // Learn from the error of the prediction made from the current taps
+    Eigen::Map<const Eigen::VectorXd> taps = regressor();
+    error_ = observed - prediction_;
+    if (config_.algorithm == Algorithm::RLS) {
+        // P is kept symmetric by only ever touching its lower triangle
+        gain_.noalias() = inverse_correlation_.selfadjointView<Eigen::Lower>() * taps;
+        double denominator = config_.forgetting_factor + taps.dot(gain_);
+        if (denominator > 0.0) {
+            gain_ /= denominator;
+            for (Eigen::Index channel = 0; channel < channels_; ++channel) {
+                weights_.row(channel) += error_(channel) * gain_.transpose();
+            }
+            inverse_correlation_.selfadjointView<Eigen::Lower>().rankUpdate(gain_, -denominator);
+            inverse_correlation_.triangularView<Eigen::Lower>() *= 1.0 / config_.forgetting_factor;
+        }
+    } else {
+        double gain = config_.step_size / (config_.regularization + taps.squaredNorm());
+        for (Eigen::Index channel = 0; channel < channels_; ++channel) {
+            weights_.row(channel) += (gain * error_(channel)) * taps.transpose();
+        }
+    }
+
+    // Push the frame (both copies) and predict the next one
+    size_t frame = static_cast<size_t>(channels_);
+    std::copy(observed.data(), observed.data() + frame, history_.begin() + static_cast<std::ptrdiff_t>(head_ * frame));
+    std::copy(observed.data(), observed.data() + frame,
+              history_.begin() + static_cast<std::ptrdiff_t>((head_ + config_.taps) * frame));
+    head_ = (head_ + 1) % config_.taps;
+
+    prediction_.noalias() = weights_ * regressor();
+    return prediction_;
+}
+
+void AdaptiveFilterBank::reset() {
+    resize(channels_);
+}
+
+void AdaptiveFilterBank::resize(Eigen::Index channels) {
+    channels_ = channels;
+    Eigen::Index inputs = this->inputs();
+    history_.assign(2 * config_.taps * static_cast<size_t>(channels), 0.0);
+    head_ = 0;
+    weights_.setZero(channels, inputs);
+    if (config_.algorithm == Algorithm::RLS) {
+        inverse_correlation_ = Eigen::MatrixXd::Identity(inputs, inputs) * config_.initial_covariance;
+        gain_.setZero(inputs);
+    }
+    prediction_.setZero(channels);
+    error_.setZero(channels);
+}
+
+Eigen::Map<const Eigen::VectorXd> AdaptiveFilterBank::regressor() const {
+    // Frames head_ .. head_ + taps - 1 of the mirrored ring, oldest first
+    return Eigen::Map<const Eigen::VectorXd>(history_.data() + head_ * static_cast<size_t>(channels_), inputs());
+}
+
+} // namespace neurosim
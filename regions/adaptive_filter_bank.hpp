@@ -0,0 +1,112 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <Eigen/Dense>
+
+namespace neurosim {
+
+/**
+ * @brief Bank of adaptive FIR filters predicting the next frame of a signal
+ *
+ * Every channel is predicted from the same regressor, the last `taps`
+ * frames of all channels (channels x taps inputs), so the filters are the
+ * rows of one row-major weight matrix and prediction is one matrix-vector
+ * product. Each step:
+ * - The error of the previous prediction against the observed frame drives
+ *   the weight update (NLMS: normalized rank-1 update, O(channels x inputs);
+ *   RLS: shared inverse-correlation matrix, O(inputs^2) but converging in
+ *   about `inputs` steps)
+ * - The frame is pushed into the tap history
+ * - The next frame is predicted
+ *
+ * The history is stored twice over (mirrored ring), so the regressor is
+ * always one contiguous, in-place block and the updates are plain vector
+ * loops Eigen can vectorize. Storage is sized by the first frame; after
+ * that step() does not allocate.
+ */
+class AdaptiveFilterBank {
+public:
+    /**
+     * @brief Weight update rule
+     */
+    enum class Algorithm {
+        NLMS,   ///< Normalized least mean squares
+        RLS     ///< Recursive least squares
+    };
+
+    /**
+     * @brief Filter parameters
+     */
+    struct Config {
+        size_t taps = 16;                   ///< Past frames per prediction
+        Algorithm algorithm = Algorithm::NLMS;
+        double step_size = 0.5;             ///< NLMS step size (0-2)
+        double regularization = 1e-3;       ///< NLMS normalization floor
+        double forgetting_factor = 0.999;   ///< RLS forgetting factor (0-1]
+        double initial_covariance = 100.0;  ///< RLS initial inverse correlation (delta^-1)
+    };
+
+public:
+    AdaptiveFilterBank();
+
+    /**
+     * @brief Constructor
+     * @param config Filter parameters
+     */
+    explicit AdaptiveFilterBank(const Config& config);
+
+    /**
+     * @brief Learn from an observed frame and predict the next one
+     * @param observed Current frame (fixes the channel count on first use)
+     * @return Prediction of the next frame
+     */
+    const Eigen::VectorXd& step(const Eigen::Ref<const Eigen::VectorXd>& observed);
+
+    /**
+     * @brief Forget weights and history (keeps the channel count)
+     */
+    void reset();
+
+    /**
+     * @brief Set the NLMS step size
+     */
+    void setStepSize(double step_size) { config_.step_size = step_size; }
+
+    /**
+     * @brief Prediction of the next frame
+     */
+    const Eigen::VectorXd& prediction() const { return prediction_; }
+
+    /**
+     * @brief Observed minus predicted value of the last frame
+     */
+    const Eigen::VectorXd& error() const { return error_; }
+
+    /**
+     * @brief Filter weights (one row per channel, oldest tap first)
+     */
+    const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>& weights() const {
+        return weights_;
+    }
+
+    Eigen::Index channels() const { return channels_; }
+    Eigen::Index inputs() const { return channels_ * static_cast<Eigen::Index>(config_.taps); }
+    const Config& getConfig() const { return config_; }
+
+private:
+    Config config_;
+    Eigen::Index channels_;
+    std::vector<double> history_;           // 2 x taps frames, each written twice
+    size_t head_;                           // Frame slot written next
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> weights_;
+    Eigen::MatrixXd inverse_correlation_;   // RLS P matrix
+    Eigen::VectorXd gain_;                  // RLS scratch: P x, then the gain vector
+    Eigen::VectorXd prediction_;
+    Eigen::VectorXd error_;
+
+    void resize(Eigen::Index channels);
+    Eigen::Map<const Eigen::VectorXd> regressor() const;
+};
+
+} // namespace neurosim
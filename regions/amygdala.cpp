@@ -1,11 +1,24 @@
 #include "amygdala.hpp"
 #include <algorithm>
+#include <cmath>
 #include <random>
 
 namespace neurosim {
 
+namespace {
+// Root-mean-square coefficient: comparable across scalar drives and long embeddings
+double rmsMagnitude(const Eigen::Ref<const Eigen::VectorXd>& input) {
+    return input.size() > 0 ? input.norm() / std::sqrt(static_cast<double>(input.size())) : 0.0;
+}
+}
+
+Amygdala::Amygdala(const RegionConfig& region_config) : Amygdala(region_config, AmygdalaConfig{}) {
+}
+
 Amygdala::Amygdala(const RegionConfig& region_config, const AmygdalaConfig& amygdala_config)
-    : BrainRegion(region_config), amygdala_config_(amygdala_config) {
+    : BrainRegion(region_config), amygdala_config_(amygdala_config),
+      emotional_memories_(1000), fear_memories_(1000),
+      fear_learning_(amygdala_config.fear_learning) {
     
     // Initialize amygdala-specific state
     amygdala_state_.threat_level = 0.0;
@@ -14,17 +27,37 @@ Amygdala::Amygdala(const RegionConfig& region_config, const AmygdalaConfig& amyg
     amygdala_state_.social_anxiety = 0.0;
     amygdala_state_.habituation_level = 0.0;
     amygdala_state_.sensitization_level = 0.0;
+    amygdala_state_.active_memory_ids.reserve(amygdala_config_.max_active_memories);
+    
+    rebuildTraumaMatrix();
 }
 
 double Amygdala::processInput(double input, double dt) {
+    // Without a fused embedding the scalar drive is its own context (stack storage, no allocation)
+    Eigen::Matrix<double, 1, 1> input_vector;
+    input_vector(0) = input;
+    return processInput(input, input_vector, dt);
+}
+
+double Amygdala::processInput(double input, const Eigen::Ref<const Eigen::VectorXd>& context,
+                              double dt) {
     current_time_ += dt;
     
     // Process input through microcircuit
-    auto microcircuit_state = microcircuit_->process(input, dt);
-    
-    // Calculate threat level from input
-    Eigen::VectorXd input_vector = Eigen::VectorXd::Constant(1, input);
-    amygdala_state_.threat_level = calculateThreatLevel(input_vector);
+    driveMicrocircuit(input, dt);
+    
+    // Calculate threat level from the routed drive; the fused context (unit
+    // norm, so small per coefficient) only feeds the pattern matches below
+    Eigen::Matrix<double, 1, 1> drive;
+    drive(0) = input;
+    amygdala_state_.threat_level = calculateThreatLevel(drive);
+    
+    // Conditioned fear to the current context, only when it lives in the
+    // stimulus space fear was conditioned in (a bare scalar drive is not a CS)
+    if (context.size() == fear_learning_.dimension()) {
+        amygdala_state_.threat_level = std::min(1.0, amygdala_state_.threat_level +
+            std::max(0.0, fear_learning_.predict(context)));
+    }
     
     // Calculate emotional arousal
     amygdala_state_.emotional_arousal = calculateEmotionalArousal(
@@ -46,12 +79,12 @@ double Amygdala::processInput(double input, double dt) {
     
     // Apply autism modifications if enabled
     if (amygdala_config_.autism_social_hypersensitivity) {
-        applyAutismModifications(sensitized_activation, input_vector);
+        applyAutismModifications(sensitized_activation, drive);
     }
     
     // Apply PTSD modifications if enabled
     if (amygdala_config_.ptsd_hypervigilance) {
-        applyPTSDModifications(sensitized_activation, input_vector);
+        applyPTSDModifications(sensitized_activation, context);
     }
     
     // Check for fight-or-flight activation
@@ -61,6 +94,10 @@ double Amygdala::processInput(double input, double dt) {
     amygdala_state_.memory_consolidation_active = 
         amygdala_state_.emotional_arousal > 0.5;
     
+    // Emotional memories reactivated by the current context
+    updateActiveMemories(context);
+    amygdala_state_.detected_threats = identifyThreats(drive);
+    
     // Update current activation
     current_activation_ = std::max(0.0, std::min(1.0, sensitized_activation));
     
@@ -108,33 +145,41 @@ void Amygdala::processMemoryConsolidation(double emotional_valence,
     }
 }
 
-double Amygdala::checkTraumaActivation(const Eigen::VectorXd& input_pattern) {
-    double max_match = 0.0;
+double Amygdala::checkTraumaActivation(const Eigen::Ref<const Eigen::VectorXd>& input_pattern) {
+    if (trauma_matrix_.empty()) return 0.0;
     
-    for (const auto& trauma_template : amygdala_config_.trauma_templates) {
-        double match_strength = calculateMemoryMatch(input_pattern, trauma_template);
-        max_match = std::max(max_match, match_strength);
-        
-        if (match_strength > 0.7) { // Threshold for trauma activation
+    // Share templates added since the last check, then score all with one GEMV
+    trauma_matrix_.sharedPatterns();
+    trauma_matrix_.computeScores(input_pattern, trauma_scores_);
+    
+    const auto thresholds = trauma_matrix_.thresholds();
+    for (Eigen::Index i = 0; i < trauma_scores_.size(); ++i) {
+        double match_strength = trauma_scores_(i);
+        if (match_strength > thresholds(i)) { // Per-template activation threshold
             amygdala_state_.trauma_flashback_triggered = true;
             amygdala_state_.emotional_arousal = std::min(1.0, 
                 amygdala_state_.emotional_arousal + match_strength * 0.5);
         }
     }
     
-    return max_match;
+    return trauma_scores_.size() > 0 ? trauma_scores_.maxCoeff() : 0.0;
 }
 
 void Amygdala::addTraumaTemplate(const Eigen::VectorXd& trauma_pattern, double sensitivity) {
-    amygdala_config_.trauma_templates.push_back(trauma_pattern);
-    // Note: In a full implementation, we'd store sensitivity with each template
+    addTraumaTemplate(TraumaTemplateLibrary::instance().intern(trauma_pattern), sensitivity);
 }
 
-double Amygdala::calculateThreatLevel(const Eigen::VectorXd& input) const {
+void Amygdala::addTraumaTemplate(const TraumaTemplateHandle& trauma_pattern, double sensitivity) {
+    amygdala_config_.trauma_templates.push_back({trauma_pattern, sensitivity});
+    trauma_matrix_.add(trauma_pattern, sensitivity);
+}
+
+double Amygdala::calculateThreatLevel(const Eigen::Ref<const Eigen::VectorXd>& input) const {
     if (input.size() == 0) return 0.0;
     
-    // Simple threat calculation based on input magnitude and characteristics
-    double magnitude = input.norm();
+    // Threat from the RMS magnitude, so a long fused embedding does not
+    // saturate the clamp just by having many dimensions
+    double magnitude = rmsMagnitude(input);
     
     // Apply threat sensitivity
     double threat = magnitude * amygdala_config_.threat_sensitivity;
@@ -180,7 +225,7 @@ double Amygdala::calculateEmotionalArousal(double threat_level, double input_str
     return std::max(0.0, std::min(1.0, arousal));
 }
 
-void Amygdala::applyAutismModifications(double& activation, const Eigen::VectorXd& input) {
+void Amygdala::applyAutismModifications(double& activation, const Eigen::Ref<const Eigen::VectorXd>& input) {
     // Enhanced threat generalization
     activation *= amygdala_config_.autism_threat_generalization;
     
@@ -191,7 +236,7 @@ void Amygdala::applyAutismModifications(double& activation, const Eigen::VectorX
     amygdala_state_.habituation_level *= 0.7;
 }
 
-void Amygdala::applyPTSDModifications(double& activation, const Eigen::VectorXd& input) {
+void Amygdala::applyPTSDModifications(double& activation, const Eigen::Ref<const Eigen::VectorXd>& input) {
     // Enhanced trauma sensitivity
     activation *= amygdala_config_.ptsd_trauma_sensitivity;
     
@@ -205,7 +250,7 @@ void Amygdala::applyPTSDModifications(double& activation, const Eigen::VectorXd&
     amygdala_state_.habituation_level *= 0.5;
 }
 
-double Amygdala::calculateAutismSocialAnxiety(const Eigen::VectorXd& social_context) const {
+double Amygdala::calculateAutismSocialAnxiety(const Eigen::Ref<const Eigen::VectorXd>& social_context) const {
     if (social_context.size() == 0) return 0.0;
     
     // Social anxiety increases with social complexity
@@ -213,40 +258,15 @@ double Amygdala::calculateAutismSocialAnxiety(const Eigen::VectorXd& social_cont
     return std::min(1.0, social_complexity * 1.5); // Enhanced in autism
 }
 
-bool Amygdala::checkMemoryIntrusion(const Eigen::VectorXd& input) const {
+bool Amygdala::checkMemoryIntrusion(const Eigen::Ref<const Eigen::VectorXd>& input) const {
     // Check if current input matches stored trauma patterns
-    for (const auto& trauma_template : amygdala_config_.trauma_templates) {
-        double match = calculateMemoryMatch(input, trauma_template);
-        if (match > 0.6) { // Lower threshold for PTSD intrusion
-            return true;
-        }
-    }
-    return false;
+    return trauma_matrix_.maxScore(input) > 0.6; // Lower threshold for PTSD intrusion
 }
 
 void Amygdala::updateEmotionalMemories(double emotional_valence, 
                                       const Eigen::VectorXd& memory_content) {
-    // Store emotional memory with valence
-    emotional_memories_.emplace_back(memory_content, emotional_valence);
-    
-    // Limit memory storage
-    if (emotional_memories_.size() > 1000) {
-        emotional_memories_.erase(emotional_memories_.begin());
-    }
-}
-
-double Amygdala::calculateMemoryMatch(const Eigen::VectorXd& input, 
-                                     const Eigen::VectorXd& stored_pattern) const {
-    if (input.size() == 0 || stored_pattern.size() == 0) return 0.0;
-    
-    // Calculate cosine similarity
-    double dot_product = input.dot(stored_pattern);
-    double input_norm = input.norm();
-    double pattern_norm = stored_pattern.norm();
-    
-    if (input_norm == 0.0 || pattern_norm == 0.0) return 0.0;
-    
-    return std::max(0.0, dot_product / (input_norm * pattern_norm));
+    // Store emotional memory with valence (oldest is overwritten at capacity)
+    emotional_memories_.push(memory_content, emotional_valence);
 }
 
 void Amygdala::updateHabituation(double input_strength, double dt) {
@@ -283,46 +303,113 @@ double Amygdala::applySensitizationEffect(double base_activation) const {
     return base_activation * (1.0 + amygdala_state_.sensitization_level * 0.3);
 }
 
-std::vector<std::string> Amygdala::identifyThreats(const Eigen::VectorXd& input) const {
-    std::vector<std::string> threats;
+uint32_t Amygdala::identifyThreats(const Eigen::Ref<const Eigen::VectorXd>& input) const {
+    uint32_t threats = 0;
     
     // Simple threat identification based on input characteristics
-    if (input.norm() > 0.7) {
-        threats.push_back("high_intensity_stimulus");
+    if (rmsMagnitude(input) > 0.7) {
+        threats |= HighIntensityStimulus;
     }
     
     if (amygdala_state_.trauma_flashback_triggered) {
-        threats.push_back("trauma_trigger");
+        threats |= TraumaFlashback;
     }
     
     if (amygdala_state_.social_anxiety > 0.6) {
-        threats.push_back("social_threat");
+        threats |= SocialThreat;
     }
     
     return threats;
 }
 
-void Amygdala::updateActiveMemories(const Eigen::VectorXd& input) {
-    amygdala_state_.active_memories.clear();
+std::vector<std::string> Amygdala::getDetectedThreats() const {
+    static const char* const names[] = {"high_intensity_stimulus", "trauma_trigger", "social_threat"};
     
-    // Check which stored memories are activated by current input
-    for (size_t i = 0; i < emotional_memories_.size(); ++i) {
-        double match = calculateMemoryMatch(input, emotional_memories_[i].first);
-        if (match > 0.5) {
-            amygdala_state_.active_memories.push_back("memory_" + std::to_string(i));
+    std::vector<std::string> threats;
+    for (uint32_t bit = 0; bit < 3; ++bit) {
+        if (amygdala_state_.detected_threats & (1u << bit)) {
+            threats.emplace_back(names[bit]);
         }
     }
+    return threats;
+}
+
+void Amygdala::updateActiveMemories(const Eigen::Ref<const Eigen::VectorXd>& input) {
+    amygdala_state_.active_memory_ids.clear();
     
-    // Update detected threats
-    amygdala_state_.detected_threats = identifyThreats(input);
+    // One GEMV over all stored memories, keep the strongest matches
+    emotional_memories_.topK(input, amygdala_config_.max_active_memories, 0.5, memory_hits_);
+    for (const auto& hit : memory_hits_) {
+        amygdala_state_.active_memory_ids.push_back(hit.id);
+    }
 }
 
 void Amygdala::updateConfig(const AmygdalaConfig& config) {
     amygdala_config_ = config;
+    fear_learning_.setParams(config.fear_learning);
+    rebuildTraumaMatrix();
+}
+
+void Amygdala::rebuildTraumaMatrix() {
+    trauma_matrix_.clear();
+    trauma_matrix_.reserve(amygdala_config_.trauma_templates.size());
+    for (const auto& trauma_template : amygdala_config_.trauma_templates) {
+        trauma_matrix_.add(trauma_template.pattern, trauma_template.sensitivity);
+    }
+    trauma_matrix_.sharedPatterns();
+}
+
+void Amygdala::simulateFearConditioning(const Eigen::VectorXd& conditioned_stimulus,
+                                        double unconditioned_stimulus) {
+    updateFearConditioning(conditioned_stimulus, unconditioned_stimulus);
+}
+
+void Amygdala::simulateFearExtinction(const Eigen::VectorXd& extinction_stimulus,
+                                      double extinction_strength) {
+    updateFearExtinction(extinction_stimulus, extinction_strength);
+}
+
+double Amygdala::getConditionedFear(const Eigen::Ref<const Eigen::VectorXd>& stimulus) const {
+    return fear_learning_.predict(stimulus);
+}
+
+void Amygdala::updateFearConditioning(const Eigen::VectorXd& cs, double us_strength) {
+    fear_learning_.trial(cs, us_strength);
+    recordFearMemory(cs);
+}
+
+void Amygdala::updateFearExtinction(const Eigen::VectorXd& extinction_stimulus, double strength) {
+    // Non-reinforced trial at the requested extinction rate
+    fear_learning_.trial(extinction_stimulus, 0.0, strength);
+    recordFearMemory(extinction_stimulus);
+}
+
+void Amygdala::recordFearMemory(const Eigen::VectorXd& cs) {
+    double strength = fear_learning_.predict(cs);
+    
+    // Update the trace for an already-stored CS, otherwise store a new one
+    fear_memories_.topK(cs, 1, 0.99, memory_hits_);
+    if (memory_hits_.empty() || !fear_memories_.setValue(memory_hits_.front().id, strength)) {
+        fear_memories_.push(cs, strength);
+    }
 }
 
 std::vector<std::pair<Eigen::VectorXd, double>> Amygdala::getEmotionalMemories() const {
-    return emotional_memories_;
+    std::vector<std::pair<Eigen::VectorXd, double>> memories;
+    memories.reserve(emotional_memories_.size());
+    emotional_memories_.forEach([&](uint64_t, const Eigen::VectorXd& pattern, double valence) {
+        memories.emplace_back(pattern, valence);
+    });
+    return memories;
+}
+
+std::vector<std::string> Amygdala::getActiveMemoryLabels() const {
+    std::vector<std::string> labels;
+    labels.reserve(amygdala_state_.active_memory_ids.size());
+    for (uint64_t id : amygdala_state_.active_memory_ids) {
+        labels.push_back("memory_" + std::to_string(id));
+    }
+    return labels;
 }
 
 } // namespace neurosim
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "microcircuit.hpp"
+#include "../core/trauma_template_matrix.hpp"
+#include "../core/emotional_memory_matrix.hpp"
+#include "../core/fear_conditioning_engine.hpp"
 #include <Eigen/Dense>
 
 namespace neurosim {
@@ -19,6 +22,23 @@ namespace neurosim {
  */
 class Amygdala : public BrainRegion {
 public:
+    /**
+     * @brief Trauma template with its activation threshold
+     */
+    struct TraumaTrigger {
+        TraumaTemplateHandle pattern;           ///< Shared trauma pattern (library handle)
+        double sensitivity;                     ///< Match strength required for activation
+    };
+
+    /**
+     * @brief Threat categories, combined as a bitmask in AmygdalaState
+     */
+    enum ThreatFlag : uint32_t {
+        HighIntensityStimulus = 1u << 0,        ///< Routed drive above 0.7
+        TraumaFlashback = 1u << 1,              ///< Trauma flashback triggered
+        SocialThreat = 1u << 2                  ///< Social anxiety above 0.6
+    };
+
     /**
      * @brief Amygdala-specific configuration
      */
@@ -27,6 +47,8 @@ public:
         double social_threat_bias = 0.5;        ///< Bias toward social threat detection
         double memory_consolidation_rate = 0.3; ///< Rate of emotional memory formation
         double habituation_rate = 0.1;          ///< Rate of threat habituation
+        size_t max_active_memories = 16;        ///< Top-k emotional memories reported as active
+        FearConditioningEngine::LearningParams fear_learning; ///< Rescorla-Wagner learning rates
         
         // Autism-specific parameters
         bool autism_social_hypersensitivity = false;
@@ -37,7 +59,8 @@ public:
         bool ptsd_hypervigilance = false;
         double ptsd_trauma_sensitivity = 2.0;   ///< Enhanced trauma-related activation
         double ptsd_memory_intrusion_rate = 0.4; ///< Rate of intrusive memory activation
-        std::vector<Eigen::VectorXd> trauma_templates; ///< Stored trauma patterns
+        double ptsd_emotional_dysregulation = 1.3; ///< Heightened arousal to threat
+        std::vector<TraumaTrigger> trauma_templates; ///< Shared trauma patterns and their thresholds
     };
 
     /**
@@ -53,8 +76,8 @@ public:
         bool memory_consolidation_active = false; ///< Emotional memory formation
         bool trauma_flashback_triggered = false; ///< PTSD flashback state
         
-        std::vector<std::string> detected_threats; ///< Currently detected threats
-        std::vector<std::string> active_memories;  ///< Currently active emotional memories
+        uint32_t detected_threats = 0;          ///< ThreatFlag bits of the currently detected threats
+        std::vector<uint64_t> active_memory_ids;   ///< Currently active emotional memories, most similar first
         
         // Temporal dynamics
         double habituation_level = 0.0;         ///< Current habituation to stimuli
@@ -62,12 +85,14 @@ public:
     };
 
 public:
+    explicit Amygdala(const RegionConfig& region_config);
+
     /**
      * @brief Constructor
      * @param region_config Base region configuration
      * @param amygdala_config Amygdala-specific configuration
      */
-    Amygdala(const RegionConfig& region_config, const AmygdalaConfig& amygdala_config = AmygdalaConfig{});
+    Amygdala(const RegionConfig& region_config, const AmygdalaConfig& amygdala_config);
 
     /**
      * @brief Process input with threat detection and emotional processing
@@ -77,6 +102,23 @@ public:
      */
     double processInput(double input, double dt = 1.0) override;
 
+    /**
+     * @brief Process input with the fused embedding as trauma/memory context
+     *
+     * The threat level, detected threats and social anxiety follow the
+     * routed drive. The context is matched against trauma templates,
+     * intrusions and emotional memories, and conditioned fear predicted for
+     * it is added to the threat level when it has the dimension of the
+     * conditioned stimuli.
+     *
+     * @param input Input activation strength
+     * @param context Fused multimodal embedding (referenced, not copied)
+     * @param dt Time step in milliseconds
+     * @return Amygdala activation level
+     */
+    double processInput(double input, const Eigen::Ref<const Eigen::VectorXd>& context,
+                        double dt = 1.0) override;
+
     /**
      * @brief Process multi-modal threat assessment
      * @param visual_input Visual threat cues
@@ -105,7 +147,7 @@ public:
      * @param input_pattern Current input pattern
      * @return Trauma match strength (0-1)
      */
-    double checkTraumaActivation(const Eigen::VectorXd& input_pattern);
+    double checkTraumaActivation(const Eigen::Ref<const Eigen::VectorXd>& input_pattern);
 
     /**
      * @brief Add trauma template for PTSD simulation
@@ -114,6 +156,13 @@ public:
      */
     void addTraumaTemplate(const Eigen::VectorXd& trauma_pattern, double sensitivity = 0.8);
 
+    /**
+     * @brief Add a shared library trauma template for PTSD simulation
+     * @param trauma_pattern Library handle (not copied)
+     * @param sensitivity Sensitivity threshold for activation
+     */
+    void addTraumaTemplate(const TraumaTemplateHandle& trauma_pattern, double sensitivity = 0.8);
+
     /**
      * @brief Get current amygdala state
      * @return Current state
@@ -142,38 +191,64 @@ public:
     void simulateFearExtinction(const Eigen::VectorXd& extinction_stimulus,
                               double extinction_strength = 0.1);
 
+    /**
+     * @brief Conditioned fear predicted for a stimulus
+     * @param stimulus CS pattern
+     * @return Learned CS-US association strength
+     */
+    double getConditionedFear(const Eigen::Ref<const Eigen::VectorXd>& stimulus) const;
+
+    /**
+     * @brief Get the fear learning engine (for batched protocol runs)
+     */
+    const FearConditioningEngine& getFearLearning() const { return fear_learning_; }
+
     /**
      * @brief Get emotional memory traces
      * @return Vector of stored emotional memories
      */
     std::vector<std::pair<Eigen::VectorXd, double>> getEmotionalMemories() const;
 
+    /**
+     * @brief Get names of the currently detected threats
+     * @return e.g. "high_intensity_stimulus", in ThreatFlag bit order
+     */
+    std::vector<std::string> getDetectedThreats() const;
+
+    /**
+     * @brief Get labels of the currently active emotional memories
+     * @return "memory_<id>" for each active memory id, most similar first
+     */
+    std::vector<std::string> getActiveMemoryLabels() const;
+
 private:
     AmygdalaConfig amygdala_config_;
     AmygdalaState amygdala_state_;
     
     // Memory storage
-    std::vector<std::pair<Eigen::VectorXd, double>> emotional_memories_; // (pattern, valence)
-    std::vector<std::pair<Eigen::VectorXd, double>> fear_memories_;      // (CS, strength)
+    EmotionalMemoryMatrix emotional_memories_; // Ring buffer of patterns, value = valence
+    EmotionalMemoryMatrix fear_memories_;      // Ring buffer of CS patterns, value = strength
+    std::vector<EmotionalMemoryMatrix::Hit> memory_hits_; // Top-k lookup scratch buffer
+    FearConditioningEngine fear_learning_;     // Rescorla-Wagner CS weights (single subject)
+    TraumaTemplateMatrix trauma_matrix_;  // Shared matrix over amygdala_config_.trauma_templates
+    Eigen::VectorXd trauma_scores_;       // Per-template match scratch buffer
     
     // Internal processing methods
-    double calculateThreatLevel(const Eigen::VectorXd& input) const;
+    double calculateThreatLevel(const Eigen::Ref<const Eigen::VectorXd>& input) const;
     double calculateSocialThreat(const Eigen::VectorXd& social_context) const;
     double calculateEmotionalArousal(double threat_level, double input_strength) const;
     
     // Autism-specific processing
-    void applyAutismModifications(double& activation, const Eigen::VectorXd& input);
-    double calculateAutismSocialAnxiety(const Eigen::VectorXd& social_context) const;
+    void applyAutismModifications(double& activation, const Eigen::Ref<const Eigen::VectorXd>& input);
+    double calculateAutismSocialAnxiety(const Eigen::Ref<const Eigen::VectorXd>& social_context) const;
     
     // PTSD-specific processing
-    void applyPTSDModifications(double& activation, const Eigen::VectorXd& input);
-    bool checkMemoryIntrusion(const Eigen::VectorXd& input) const;
+    void applyPTSDModifications(double& activation, const Eigen::Ref<const Eigen::VectorXd>& input);
+    bool checkMemoryIntrusion(const Eigen::Ref<const Eigen::VectorXd>& input) const;
     
     // Memory processing
     void updateEmotionalMemories(double emotional_valence, 
                                const Eigen::VectorXd& memory_content);
-    double calculateMemoryMatch(const Eigen::VectorXd& input, 
-                              const Eigen::VectorXd& stored_pattern) const;
     
     // Habituation and sensitization
     void updateHabituation(double input_strength, double dt);
@@ -182,12 +257,14 @@ private:
     // Fear learning
     void updateFearConditioning(const Eigen::VectorXd& cs, double us_strength);
     void updateFearExtinction(const Eigen::VectorXd& extinction_stimulus, double strength);
+    void recordFearMemory(const Eigen::VectorXd& cs);
     
     // Utility methods
     double applyHabituationEffect(double base_activation) const;
     double applySensitizationEffect(double base_activation) const;
-    std::vector<std::string> identifyThreats(const Eigen::VectorXd& input) const;
-    void updateActiveMemories(const Eigen::VectorXd& input);
+    uint32_t identifyThreats(const Eigen::Ref<const Eigen::VectorXd>& input) const;
+    void updateActiveMemories(const Eigen::Ref<const Eigen::VectorXd>& input);
+    void rebuildTraumaMatrix();
 };
 
 } // namespace neurosim
@@ -1,19 +1,58 @@
 #include "cerebellum.hpp"
-
-// Stub implementation for cerebellum
-// Owner: Darrell Mesa (darrell.mesa@pm-ss.org)
+#include <algorithm>
+#include <cmath>
 
 namespace neurosim {
 
+Cerebellum::Cerebellum(const RegionConfig& region_config) : Cerebellum(region_config, CerebellumConfig{}) {
+}
+
 Cerebellum::Cerebellum(const RegionConfig& region_config, 
                       const CerebellumConfig& cerebellum_config)
-    : BrainRegion(region_config), cerebellum_config_(cerebellum_config) {
+    : BrainRegion(region_config), cerebellum_config_(cerebellum_config),
+      forward_model_(forwardModelConfig(cerebellum_config)), surprise_gain_(1.0) {
+    // Autism: more variable coordination; PTSD: enhanced startle to the unexpected
+    if (cerebellum_config_.autism_timing_differences) {
+        surprise_gain_ *= cerebellum_config_.autism_coordination_variability;
+    }
+    if (cerebellum_config_.ptsd_hypervigilance_effects) {
+        surprise_gain_ *= cerebellum_config_.ptsd_startle_enhancement;
+    }
 }
 
 double Cerebellum::processInput(double input, double dt) {
-    // Simple stub implementation
-    current_activation_ = input * 0.3;
+    current_time_ += dt;
+    driveMicrocircuit(input, dt);
+
+    // Coordination demand plus the surprise of the last forward-model step
+    double activation = input * 0.3 + cerebellum_config_.predictive_processing * cerebellum_state_.surprise;
+    current_activation_ = std::max(0.0, std::min(config_.max_activation, activation));
     return current_activation_;
 }
 
+const Eigen::VectorXd& Cerebellum::observeDrives(const Eigen::Ref<const Eigen::VectorXd>& drives) {
+    const Eigen::VectorXd& prediction = forward_model_.step(drives);
+    const Eigen::VectorXd& error = forward_model_.error();
+    cerebellum_state_.prediction_error = error.size() > 0 ? std::sqrt(error.squaredNorm() / error.size()) : 0.0;
+    cerebellum_state_.surprise = cerebellum_state_.prediction_error * surprise_gain_;
+    return prediction;
+}
+
+AdaptiveFilterBank::Config Cerebellum::forwardModelConfig(const CerebellumConfig& config) {
+    AdaptiveFilterBank::Config filter_config;
+    filter_config.taps = config.prediction_taps;
+    filter_config.algorithm = config.recursive_least_squares ? AdaptiveFilterBank::Algorithm::RLS
+                                                             : AdaptiveFilterBank::Algorithm::NLMS;
+
+    // Error correction sets how fast the forward model adapts
+    filter_config.step_size = config.error_correction_rate;
+    if (config.autism_timing_differences) {
+        filter_config.step_size *= config.autism_predictive_deficit;
+    }
+    if (config.ptsd_hypervigilance_effects) {
+        filter_config.step_size *= config.ptsd_coordination_disruption;
+    }
+    return filter_config;
+}
+
 } // namespace neurosim
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "microcircuit.hpp"
+#include "adaptive_filter_bank.hpp"
 #include <Eigen/Dense>
 
 namespace neurosim {
@@ -37,15 +38,29 @@ public:
         bool ptsd_hypervigilance_effects = false;
         double ptsd_startle_enhancement = 1.5;   ///< Enhanced startle responses
         double ptsd_coordination_disruption = 0.8; ///< Disrupted coordination
+        
+        // Forward model
+        size_t prediction_taps = 16;             ///< Past steps of region drives per prediction
+        bool recursive_least_squares = false;    ///< RLS instead of NLMS filters (faster learning, O(taps^2))
+    };
+
+    /**
+     * @brief Cerebellar forward-model state for the last observed step
+     */
+    struct CerebellumState {
+        double prediction_error = 0.0;          ///< RMS error of the predicted region drives
+        double surprise = 0.0;                  ///< Prediction error after startle/variability gain
     };
 
+    explicit Cerebellum(const RegionConfig& region_config);
+
     /**
      * @brief Constructor
      * @param region_config Base region configuration
      * @param cerebellum_config Cerebellum-specific configuration
      */
     Cerebellum(const RegionConfig& region_config, 
-              const CerebellumConfig& cerebellum_config = CerebellumConfig{});
+              const CerebellumConfig& cerebellum_config);
 
     /**
      * @brief Process input with coordination and timing
@@ -55,8 +70,45 @@ public:
      */
     double processInput(double input, double dt = 1.0) override;
 
+    /**
+     * @brief Observe this step's region drives and predict the next step's
+     *
+     * The forward model learns from the error of its previous prediction
+     * (climbing-fiber signal); the resulting surprise adds to the
+     * cerebellum's activation on the following steps.
+     *
+     * @param drives Region drives in a fixed order (e.g. bank slot order)
+     * @return Predicted drives for the next step
+     */
+    const Eigen::VectorXd& observeDrives(const Eigen::Ref<const Eigen::VectorXd>& drives);
+
+    /**
+     * @brief Predicted region drives for the next step
+     */
+    const Eigen::VectorXd& getPredictedDrives() const { return forward_model_.prediction(); }
+
+    /**
+     * @brief Observed minus predicted drives of the last step
+     */
+    const Eigen::VectorXd& getPredictionErrors() const { return forward_model_.error(); }
+
+    /**
+     * @brief Get current cerebellum state
+     */
+    const CerebellumState& getCerebellumState() const { return cerebellum_state_; }
+
+    /**
+     * @brief Get the forward model
+     */
+    const AdaptiveFilterBank& getForwardModel() const { return forward_model_; }
+
 private:
     CerebellumConfig cerebellum_config_;
+    CerebellumState cerebellum_state_;
+    AdaptiveFilterBank forward_model_;
+    double surprise_gain_;
+
+    static AdaptiveFilterBank::Config forwardModelConfig(const CerebellumConfig& config);
 };
 
 } // namespace neurosim
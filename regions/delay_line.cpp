@@ -0,0 +1,216 @@
+#include "delay_line.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace neurosim {
+
+namespace {
+size_t slotsFor(double max_delay_ms, double dt_ms) {
+    return static_cast<size_t>(std::ceil(std::max(0.0, max_delay_ms) / dt_ms - 1e-9)) + 2;
+}
+}
+
+DelayLine::DelayLine() : buffer_(2, 0.0), newest_(0), max_delay_ms_(0.0), dt_ms_(1.0) {
+}
+
+void DelayLine::configure(double max_delay_ms, double dt_ms) {
+    dt_ms = std::max(dt_ms, 1e-9);
+    size_t slots = slotsFor(max_delay_ms, dt_ms);
+    max_delay_ms_ = max_delay_ms;
+    if (slots == buffer_.size() && dt_ms == dt_ms_) {
+        return;
+    }
+
+    // Resample the stored history onto the new spacing, newest last
+    std::vector<double> resampled(slots);
+    for (size_t j = 0; j < slots; ++j) {
+        resampled[slots - 1 - j] = read(static_cast<double>(j) * dt_ms);
+    }
+    buffer_ = std::move(resampled);
+    newest_ = slots - 1;
+    dt_ms_ = dt_ms;
+}
+
+void DelayLine::push(double value) {
+    newest_ = (newest_ + 1) % buffer_.size();
+    buffer_[newest_] = value;
+}
+
+double DelayLine::read(double delay_ms) const {
+    size_t slots = buffer_.size();
+    double lag = std::max(0.0, delay_ms) / dt_ms_;
+    size_t near = static_cast<size_t>(lag);
+    if (near >= slots - 1) {
+        return buffer_[(newest_ + 1) % slots];  // Oldest sample
+    }
+
+    double fraction = lag - static_cast<double>(near);
+    double near_value = buffer_[(newest_ + slots - near) % slots];
+    double far_value = buffer_[(newest_ + slots - near - 1) % slots];
+    return near_value + (far_value - near_value) * fraction;
+}
+
+void DelayLine::fill(double value) {
+    std::fill(buffer_.begin(), buffer_.end(), value);
+}
+
+DelayLineBank::DelayLineBank()
+    : slots_(0), newest_(0), dt_ms_(1.0), channels_(0), stride_(0), lags_stale_(false) {
+}
+
+void DelayLineBank::resize(Eigen::Index channels) {
+    channels = std::max<Eigen::Index>(0, channels);
+    if (channels == channels_) {
+        return;
+    }
+
+    if (channels > stride_) {
+        relayout(std::max(channels, 2 * stride_));
+    }
+    if (slots_ == 0) {
+        resample(2, dt_ms_);
+    }
+
+    // Channels entering or leaving use start with zero delay and history
+    Eigen::Index low = std::min(channels, channels_);
+    Eigen::Index high = std::max(channels, channels_);
+    delays_.segment(low, high - low).setZero();
+    for (size_t slot = 0; slot < slots_; ++slot) {
+        buffer_.segment(static_cast<Eigen::Index>(slot) * stride_ + low, high - low).setZero();
+    }
+    channels_ = channels;
+    lags_stale_ = true;
+}
+
+void DelayLineBank::reserve(Eigen::Index channels) {
+    if (channels > stride_) {
+        relayout(channels);
+    }
+}
+
+void DelayLineBank::configure(double dt_ms) {
+    dt_ms = std::max(dt_ms, 1e-9);
+    double max_delay = channels_ > 0 ? delays_.head(channels_).maxCoeff() : 0.0;
+    size_t slots = slotsFor(max_delay, dt_ms);
+    if (slots != slots_ || dt_ms != dt_ms_) {
+        resample(slots, dt_ms);
+        lags_stale_ = true;
+    }
+}
+
+void DelayLineBank::setDelay(Eigen::Index channel, double delay_ms) {
+    if (channel < 0 || channel >= channels_) {
+        return;
+    }
+
+    delays_(channel) = std::max(0.0, delay_ms);
+    size_t slots = slotsFor(delays_(channel), dt_ms_);
+    if (slots > slots_) {
+        resample(slots, dt_ms_);
+    }
+    lags_stale_ = true;
+}
+
+void DelayLineBank::push(const Eigen::Ref<const Array>& values) {
+    if (slots_ == 0 || channels_ == 0) {
+        return;
+    }
+
+    newest_ = (newest_ + 1) % slots_;
+    buffer_.segment(static_cast<Eigen::Index>(newest_) * stride_, channels_) = values.head(channels_);
+}
+
+void DelayLineBank::read(Eigen::Ref<Array> out) const {
+    Eigen::Index channels = channels_;
+    if (slots_ == 0 || channels == 0) {
+        return;
+    }
+    if (lags_stale_) {
+        updateLags();
+    }
+
+    // Ring rows of the two samples around each channel's delay, as flat indices
+    int slots = static_cast<int>(slots_);
+    near_index_ = static_cast<int>(newest_) - lags_.head(channels);
+    near_index_ = (near_index_ < 0).select(near_index_ + slots, near_index_);
+    far_index_ = near_index_ - 1;
+    far_index_ = (far_index_ < 0).select(far_index_ + slots, far_index_);
+    near_index_ = near_index_ * static_cast<int>(stride_) + channel_ids_.head(channels);
+    far_index_ = far_index_ * static_cast<int>(stride_) + channel_ids_.head(channels);
+
+    out.head(channels) = buffer_(near_index_) * (1.0 - fractions_.head(channels)) +
+                         buffer_(far_index_) * fractions_.head(channels);
+}
+
+void DelayLineBank::fill(Eigen::Index channel, double value) {
+    if (channel < 0 || channel >= channels_) {
+        return;
+    }
+    for (size_t slot = 0; slot < slots_; ++slot) {
+        buffer_(static_cast<Eigen::Index>(slot) * stride_ + channel) = value;
+    }
+}
+
+double DelayLineBank::sample(Eigen::Index channel, size_t age) const {
+    if (channel < 0 || channel >= channels_ || slots_ == 0) {
+        return 0.0;
+    }
+    size_t slot = (newest_ + slots_ - std::min(age, slots_ - 1)) % slots_;
+    return buffer_(static_cast<Eigen::Index>(slot) * stride_ + channel);
+}
+
+void DelayLineBank::setSample(Eigen::Index channel, size_t age, double value) {
+    if (channel < 0 || channel >= channels_ || age >= slots_) {
+        return;
+    }
+    size_t slot = (newest_ + slots_ - age) % slots_;
+    buffer_(static_cast<Eigen::Index>(slot) * stride_ + channel) = value;
+}
+
+void DelayLineBank::relayout(Eigen::Index stride) {
+    // Copy the channels in use into slots with room for stride channels
+    Array resized = Array::Zero(static_cast<Eigen::Index>(slots_) * stride);
+    for (size_t slot = 0; slot < slots_; ++slot) {
+        resized.segment(static_cast<Eigen::Index>(slot) * stride, channels_) =
+            buffer_.segment(static_cast<Eigen::Index>(slot) * stride_, channels_);
+    }
+    buffer_ = std::move(resized);
+
+    delays_.conservativeResize(stride);
+    delays_.tail(stride - stride_).setZero();
+    channel_ids_ = Eigen::ArrayXi::LinSpaced(stride, 0, static_cast<int>(stride) - 1);
+    stride_ = stride;
+    lags_stale_ = true;
+}
+
+void DelayLineBank::resample(size_t slots, double dt_ms) {
+    Array resampled = Array::Zero(static_cast<Eigen::Index>(slots) * stride_);
+
+    // Same lag for every channel, so each new slot blends two old slots
+    for (size_t j = 0; slots_ > 0 && j < slots; ++j) {
+        double lag = static_cast<double>(j) * dt_ms / dt_ms_;
+        size_t near = std::min(static_cast<size_t>(lag), slots_ - 1);
+        size_t far = std::min(near + 1, slots_ - 1);
+        double fraction = near + 1 < slots_ ? lag - static_cast<double>(near) : 0.0;
+        auto old_slot = [&](size_t age) {
+            size_t slot = (newest_ + slots_ - age) % slots_;
+            return buffer_.segment(static_cast<Eigen::Index>(slot) * stride_, channels_);
+        };
+        resampled.segment(static_cast<Eigen::Index>(slots - 1 - j) * stride_, channels_) =
+            old_slot(near) * (1.0 - fraction) + old_slot(far) * fraction;
+    }
+
+    buffer_ = std::move(resampled);
+    slots_ = slots;
+    newest_ = slots - 1;
+    dt_ms_ = dt_ms;
+}
+
+void DelayLineBank::updateLags() const {
+    Array lag = delays_ / dt_ms_;
+    lags_ = lag.floor().cast<int>();
+    fractions_ = lag - lag.floor();
+    lags_stale_ = false;
+}
+
+} // namespace neurosim
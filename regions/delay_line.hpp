@@ -0,0 +1,146 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <Eigen/Dense>
+
+namespace neurosim {
+
+/**
+ * @brief Ring-buffer delay line with interpolated reads
+ *
+ * Holds one sample per time step, enough to cover the longest delay
+ * (capacity = ceil(max_delay / dt) + 2). read(d) returns the signal d
+ * milliseconds before the newest sample, linearly interpolated between
+ * the two neighbouring samples, so delays need not be multiples of dt.
+ * Reads older than the stored history return the oldest sample. When the
+ * time step changes the stored history is resampled to the new spacing.
+ */
+class DelayLine {
+public:
+    DelayLine();
+
+    /**
+     * @brief Size the buffer for a maximum delay and time step
+     * @param max_delay_ms Longest delay that will be read
+     * @param dt_ms Time between pushes
+     */
+    void configure(double max_delay_ms, double dt_ms);
+
+    /**
+     * @brief Append the newest sample (overwrites the oldest)
+     */
+    void push(double value);
+
+    /**
+     * @brief Signal value delay_ms before the newest sample
+     */
+    double read(double delay_ms) const;
+
+    /**
+     * @brief Set the whole history to a constant (e.g. the initial state)
+     */
+    void fill(double value);
+
+    size_t capacity() const { return buffer_.size(); }
+    double maxDelay() const { return max_delay_ms_; }
+    double timeStep() const { return dt_ms_; }
+
+private:
+    std::vector<double> buffer_;
+    size_t newest_;
+    double max_delay_ms_;
+    double dt_ms_;
+};
+
+/**
+ * @brief Delay lines of many channels in one structure-of-arrays buffer
+ *
+ * Slot t of the ring stores all channels contiguously, so push() is one
+ * vector copy. Every channel has its own delay; the integer lag and
+ * interpolation fraction are precomputed, and read() gathers the two
+ * neighbouring samples of all channels with index arrays and blends them
+ * in one array expression.
+ *
+ * Slots are laid out with room for capacity() channels, which grows
+ * geometrically (or once, with reserve()), so adding channels one at a
+ * time does not re-lay out the ring each time. Lags are recomputed once,
+ * on the first push or read after delays change.
+ */
+class DelayLineBank {
+public:
+    using Array = Eigen::ArrayXd;
+
+    DelayLineBank();
+
+    /**
+     * @brief Set the number of channels (new channels have zero delay and history)
+     */
+    void resize(Eigen::Index channels);
+
+    /**
+     * @brief Make room for a number of channels without re-laying out the ring later
+     */
+    void reserve(Eigen::Index channels);
+
+    /**
+     * @brief Size the ring for the longest channel delay and a time step
+     */
+    void configure(double dt_ms);
+
+    /**
+     * @brief Set a channel's delay (grows the ring if needed)
+     */
+    void setDelay(Eigen::Index channel, double delay_ms);
+
+    /**
+     * @brief Append the newest sample of every channel
+     */
+    void push(const Eigen::Ref<const Array>& values);
+
+    /**
+     * @brief Read every channel at its own delay
+     */
+    void read(Eigen::Ref<Array> out) const;
+
+    /**
+     * @brief Set the whole history of one channel to a constant
+     */
+    void fill(Eigen::Index channel, double value);
+
+    /**
+     * @brief Sample of one channel age steps before the newest (older ages give the oldest)
+     */
+    double sample(Eigen::Index channel, size_t age) const;
+
+    /**
+     * @brief Overwrite the sample of one channel age steps before the newest
+     */
+    void setSample(Eigen::Index channel, size_t age, double value);
+
+    Eigen::Index channels() const { return channels_; }
+    Eigen::Index channelCapacity() const { return stride_; }
+    size_t capacity() const { return slots_; }
+    double timeStep() const { return dt_ms_; }
+
+private:
+    Array buffer_;              // slots_ x stride_, slot-major
+    size_t slots_;
+    size_t newest_;
+    double dt_ms_;
+    Eigen::Index channels_;     // Channels in use
+    Eigen::Index stride_;       // Channels per slot in buffer_ (capacity)
+    Array delays_;              // Per-channel delay (ms), stride_ entries
+    mutable Eigen::ArrayXi lags_;       // floor(delay / dt)
+    mutable Array fractions_;           // delay / dt - lag
+    mutable bool lags_stale_;           // Delays or dt changed since the last update
+    Eigen::ArrayXi channel_ids_; // 0 .. stride_ - 1
+    mutable Eigen::ArrayXi near_index_;
+    mutable Eigen::ArrayXi far_index_;
+
+    void relayout(Eigen::Index stride);
+    void resample(size_t slots, double dt_ms);
+    void updateLags() const;
+};
+
+} // namespace neurosim
@@ -1,19 +1,112 @@
 #include "hippocampus.hpp"
-
-// Stub implementation for hippocampus
-// Owner: Darrell Mesa (darrell.mesa@pm-ss.org)
+#include <algorithm>
+#include <cmath>
 
 namespace neurosim {
 
+namespace {
+// Active fraction of the code at zero separation; full separation keeps a tenth of it
+constexpr double MAX_CODE_SPARSITY = 0.05;
+}
+
+Hippocampus::Hippocampus(const RegionConfig& region_config) : Hippocampus(region_config, HippocampusConfig{}) {
+}
+
 Hippocampus::Hippocampus(const RegionConfig& region_config, 
                         const HippocampusConfig& hippocampus_config)
-    : BrainRegion(region_config), hippocampus_config_(hippocampus_config) {
+    : BrainRegion(region_config), hippocampus_config_(hippocampus_config),
+      memory_(memoryConfig(hippocampus_config)) {
+    // Autism: sharper separation and more rigid completion
+    double separation = hippocampus_config_.pattern_separation_strength;
+    double completion = hippocampus_config_.pattern_completion_strength;
+    context_binding_ = hippocampus_config_.context_binding_strength;
+    if (hippocampus_config_.autism_detail_enhancement) {
+        separation = std::min(1.0, separation * hippocampus_config_.autism_pattern_rigidity);
+        completion /= hippocampus_config_.autism_pattern_rigidity;
+        context_binding_ *= hippocampus_config_.autism_context_reduction;
+    }
+
+    separation_bits_ = std::max<size_t>(1, static_cast<size_t>(std::lround(
+        memory_.codeBits() * MAX_CODE_SPARSITY * (1.0 - 0.9 * std::max(0.0, std::min(1.0, separation))))));
+    completion_threshold_ = std::max(0.0, std::min(1.0, 1.0 - completion));
+
+    // PTSD: episodes are stored as fragments, and intrusive recall needs less overlap
+    stored_bits_ = separation_bits_;
+    if (hippocampus_config_.ptsd_fragmentation) {
+        stored_bits_ = std::max<size_t>(1, static_cast<size_t>(std::lround(
+            separation_bits_ * (1.0 - hippocampus_config_.ptsd_context_deficit))));
+        completion_threshold_ *= 1.0 - hippocampus_config_.ptsd_memory_intrusion;
+        context_binding_ *= 1.0 - hippocampus_config_.ptsd_context_deficit;
+    }
 }
 
 double Hippocampus::processInput(double input, double dt) {
-    // Simple stub implementation
-    current_activation_ = input * 0.5;
+    // Without a fused embedding there is no episode to separate or complete
+    current_time_ += dt;
+    driveMicrocircuit(input, dt);
+
+    hippocampus_state_ = HippocampusState{};
+    current_activation_ = std::max(0.0, std::min(config_.max_activation, input * 0.5));
+    return current_activation_;
+}
+
+double Hippocampus::processInput(double input, const Eigen::Ref<const Eigen::VectorXd>& context,
+                                 double dt) {
+    current_time_ += dt;
+    driveMicrocircuit(input, dt);
+
+    hippocampus_state_ = HippocampusState{};
+    double activation = input * 0.5;
+
+    // Pattern separation: sparse code of the current episode
+    memory_.encode(context, code_, separation_bits_);
+
+    // Pattern completion: reinstate the closest stored episode
+    SparsePatternMemory::Hit hit;
+    if (memory_.recall(code_, hit)) {
+        hippocampus_state_.recalled_episode = hit.id;
+        hippocampus_state_.recall_similarity = hit.similarity;
+        hippocampus_state_.novelty = 1.0 - hit.similarity;
+        if (hit.similarity >= completion_threshold_ && hit.overlap > 0) {
+            hippocampus_state_.pattern_completed = true;
+            activation += 0.5 * hit.similarity * hippocampus_config_.pattern_completion_strength *
+                          context_binding_ * hit.value;
+        }
+    }
+
+    // Encoding: strong, unfamiliar input becomes a new episode
+    if (!hippocampus_state_.pattern_completed && input >= config_.activation_threshold &&
+        SparsePatternMemory::activeBits(code_) > 0) {
+        if (stored_bits_ != separation_bits_) {
+            // The strongest winners of a code are a subset of it, so a fragment is a shorter encode
+            memory_.encode(context, code_, stored_bits_);
+        }
+        memory_.store(code_, input);
+        hippocampus_state_.episode_encoded = true;
+        activation = input * (0.5 + 0.5 * hippocampus_config_.memory_formation_rate *
+                              hippocampus_state_.novelty);
+    }
+
+    current_activation_ = std::max(0.0, std::min(config_.max_activation, activation));
     return current_activation_;
 }
 
+uint64_t Hippocampus::storeEpisode(const Eigen::Ref<const Eigen::VectorXd>& episode, double salience) {
+    memory_.encode(episode, code_, stored_bits_);
+    return memory_.store(code_, salience);
+}
+
+bool Hippocampus::recallEpisode(const Eigen::Ref<const Eigen::VectorXd>& cue, SparsePatternMemory::Hit& hit) {
+    memory_.encode(cue, code_, separation_bits_);
+    return memory_.recall(code_, hit);
+}
+
+SparsePatternMemory::Config Hippocampus::memoryConfig(const HippocampusConfig& config) {
+    SparsePatternMemory::Config memory_config;
+    memory_config.code_bits = config.code_bits;
+    memory_config.capacity = config.episode_capacity;
+    memory_config.seed = config.code_seed;
+    return memory_config;
+}
+
 } // namespace neurosim
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "microcircuit.hpp"
+#include "../core/sparse_pattern_memory.hpp"
 #include <Eigen/Dense>
 
 namespace neurosim {
@@ -37,15 +38,33 @@ public:
         bool ptsd_fragmentation = false;
         double ptsd_context_deficit = 0.5;       ///< Impaired context processing
         double ptsd_memory_intrusion = 0.3;      ///< Intrusive memory formation
+
+        // Episodic store
+        size_t code_bits = 2048;                 ///< Sparse code width
+        size_t episode_capacity = 100000;        ///< Episodes kept (oldest overwritten)
+        uint64_t code_seed = 1;                  ///< Projection seed
     };
 
+    /**
+     * @brief Hippocampus memory state for the last step
+     */
+    struct HippocampusState {
+        bool pattern_completed = false;          ///< Input recalled a stored episode
+        bool episode_encoded = false;            ///< Input was stored as a new episode
+        uint64_t recalled_episode = 0;           ///< Id of the best-matching episode (0 = none)
+        double recall_similarity = 0.0;          ///< Overlap of the best match (0-1)
+        double novelty = 1.0;                    ///< 1 - recall_similarity
+    };
+
+    explicit Hippocampus(const RegionConfig& region_config);
+
     /**
      * @brief Constructor
      * @param region_config Base region configuration
      * @param hippocampus_config Hippocampus-specific configuration
      */
     Hippocampus(const RegionConfig& region_config, 
-               const HippocampusConfig& hippocampus_config = HippocampusConfig{});
+               const HippocampusConfig& hippocampus_config);
 
     /**
      * @brief Process input with memory formation and retrieval
@@ -55,8 +74,59 @@ public:
      */
     double processInput(double input, double dt = 1.0) override;
 
+    /**
+     * @brief Process input with the fused embedding as the episode
+     *
+     * The embedding is separated into a sparse code and matched against
+     * stored episodes. A close enough match completes the pattern and
+     * reinstates the stored episode; otherwise a sufficiently strong input
+     * is encoded as a new episode.
+     *
+     * @param input Input activation strength
+     * @param context Fused multimodal embedding (referenced, not copied)
+     * @param dt Time step in milliseconds
+     * @return Hippocampus activation level
+     */
+    double processInput(double input, const Eigen::Ref<const Eigen::VectorXd>& context,
+                        double dt = 1.0) override;
+
+    /**
+     * @brief Store an episode directly
+     * @param episode Episode pattern
+     * @param salience Value stored with the episode
+     * @return Episode id
+     */
+    uint64_t storeEpisode(const Eigen::Ref<const Eigen::VectorXd>& episode, double salience = 1.0);
+
+    /**
+     * @brief Recall the stored episode closest to a (partial or noisy) cue
+     * @param cue Cue pattern
+     * @param hit Output best match
+     * @return False if nothing is stored or the cue is empty
+     */
+    bool recallEpisode(const Eigen::Ref<const Eigen::VectorXd>& cue, SparsePatternMemory::Hit& hit);
+
+    /**
+     * @brief Get current hippocampus state
+     */
+    const HippocampusState& getHippocampusState() const { return hippocampus_state_; }
+
+    /**
+     * @brief Get the episodic store
+     */
+    const SparsePatternMemory& getMemory() const { return memory_; }
+
 private:
     HippocampusConfig hippocampus_config_;
+    HippocampusState hippocampus_state_;
+    SparsePatternMemory memory_;
+    SparsePatternMemory::Code code_;     // Scratch code of the current input
+    size_t separation_bits_;             // Active bits per code
+    size_t stored_bits_;                 // Active bits kept when storing (fragmentation)
+    double completion_threshold_;        // Similarity needed to complete a pattern
+    double context_binding_;             // Effective contextual association strength
+
+    static SparsePatternMemory::Config memoryConfig(const HippocampusConfig& config);
 };
 
 } // namespace neurosim
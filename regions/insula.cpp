@@ -5,6 +5,9 @@
 
 namespace neurosim {
 
+Insula::Insula(const RegionConfig& region_config) : Insula(region_config, InsulaConfig{}) {
+}
+
 Insula::Insula(const RegionConfig& region_config, 
               const InsulaConfig& insula_config)
     : BrainRegion(region_config), insula_config_(insula_config) {
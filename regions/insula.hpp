@@ -39,13 +39,15 @@ public:
         double ptsd_emotional_dysregulation = 1.3; ///< Emotional processing difficulties
     };
 
+    explicit Insula(const RegionConfig& region_config);
+
     /**
      * @brief Constructor
      * @param region_config Base region configuration
      * @param insula_config Insula-specific configuration
      */
     Insula(const RegionConfig& region_config, 
-          const InsulaConfig& insula_config = InsulaConfig{});
+          const InsulaConfig& insula_config);
 
     /**
      * @brief Process input with interoceptive and emotional processing
@@ -1,12 +1,91 @@
 #include "microcircuit.hpp"
+#include "microcircuit_bank.hpp"
 #include <algorithm>
 #include <random>
 #include <cmath>
+#include <array>
 
 namespace neurosim {
 
+namespace {
+using DynamicsVector = MicroCircuit::DynamicsVector;
+using DynamicsMatrix = MicroCircuit::DynamicsMatrix;
+constexpr double TWO_PI = 6.283185307179586476925286766559;
+
+// Bounds of the state between steps (the autism/PTSD gains act after the
+// excitation bound, so excitation has no upper one)
+DynamicsVector clampDynamics(DynamicsVector state) {
+    state(0) = std::max(0.0, state(0));
+    state(1) = std::max(0.0, std::min(3.0, state(1)));
+    state(2) = std::max(0.1, std::min(2.0, state(2)));
+    state(3) = std::max(0.1, std::min(2.0, state(3)));
+    return state;
+}
+
+// power = A^n and sum = I + A + ... + A^(n-1), by binary doubling
+void matrixPowerSum(const DynamicsMatrix& a, size_t n, DynamicsMatrix& power, DynamicsMatrix& sum) {
+    power.setIdentity();
+    sum.setZero();
+    DynamicsMatrix base = a;                               // A^(2^i)
+    DynamicsMatrix base_sum = DynamicsMatrix::Identity();  // I + ... + A^(2^i - 1)
+    for (; n > 0; n >>= 1) {
+        if (n & 1) {
+            sum += power * base_sum;
+            power = power * base;
+        }
+        base_sum += base * base_sum;
+        base = base * base;
+    }
+}
+
+// sum_{k<n} A^k Q A^kT, by binary doubling
+DynamicsMatrix noiseCovariance(const DynamicsMatrix& a, const DynamicsMatrix& q, size_t n) {
+    DynamicsMatrix power = DynamicsMatrix::Identity();
+    DynamicsMatrix covariance = DynamicsMatrix::Zero();
+    DynamicsMatrix base = a;
+    DynamicsMatrix base_covariance = q;
+    for (; n > 0; n >>= 1) {
+        if (n & 1) {
+            covariance += power * base_covariance * power.transpose();
+            power = power * base;
+        }
+        base_covariance += base * base_covariance * base.transpose();
+        base = base * base;
+    }
+    return covariance;
+}
+
+uint64_t noiseSeed(uint64_t seed) {
+    if (seed != 0) {
+        return seed;
+    }
+    std::random_device rd;
+    return (static_cast<uint64_t>(rd()) << 32) | rd();
+}
+
+// FNV-1a, stable across platforms unlike std::hash
+uint64_t nameStream(const std::string& name) {
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : name) {
+        hash = (hash ^ c) * 1099511628211ull;
+    }
+    return hash;
+}
+}
+
+MicroCircuit::MicroCircuit() : MicroCircuit(CircuitConfig{}) {
+}
+
 MicroCircuit::MicroCircuit(const CircuitConfig& config) 
-    : config_(config), current_time_(0.0), flashback_start_time_(0.0) {
+    : config_(config), net_history_(MAX_HISTORY_SIZE, 0.0), history_head_(0), history_count_(0),
+      record_head_(0), record_count_(0), noise_generator_(noiseSeed(config.noise_seed), config.noise_stream),
+      current_time_(0.0), rk45_step_(1.0),
+      modulations_(MODULATION_CHANNELS), step_mode_(StepMode::Stochastic),
+      linearized_excitation_(0.0), held_excitation_(0.0) {
+    
+    if (config_.record_history) {
+        step_records_.resize(MAX_HISTORY_SIZE);
+    }
     
     // Initialize baseline state
     current_state_.excitatory_activity = config_.baseline_excitation;
@@ -23,19 +102,49 @@ MicroCircuit::MicroCircuit(const CircuitConfig& config)
     if (config_.ptsd_mode) {
         enablePTSDMode();
     }
+    
+    excitatory_delay_.configure(inhibitionDelay(), 1.0);
+    excitatory_delay_.fill(current_state_.excitatory_activity);
 }
 
-MicroCircuit::ActivationState MicroCircuit::process(double input_strength, double dt) {
+const MicroCircuit::ActivationState& MicroCircuit::process(double input_strength, double dt) {
+    // Modulations active at the start of the step
+    modulations_.advance(current_time_);
+    updateNeuromodulatorLevels();
+    double drive = input_strength * (1.0 + getModulation(ModulationType::Neuromodulatory)) +
+                   getModulation(ModulationType::Excitatory);
+    
     current_time_ += dt;
+    excitatory_delay_.configure(inhibitionDelay(), dt);
+    advanceDynamics(drive, dt);
     
-    // Update excitatory activity
-    updateExcitatoryActivity(input_strength, dt);
+    // Detect oscillations and pathological patterns
+    detectOscillations(dt);
+    current_state_.hyperexcitable = detectHyperexcitability();
+    current_state_.inhibition_failure = detectInhibitionFailure();
+    pathology_detector_.push(current_state_.excitatory_activity, current_state_.inhibitory_activity, dt);
     
-    // Update inhibitory activity (with potential delay)
-    updateInhibitoryActivity(dt);
+    // Update activation history
+    updateActivationHistory();
     
-    // Update neurotransmitter levels
-    updateNeurotransmitters(dt);
+    return current_state_;
+}
+
+void MicroCircuit::advanceDynamics(double drive, double dt) {
+    if (config_.integrator == IntegrationMethod::AdaptiveRK45) {
+        // Excitation, inhibition, neurotransmitters and adaptation as one coupled system
+        integrateAdaptive(drive, dt);
+    } else {
+        // Update excitatory activity
+        updateExcitatoryActivity(drive, dt);
+        pushExcitation();
+        
+        // Update inhibitory activity (with potential delay)
+        updateInhibitoryActivity(dt);
+        
+        // Update neurotransmitter levels
+        updateNeurotransmitters(dt);
+    }
     
     // Calculate net activation
     current_state_.net_activation = current_state_.excitatory_activity - current_state_.inhibitory_activity;
@@ -51,23 +160,13 @@ MicroCircuit::ActivationState MicroCircuit::process(double input_strength, doubl
     
     // Apply autism-specific modifications
     if (config_.autism_mode) {
-        applyAutismModifications();
+        applyAutismModifications(dt);
     }
     
     // Apply PTSD-specific modifications
     if (config_.ptsd_mode) {
-        applyPTSDModifications();
+        applyPTSDModifications(dt);
     }
-    
-    // Detect oscillations and pathological patterns
-    detectOscillations();
-    current_state_.hyperexcitable = detectHyperexcitability();
-    current_state_.inhibition_failure = detectInhibitionFailure();
-    
-    // Update activation history
-    updateActivationHistory();
-    
-    return current_state_;
 }
 
 void MicroCircuit::updateExcitatoryActivity(double input_strength, double dt) {
@@ -80,8 +179,16 @@ void MicroCircuit::updateExcitatoryActivity(double input_strength, double dt) {
     
     // Exponential approach to target
     double tau_excitation = 10.0; // ms
-    current_state_.excitatory_activity += 
-        (target_excitation - current_state_.excitatory_activity) * dt / tau_excitation;
+    if (config_.integrator == IntegrationMethod::Exponential) {
+        // Relaxation, adaptation decay and the mode gains combined into one exact exponential
+        double rate = 1.0 / tau_excitation + adaptationDecayRate(current_state_.adaptation_level) -
+                      excitationGainRate();
+        current_state_.excitatory_activity = exponentialUpdate(
+            current_state_.excitatory_activity, target_excitation / tau_excitation, rate, dt);
+    } else {
+        current_state_.excitatory_activity += 
+            (target_excitation - current_state_.excitatory_activity) * relaxationFactor(dt, tau_excitation);
+    }
     
     // Apply bounds
     current_state_.excitatory_activity = std::max(0.0, 
@@ -89,24 +196,28 @@ void MicroCircuit::updateExcitatoryActivity(double input_strength, double dt) {
 }
 
 void MicroCircuit::updateInhibitoryActivity(double dt) {
-    // Inhibitory activity follows excitatory with delay
-    double target_inhibition = current_state_.excitatory_activity * 
-                              current_state_.neurotransmitters.gaba_level;
-    
-    // Apply inhibition delay (increased in PTSD)
-    double effective_delay = config_.inhibition_delay_ms;
-    if (config_.ptsd_mode) {
-        effective_delay = config_.ptsd_inhibition_delay;
-    }
-    
-    // Simple delay model: slower response to excitation
-    double tau_inhibition = 20.0 + effective_delay; // ms
-    current_state_.inhibitory_activity += 
-        (target_inhibition - current_state_.inhibitory_activity) * dt / tau_inhibition;
+    // Inhibitory activity follows excitation as it was one delay ago
+    double delayed_excitation = step_mode_ == StepMode::Linearized ? current_state_.excitatory_activity :
+                                step_mode_ == StepMode::Held ? held_excitation_ :
+                                excitatory_delay_.read(inhibitionDelay());
+    double target_inhibition = delayed_excitation * 
+                              current_state_.neurotransmitters.gaba_level +
+                              getModulation(ModulationType::Inhibitory);
     
-    // Apply autism inhibition deficit
-    if (config_.autism_mode) {
-        current_state_.inhibitory_activity *= config_.autism_inhibition_deficit;
+    if (config_.integrator == IntegrationMethod::Exponential) {
+        // The autism deficit is a decay rate folded into the relaxation
+        double tau_inhibition = inhibitionTau();
+        current_state_.inhibitory_activity = exponentialUpdate(
+            current_state_.inhibitory_activity, target_inhibition / tau_inhibition,
+            1.0 / tau_inhibition - inhibitionGainRate(), dt);
+    } else {
+        current_state_.inhibitory_activity += 
+            (target_inhibition - current_state_.inhibitory_activity) * relaxationFactor(dt, inhibitionTau());
+        
+        // Apply autism inhibition deficit
+        if (config_.autism_mode) {
+            current_state_.inhibitory_activity *= stepGain(config_.autism_inhibition_deficit, dt);
+        }
     }
     
     // Apply bounds
@@ -119,14 +230,15 @@ void MicroCircuit::updateNeurotransmitters(double dt) {
     double tau_nt = 100.0; // ms
     
     // Glutamate increases with excitatory activity
+    double nt_factor = relaxationFactor(dt, tau_nt);
     double target_glutamate = 1.0 + current_state_.excitatory_activity * 0.2;
     current_state_.neurotransmitters.glutamate_level += 
-        (target_glutamate - current_state_.neurotransmitters.glutamate_level) * dt / tau_nt;
+        (target_glutamate - current_state_.neurotransmitters.glutamate_level) * nt_factor;
     
     // GABA increases with inhibitory activity
     double target_gaba = 1.0 + current_state_.inhibitory_activity * 0.15;
     current_state_.neurotransmitters.gaba_level += 
-        (target_gaba - current_state_.neurotransmitters.gaba_level) * dt / tau_nt;
+        (target_gaba - current_state_.neurotransmitters.gaba_level) * nt_factor;
     
     // Apply bounds
     current_state_.neurotransmitters.glutamate_level = 
@@ -136,100 +248,746 @@ void MicroCircuit::updateNeurotransmitters(double dt) {
 }
 
 void MicroCircuit::applyAdaptation(double dt) {
-    // Neural adaptation reduces response over time
-    double adaptation_target = current_state_.firing_rate * 0.1;
-    double tau_adaptation = 500.0; // ms
-    
-    current_state_.adaptation_level += 
-        (adaptation_target - current_state_.adaptation_level) * dt / tau_adaptation;
+    // Neural adaptation reduces response over time (already integrated by RK45)
+    if (config_.integrator != IntegrationMethod::AdaptiveRK45) {
+        double adaptation_target = current_state_.firing_rate * 0.1;
+        double tau_adaptation = 500.0; // ms
+        
+        current_state_.adaptation_level += 
+            (adaptation_target - current_state_.adaptation_level) * relaxationFactor(dt, tau_adaptation);
+    }
     
-    // Apply adaptation to excitatory activity
-    current_state_.excitatory_activity *= (1.0 - current_state_.adaptation_level * config_.adaptation_rate);
+    // Apply adaptation to excitatory activity as a per-ms retention (the other
+    // integrators fold the same rate into dE/dt)
+    if (config_.integrator == IntegrationMethod::Euler) {
+        current_state_.excitatory_activity *= stepGain(
+            1.0 - current_state_.adaptation_level * config_.adaptation_rate, dt);
+    }
 }
 
-void MicroCircuit::addNoise(double dt) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::normal_distribution<> noise_dist(0.0, 1.0);
+void MicroCircuit::integrateAdaptive(double input_strength, double dt) {
+    using State = std::array<double, 5>; // E, I, glutamate, GABA, adaptation
     
-    double noise_strength = config_.noise_level * std::sqrt(dt);
-    current_state_.excitatory_activity += noise_dist(gen) * noise_strength;
-    current_state_.inhibitory_activity += noise_dist(gen) * noise_strength * 0.5;
+    const double tau_inhibition = inhibitionTau();
+    const double inhibition_delay = inhibitionDelay();
+    const double inhibitory_modulation = getModulation(ModulationType::Inhibitory);
+    const double excitation_gain_rate = excitationGainRate();
+    const double inhibition_gain_rate = inhibitionGainRate();
+    double elapsed = 0.0;  // Time into this step at the current substep
+    static constexpr State lower = {0.0, 0.0, 0.1, 0.1, -1e300};
+    static constexpr State upper = {5.0, 3.0, 2.0, 2.0, 1e300};
     
-    // Ensure non-negative values
-    current_state_.excitatory_activity = std::max(0.0, current_state_.excitatory_activity);
-    current_state_.inhibitory_activity = std::max(0.0, current_state_.inhibitory_activity);
+    // Bounded system: couplings see saturated values, and a variable at a
+    // bound does not move further outward. Inhibition sees excitation one
+    // delay before time t into the step: from the delay line (interpolated
+    // at the stage time) while that lies before this step, otherwise the
+    // current value.
+    auto derivative = [&](const State& y, double t) {
+        State s;
+        for (size_t i = 0; i < s.size(); ++i) {
+            s[i] = std::max(lower[i], std::min(upper[i], y[i]));
+        }
+        
+        double firing_rate = calculateFiringRate(s[0] - s[1]);
+        double delayed_excitation = step_mode_ == StepMode::Held ? held_excitation_ :
+            step_mode_ != StepMode::Linearized && inhibition_delay > t ?
+            excitatory_delay_.read(inhibition_delay - t) : s[0];
+        State dy = {
+            ((config_.baseline_excitation + input_strength * s[2]) * config_.ei_ratio - y[0]) / 10.0 -
+                (adaptationDecayRate(y[4]) - excitation_gain_rate) * y[0],
+            (delayed_excitation * s[3] + inhibitory_modulation - y[1]) / tau_inhibition +
+                inhibition_gain_rate * y[1],
+            (1.0 + s[0] * 0.2 - y[2]) / 100.0,
+            (1.0 + s[1] * 0.15 - y[3]) / 100.0,
+            (firing_rate * 0.1 - y[4]) / 500.0
+        };
+        for (size_t i = 0; i < dy.size(); ++i) {
+            if ((y[i] >= upper[i] && dy[i] > 0.0) || (y[i] <= lower[i] && dy[i] < 0.0)) {
+                dy[i] = 0.0;
+            }
+        }
+        return dy;
+    };
+    
+    State y = {current_state_.excitatory_activity, current_state_.inhibitory_activity,
+               current_state_.neurotransmitters.glutamate_level,
+               current_state_.neurotransmitters.gaba_level, current_state_.adaptation_level};
+    
+    // Dormand-Prince 5(4) tableau; stage times c_i only enter through the delayed excitation
+    static constexpr double c2 = 1.0 / 5, c3 = 3.0 / 10, c4 = 4.0 / 5, c5 = 8.0 / 9;
+    static constexpr double a21 = 1.0 / 5;
+    static constexpr double a31 = 3.0 / 40, a32 = 9.0 / 40;
+    static constexpr double a41 = 44.0 / 45, a42 = -56.0 / 15, a43 = 32.0 / 9;
+    static constexpr double a51 = 19372.0 / 6561, a52 = -25360.0 / 2187, a53 = 64448.0 / 6561,
+                            a54 = -212.0 / 729;
+    static constexpr double a61 = 9017.0 / 3168, a62 = -355.0 / 33, a63 = 46732.0 / 5247,
+                            a64 = 49.0 / 176, a65 = -5103.0 / 18656;
+    static constexpr double b1 = 35.0 / 384, b3 = 500.0 / 1113, b4 = 125.0 / 192,
+                            b5 = -2187.0 / 6784, b6 = 11.0 / 84;
+    static constexpr double e1 = 71.0 / 57600, e3 = -71.0 / 16695, e4 = 71.0 / 1920,
+                            e5 = -17253.0 / 339200, e6 = 22.0 / 525, e7 = -1.0 / 40;
+    
+    auto combine = [](const State& base, double h, std::initializer_list<std::pair<double, const State*>> terms) {
+        State out = base;
+        for (const auto& [weight, k] : terms) {
+            for (size_t i = 0; i < out.size(); ++i) {
+                out[i] += h * weight * (*k)[i];
+            }
+        }
+        return out;
+    };
+    
+    // Deterministic step maps are differentiated numerically and need a
+    // smoother error control than the simulation
+    double tolerance = std::max(1e-12, config_.rk45_tolerance);
+    if (step_mode_ == StepMode::Linearized || step_mode_ == StepMode::Held) {
+        tolerance = std::min(tolerance, DETERMINISTIC_RK45_TOLERANCE);
+    }
+    double remaining = dt;
+    double h = std::min(rk45_step_, dt);
+    State k1 = derivative(y, elapsed);
+    
+    while (remaining > 0.0) {
+        h = std::min(h, remaining);
+        
+        State k2 = derivative(combine(y, h, {{a21, &k1}}), elapsed + c2 * h);
+        State k3 = derivative(combine(y, h, {{a31, &k1}, {a32, &k2}}), elapsed + c3 * h);
+        State k4 = derivative(combine(y, h, {{a41, &k1}, {a42, &k2}, {a43, &k3}}), elapsed + c4 * h);
+        State k5 = derivative(combine(y, h, {{a51, &k1}, {a52, &k2}, {a53, &k3}, {a54, &k4}}),
+                              elapsed + c5 * h);
+        State k6 = derivative(combine(y, h, {{a61, &k1}, {a62, &k2}, {a63, &k3}, {a64, &k4}, {a65, &k5}}),
+                              elapsed + h);
+        State y_next = combine(y, h, {{b1, &k1}, {b3, &k3}, {b4, &k4}, {b5, &k5}, {b6, &k6}});
+        State k7 = derivative(y_next, elapsed + h);
+        State error = combine(State{}, h, {{e1, &k1}, {e3, &k3}, {e4, &k4}, {e5, &k5}, {e6, &k6}, {e7, &k7}});
+        
+        // Mixed absolute/relative error norm (max over components)
+        double error_norm = 0.0;
+        for (size_t i = 0; i < y.size(); ++i) {
+            double scale = tolerance * (1.0 + std::max(std::abs(y[i]), std::abs(y_next[i])));
+            error_norm = std::max(error_norm, std::abs(error[i]) / scale);
+        }
+        
+        if (!std::isfinite(error_norm)) {
+            // Non-finite derivatives: keep the last accepted state rather than shrink forever
+            rk45_step_ = 1.0;
+            break;
+        }
+        
+        // Steps at the floor are accepted so every call finishes
+        double growth = error_norm > 0.0 ? 0.9 * std::pow(error_norm, -0.2) : 5.0;
+        if (error_norm <= 1.0 || h <= RK45_MIN_STEP) {
+            // Accept, keeping the state inside the same bounds as the discrete update
+            State bounded;
+            for (size_t i = 0; i < bounded.size(); ++i) {
+                bounded[i] = std::max(lower[i], std::min(upper[i], y_next[i]));
+            }
+            
+            // First-same-as-last: k7 is the next k1 unless a bound was hit
+            k1 = bounded == y_next ? k7 : derivative(bounded, elapsed + h);
+            y = bounded;
+            remaining -= h;
+            elapsed += h;
+            rk45_step_ = h * std::min(5.0, growth);
+            h = rk45_step_;
+        } else {
+            h = std::max(RK45_MIN_STEP, h * std::max(0.2, growth));
+        }
+    }
+    
+    current_state_.excitatory_activity = std::max(0.0, std::min(5.0, y[0]));
+    current_state_.inhibitory_activity = std::max(0.0, std::min(3.0, y[1]));
+    current_state_.neurotransmitters.glutamate_level = std::max(0.1, std::min(2.0, y[2]));
+    current_state_.neurotransmitters.gaba_level = std::max(0.1, std::min(2.0, y[3]));
+    current_state_.adaptation_level = y[4];
+    pushExcitation();
 }
 
-void MicroCircuit::applyAutismModifications() {
-    // Enhanced E/I ratio
-    current_state_.excitatory_activity *= config_.autism_ei_elevation;
-    
-    // Reduced inhibitory control
-    current_state_.inhibitory_activity *= config_.autism_inhibition_deficit;
+void MicroCircuit::pushExcitation() {
+    // Linearized steps leave the delay line alone and only note the value
+    if (step_mode_ == StepMode::Linearized || step_mode_ == StepMode::Held) {
+        linearized_excitation_ = current_state_.excitatory_activity;
+    } else {
+        excitatory_delay_.push(current_state_.excitatory_activity);
+    }
 }
 
-void MicroCircuit::applyPTSDModifications() {
-    // Hyperarousal
-    current_state_.excitatory_activity *= config_.ptsd_hyperarousal;
+bool MicroCircuit::fastForward(double duration, double dt, bool inject_noise) {
+    if (duration <= 0.0 || dt <= 0.0) {
+        return true;
+    }
     
-    // Check for memory intrusion
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_real_distribution<> intrusion_dist(0.0, 1.0);
+    // Whole steps of (nearly) the requested length that cover the gap exactly
+    size_t steps = std::max<size_t>(1, static_cast<size_t>(std::llround(duration / dt)));
+    dt = duration / static_cast<double>(steps);
+    excitatory_delay_.configure(inhibitionDelay(), dt);
     
-    if (intrusion_dist(gen) < config_.ptsd_memory_intrusion) {
-        // Simulate memory intrusion as sudden excitatory burst
-        current_state_.excitatory_activity += 1.0;
+    // RK45's step maps are stiff and costly to differentiate; the exponential
+    // scheme integrates the same equations and relaxes the gap instead, while
+    // the delay-length tail below is stepped with RK45 itself
+    const IntegrationMethod integrator = config_.integrator;
+    const IntegrationMethod relaxation = integrator == IntegrationMethod::AdaptiveRK45 ?
+                                         IntegrationMethod::Exponential : integrator;
+    
+    bool closed_form = true;
+    double skipped_time = 0.0;
+    while (steps > 0) {
+        // Modulations stay constant until the next expiry
+        modulations_.advance(current_time_);
+        updateNeuromodulatorLevels();
+        double drive = getModulation(ModulationType::Excitatory);
+        size_t segment = steps;
+        double expiry = modulations_.nextExpiry();
+        if (std::isfinite(expiry)) {
+            double until_expiry = std::ceil((expiry - current_time_) / dt - 1e-9);
+            segment = std::min(steps, static_cast<size_t>(std::max(1.0, until_expiry)));
+        }
+        steps -= segment;
+        const size_t segment_steps = segment;
+        
+        // The transient after input ends is stepped exactly (noise-free, through
+        // the delay line): linearized chunks drop the inhibition delay, which
+        // matters while the fast E/I modes still move. Stepping covers one delay
+        // and FAST_FORWARD_TRANSIENT_TAUS inhibitory time constants, then goes on
+        // (up to FAST_FORWARD_TRANSIENT) until excitation moves by less than
+        // FAST_FORWARD_TOLERANCE over one delay.
+        const double delay = inhibitionDelay();
+        size_t transient = 0;
+        size_t transient_min = std::min(segment, static_cast<size_t>(std::ceil(
+            (delay + FAST_FORWARD_TRANSIENT_TAUS * inhibitionTau()) / dt)));
+        size_t transient_max = std::min(segment, static_cast<size_t>(std::ceil(FAST_FORWARD_TRANSIENT / dt)));
+        auto settled = [&]() {
+            double excitation = current_state_.excitatory_activity;
+            return std::abs(excitation - excitatory_delay_.read(delay)) <=
+                   FAST_FORWARD_TOLERANCE * std::max(0.1, excitation);
+        };
+        step_mode_ = StepMode::NoiseFree;
+        for (; transient < transient_max && (transient < transient_min || !settled()); ++transient) {
+            advanceDynamics(drive, dt);
+        }
+        step_mode_ = StepMode::Stochastic;
+        current_time_ += static_cast<double>(transient) * dt;
+        skipped_time += static_cast<double>(transient) * dt;
+        segment -= transient;
+        
+        size_t tail = std::min(segment, excitatory_delay_.capacity());
+        DynamicsVector state = dynamicsState();
+        config_.integrator = relaxation;
+        size_t remaining = relaxIdle(state, segment - tail, drive, dt);
+        
+        if (remaining > 0) {
+            // Chunks stopped growing: finish linearized around the idle fixed
+            // point, x_n = x* + J*^n (x - x*), if there is a stable one nearby
+            DynamicsVector fixed_point;
+            DynamicsMatrix jacobian;
+            if (idleFixedPoint(state, drive, dt, fixed_point, jacobian) &&
+                jacobian.eigenvalues().cwiseAbs().maxCoeff() < 1.0) {
+                DynamicsMatrix power;
+                DynamicsMatrix power_sum;
+                matrixPowerSum(jacobian, remaining, power, power_sum);
+                state = clampDynamics(fixed_point + power * (state - fixed_point));
+                remaining = 0;
+            }
+        }
+        
+        // History for the delayed inhibition of the tail: the excitation a step
+        // from the relaxed state would push
+        if (tail < segment) {
+            idleStep(state, drive, dt);
+            excitatory_delay_.fill(linearized_excitation_);
+        }
+        config_.integrator = integrator;
+        
+        if (remaining > 0) {
+            // No stable idle state to settle into (e.g. a limit cycle): simulate the rest
+            setDynamicsState(state);
+            current_time_ += static_cast<double>(segment - tail - remaining) * dt;
+            skipped_time += static_cast<double>(segment - tail - remaining) * dt;
+            for (size_t i = 0; i < remaining + tail; ++i) {
+                process(0.0, dt);
+            }
+            closed_form = false;
+            continue;
+        }
+        
+        // The last steps are taken exactly (without noise) through the delay line
+        setDynamicsState(state);
+        step_mode_ = StepMode::NoiseFree;
+        for (size_t i = 0; i < tail; ++i) {
+            advanceDynamics(drive, dt);
+        }
+        step_mode_ = StepMode::Stochastic;
+        state = dynamicsState();
+        
+        if (inject_noise) {
+            // Noise accumulated through the map linearized at the end state:
+            // covariance = sum_k J^k Q J^kT
+            config_.integrator = relaxation;
+            DynamicsMatrix covariance = noiseCovariance(idleJacobian(state, drive, dt), idleNoiseCovariance(dt), segment_steps);
+            config_.integrator = integrator;
+            Eigen::SelfAdjointEigenSolver<DynamicsMatrix> solver(covariance);
+            DynamicsVector draw;
+            for (Eigen::Index i = 0; i < draw.size(); ++i) {
+                draw(i) = noise_generator_.normal() * std::sqrt(std::max(0.0, solver.eigenvalues()(i)));
+            }
+            state += solver.eigenvectors() * draw;
+        }
+        
+        setDynamicsState(state);
+        current_time_ += static_cast<double>(segment) * dt;
+        skipped_time += static_cast<double>(segment) * dt;
     }
+    
+    if (skipped_time > 0.0) {
+        // The skipped span enters the detectors and history as one sample
+        current_state_.net_activation = current_state_.excitatory_activity - current_state_.inhibitory_activity;
+        current_state_.firing_rate = calculateFiringRate(current_state_.net_activation);
+        oscillation_detector_.reset();
+        current_state_.band_power = oscillation_detector_.bandPowers();
+        current_state_.in_oscillation = false;
+        current_state_.hyperexcitable = detectHyperexcitability();
+        current_state_.inhibition_failure = detectInhibitionFailure();
+        pathology_detector_.push(current_state_.excitatory_activity, current_state_.inhibitory_activity, skipped_time);
+        updateActivationHistory();
+    }
+    return closed_form;
 }
 
-void MicroCircuit::detectOscillations() {
-    if (current_state_.activation_history.size() < 10) {
-        current_state_.in_oscillation = false;
-        return;
+MicroCircuit::SteadyStateAnalysis MicroCircuit::analyzeSteadyState(double input_strength, double dt) {
+    SteadyStateAnalysis analysis;
+    if (dt <= 0.0) {
+        return analysis;
     }
+    double drive = input_strength * (1.0 + getModulation(ModulationType::Neuromodulatory)) +
+                   getModulation(ModulationType::Excitatory);
     
-    // Simple oscillation detection: look for regular peaks
-    std::vector<double> recent_history(current_state_.activation_history.end() - 10, 
-                                     current_state_.activation_history.end());
+    // Newton from the current state, else from the state it relaxes towards
+    // (closed-form chunks), which keeps it off the kinks of the bounds. The
+    // delay-free map has the same fixed points (the history is constant there).
+    // Convergence is judged by the size of the Newton correction: along slow
+    // modes a small per-step residual can still be far from the fixed point.
+    DynamicsVector fixed_point;
+    DynamicsMatrix jacobian;
+    auto solve = [&](const DynamicsVector& start) {
+        idleFixedPoint(start, drive, dt, fixed_point, jacobian);
+        DynamicsVector correction = (jacobian - DynamicsMatrix::Identity()).fullPivLu()
+                                        .solve(idleStep(fixed_point, drive, dt) - fixed_point);
+        return fixed_point.allFinite() &&
+               correction.lpNorm<Eigen::Infinity>() <= ANALYSIS_TOLERANCE * (1.0 + fixed_point.lpNorm<Eigen::Infinity>());
+    };
+    DynamicsVector start = dynamicsState();
+    analysis.converged = solve(start);
+    if (!analysis.converged) {
+        relaxIdle(start, static_cast<size_t>(std::ceil(ANALYSIS_HORIZON / dt)), drive, dt);
+        analysis.converged = solve(start);
+    }
+    analysis.fixed_point = fixed_point;
+    if (!analysis.converged) {
+        return analysis;
+    }
     
-    // Count zero crossings as a simple oscillation measure
-    int zero_crossings = 0;
-    double mean = std::accumulate(recent_history.begin(), recent_history.end(), 0.0) / recent_history.size();
+    // Linearized map of (x_n, e_n-1, ..., e_n-D), where e is the excitation
+    // pushed to the delay line and inhibition reads e_n-D:
+    //   x_n+1 = F(x_n, e_n-D),  e_n = G(x_n, e_n-D)
+    size_t lag = static_cast<size_t>(std::llround(inhibitionDelay() / dt));
+    Eigen::MatrixXd map = jacobian;
+    if (lag > 0) {
+        Eigen::Index size = 5 + static_cast<Eigen::Index>(lag);
+        map = Eigen::MatrixXd::Zero(size, size);
+        idleStep(fixed_point, drive, dt);
+        double excitation = linearized_excitation_;
+        
+        // Central differences in each state variable, then in the delayed excitation
+        for (Eigen::Index j = 0; j <= fixed_point.size(); ++j) {
+            bool delayed = j == fixed_point.size();
+            double h = 1e-6 * std::max(1.0, std::abs(delayed ? excitation : fixed_point(j)));
+            DynamicsVector up = fixed_point;
+            DynamicsVector down = fixed_point;
+            double held_up = excitation;
+            double held_down = excitation;
+            (delayed ? held_up : up(j)) += h;
+            (delayed ? held_down : down(j)) -= h;
+            
+            held_excitation_ = held_up;
+            DynamicsVector next_up = deterministicStep(StepMode::Held, up, drive, dt);
+            double pushed_up = linearized_excitation_;
+            held_excitation_ = held_down;
+            DynamicsVector next_down = deterministicStep(StepMode::Held, down, drive, dt);
+            double pushed_down = linearized_excitation_;
+            
+            Eigen::Index column = delayed ? size - 1 : j;
+            map.block<5, 1>(0, column) = (next_up - next_down) / (2.0 * h);
+            map(5, column) = (pushed_up - pushed_down) / (2.0 * h);
+        }
+        
+        // The history shifts by one step
+        for (Eigen::Index k = 6; k < size; ++k) {
+            map(k, k - 1) = 1.0;
+        }
+    }
+    
+    Eigen::EigenSolver<Eigen::MatrixXd> solver(map, false);
+    const Eigen::VectorXcd& values = solver.eigenvalues();
+    analysis.eigenvalues.assign(values.data(), values.data() + values.size());
+    std::sort(analysis.eigenvalues.begin(), analysis.eigenvalues.end(),
+              [](const std::complex<double>& a, const std::complex<double>& b) { return std::abs(a) > std::abs(b); });
+    
+    // Classification by the dominant (slowest decaying) mode
+    const std::complex<double>& dominant = analysis.eigenvalues.front();
+    analysis.spectral_radius = std::abs(dominant);
+    analysis.growth_rate = std::log(std::max(1e-300, analysis.spectral_radius)) / dt;
+    analysis.stable = analysis.spectral_radius < 1.0;
+    analysis.oscillatory = std::abs(std::arg(dominant)) > 1e-6;
+    if (analysis.oscillatory) {
+        analysis.oscillation_frequency = std::abs(std::arg(dominant)) / TWO_PI * (1000.0 / dt);
+    }
     
-    for (size_t i = 1; i < recent_history.size(); ++i) {
-        if ((recent_history[i-1] - mean) * (recent_history[i] - mean) < 0) {
-            zero_crossings++;
+    double ratio = fixed_point(0) / std::max(0.1, fixed_point(1));
+    analysis.looping = ratio > 2.0;
+    analysis.hyperexcitable = fixed_point(0) > 3.0 || ratio > 3.0;
+    return analysis;
+}
+
+MicroCircuit::SteadyStateAnalysis MicroCircuit::analyzeSteadyState(const CircuitConfig& config,
+                                                                   double input_strength, double dt) {
+    // A fixed seed spares the random device; the analysis draws no noise
+    CircuitConfig deterministic = config;
+    deterministic.noise_seed = 1;
+    deterministic.record_history = false;
+    MicroCircuit circuit(deterministic);
+    return circuit.analyzeSteadyState(input_strength, dt);
+}
+
+size_t MicroCircuit::relaxIdle(DynamicsVector& state, size_t steps, double drive, double dt) {
+    // Relaxation in chunks, each an m-fold affine map x -> F(x0) + J(x0) (x - x0)
+    // summed in closed form:
+    //   x_m = x0 + (I + J + ... + J^(m-1)) (F(x0) - x0)
+    // A chunk is accepted if it agrees with two half chunks (step doubling)
+    // to a fraction of its own movement and then doubles; otherwise it is
+    // halved. Chunks stay short through the nonlinear transient and grow
+    // geometrically once the approach to the idle state is near-linear.
+    auto relax = [&](const DynamicsVector& from, size_t length) {
+        DynamicsMatrix power;
+        DynamicsMatrix power_sum;
+        matrixPowerSum(idleJacobian(from, drive, dt), length, power, power_sum);
+        return clampDynamics(from + power_sum * (idleStep(from, drive, dt) - from));
+    };
+    size_t budget = FAST_FORWARD_CHUNKS;
+    for (size_t chunk = 1; steps > 0 && budget > 0; --budget) {
+        size_t length = std::min(chunk, steps);
+        if (length == 1) {
+            state = idleStep(state, drive, dt);
+            steps -= 1;
+            chunk = 2;
+            continue;
+        }
+        DynamicsVector whole = relax(state, length);
+        DynamicsVector halves = relax(relax(state, length / 2), length - length / 2);
+        double movement = (halves - state).cwiseAbs().maxCoeff();
+        if ((whole - halves).cwiseAbs().maxCoeff() <= FAST_FORWARD_TOLERANCE * movement + 1e-12) {
+            state = halves;
+            steps -= length;
+            chunk = 2 * length;
+        } else {
+            chunk = length / 2;
+        }
+    }
+    return steps;
+}
+
+MicroCircuit::DynamicsVector MicroCircuit::dynamicsState() const {
+    DynamicsVector state;
+    state << current_state_.excitatory_activity, current_state_.inhibitory_activity,
+             current_state_.neurotransmitters.glutamate_level, current_state_.neurotransmitters.gaba_level,
+             current_state_.adaptation_level;
+    return state;
+}
+
+void MicroCircuit::setDynamicsState(const DynamicsVector& state) {
+    DynamicsVector bounded = clampDynamics(state);
+    current_state_.excitatory_activity = bounded(0);
+    current_state_.inhibitory_activity = bounded(1);
+    current_state_.neurotransmitters.glutamate_level = bounded(2);
+    current_state_.neurotransmitters.gaba_level = bounded(3);
+    current_state_.adaptation_level = bounded(4);
+}
+
+MicroCircuit::DynamicsVector MicroCircuit::deterministicStep(StepMode mode, const DynamicsVector& state,
+                                                             double drive, double dt) {
+    // One step from the given state without touching the circuit or its delay line
+    ActivationState saved_state = current_state_;
+    double saved_rk45_step = rk45_step_;
+    step_mode_ = mode;
+    setDynamicsState(state);
+    advanceDynamics(drive, dt);
+    DynamicsVector next = dynamicsState();
+    step_mode_ = StepMode::Stochastic;
+    current_state_ = saved_state;
+    rk45_step_ = saved_rk45_step;
+    return next;
+}
+
+MicroCircuit::DynamicsVector MicroCircuit::idleStep(const DynamicsVector& state, double drive, double dt) {
+    // Noise-free and delay-free
+    return deterministicStep(StepMode::Linearized, state, drive, dt);
+}
+
+MicroCircuit::DynamicsMatrix MicroCircuit::idleJacobian(const DynamicsVector& state, double drive, double dt) {
+    // Central differences of the step map
+    DynamicsMatrix jacobian;
+    for (Eigen::Index j = 0; j < state.size(); ++j) {
+        double h = 1e-6 * std::max(1.0, std::abs(state(j)));
+        DynamicsVector up = state;
+        DynamicsVector down = state;
+        up(j) += h;
+        down(j) -= h;
+        jacobian.col(j) = (idleStep(up, drive, dt) - idleStep(down, drive, dt)) / (2.0 * h);
+    }
+    return jacobian;
+}
+
+bool MicroCircuit::idleFixedPoint(const DynamicsVector& start, double drive, double dt,
+                                  DynamicsVector& fixed_point, DynamicsMatrix& jacobian) {
+    // Damped Newton iteration on F(x) - x. A damped step is accepted when
+    // the next Newton correction (with the same Jacobian) is shorter, an
+    // affine-invariant test that copes with the badly scaled variables and
+    // the kinks at the bounds; otherwise the step is halved.
+    static constexpr int max_iterations = 50;
+    DynamicsVector state = start;
+    DynamicsVector residual = idleStep(state, drive, dt) - state;
+    for (int iteration = 0; iteration < max_iterations && residual.norm() >= 1e-12; ++iteration) {
+        jacobian = idleJacobian(state, drive, dt);
+        Eigen::FullPivLU<DynamicsMatrix> solver(jacobian - DynamicsMatrix::Identity());
+        DynamicsVector newton = solver.solve(residual);
+        bool improved = false;
+        double scale = 1.0;
+        for (int halving = 0; halving < 20 && !improved; ++halving, scale *= 0.5) {
+            DynamicsVector candidate = clampDynamics(state - scale * newton);
+            DynamicsVector candidate_residual = idleStep(candidate, drive, dt) - candidate;
+            if (solver.solve(candidate_residual).norm() < (1.0 - 0.25 * scale) * newton.norm()) {
+                state = candidate;
+                residual = candidate_residual;
+                improved = true;
+            }
+        }
+        if (!improved) {
+            break;
         }
     }
     
-    current_state_.in_oscillation = zero_crossings > 4;
-    if (current_state_.in_oscillation) {
-        current_state_.oscillation_frequency = calculateOscillationFrequency();
+    fixed_point = state;
+    jacobian = idleJacobian(state, drive, dt);
+    // Converged to within the step map's own accuracy (RK45 tolerance)
+    return state.allFinite() && residual.norm() < FIXED_POINT_TOLERANCE;
+}
+
+MicroCircuit::DynamicsMatrix MicroCircuit::idleNoiseCovariance(double dt) const {
+    // Per-step noise as it leaves the step: scaled by the autism/PTSD gains where
+    // Euler applies them after the noise, plus the variance of PTSD intrusions
+    bool split_gains = config_.integrator == IntegrationMethod::Euler;
+    double excitatory_gain = split_gains ? std::exp(excitationGainRate() * dt) : 1.0;
+    double inhibitory_gain = split_gains && config_.autism_mode ? stepGain(config_.autism_inhibition_deficit, dt) : 1.0;
+    double strength = config_.noise_level * std::sqrt(dt);
+    double intrusion = config_.ptsd_mode ? intrusionProbability(dt) : 0.0;
+    
+    DynamicsMatrix covariance = DynamicsMatrix::Zero();
+    covariance(0, 0) = std::pow(strength * excitatory_gain, 2) + intrusion * (1.0 - intrusion);
+    covariance(1, 1) = std::pow(strength * 0.5 * inhibitory_gain, 2);
+    return covariance;
+}
+
+double MicroCircuit::relaxationFactor(double dt, double tau) const {
+    // Fraction of the gap to the target closed in dt; exact for a held target
+    if (config_.integrator == IntegrationMethod::Exponential) {
+        return -std::expm1(-dt / tau);
     }
+    return dt / tau;
 }
 
-double MicroCircuit::calculateOscillationFrequency() const {
-    // Simplified frequency calculation
-    if (current_state_.activation_history.size() < 20) return 0.0;
+double MicroCircuit::adaptationDecayRate(double adaptation_level) const {
+    // Decay rate (per ms) of the per-ms retention (1 - adaptation * rate)
+    double retention = 1.0 - adaptation_level * config_.adaptation_rate;
+    return -std::log(std::max(1e-12, retention));
+}
+
+double MicroCircuit::stepGain(double gain, double dt) const {
+    // Gains are per ms: a step of dt applies the rate ln(gain) for dt
+    return std::pow(std::max(1e-12, gain), dt);
+}
+
+double MicroCircuit::excitationGainRate() const {
+    // Growth rate (per ms) of the autism E/I elevation and PTSD hyperarousal
+    double rate = 0.0;
+    if (config_.autism_mode) {
+        rate += std::log(std::max(1e-12, config_.autism_ei_elevation));
+    }
+    if (config_.ptsd_mode) {
+        rate += std::log(std::max(1e-12, config_.ptsd_hyperarousal));
+    }
+    return rate;
+}
+
+double MicroCircuit::inhibitionGainRate() const {
+    // The Euler step applies the autism deficit with the inhibitory update and
+    // again with the mode modifications
+    return config_.autism_mode ? 2.0 * std::log(std::max(1e-12, config_.autism_inhibition_deficit)) : 0.0;
+}
+
+double MicroCircuit::exponentialUpdate(double value, double source, double rate, double dt) {
+    // Exact solution of dx/dt = source - rate * x over dt (rate may be zero or negative)
+    double span = rate != 0.0 ? -std::expm1(-rate * dt) / rate : dt;
+    return value * std::exp(-rate * dt) + source * span;
+}
+
+double MicroCircuit::intrusionProbability(double dt) const {
+    // Per-ms intrusion probability, compounded over the step
+    double probability = std::max(0.0, std::min(1.0, config_.ptsd_memory_intrusion));
+    return 1.0 - std::pow(1.0 - probability, dt);
+}
+
+double MicroCircuit::inhibitionTau() const {
+    if (config_.inhibition_delay_line) {
+        return 20.0; // ms
+    }
+    // Without a delay line the delay is approximated by a slower response
+    double effective_delay = config_.ptsd_mode ? config_.ptsd_inhibition_delay : config_.inhibition_delay_ms;
+    return 20.0 + effective_delay; // ms
+}
+
+double MicroCircuit::inhibitionDelay() const {
+    // Delay read from the excitation history (increased in PTSD); 0 without a delay line
+    if (!config_.inhibition_delay_line) {
+        return 0.0;
+    }
+    return config_.ptsd_mode ? config_.ptsd_inhibition_delay : config_.inhibition_delay_ms;
+}
+
+void MicroCircuit::applyModulation(ModulationType modulation_type, double strength, double duration) {
+    if (duration <= 0.0) {
+        return;
+    }
+    modulations_.schedule(static_cast<size_t>(modulation_type), strength, current_time_ + duration);
+}
+
+void MicroCircuit::applyModulation(const std::string& modulation_type, double strength, double duration) {
+    if (modulation_type == "excitatory") {
+        applyModulation(ModulationType::Excitatory, strength, duration);
+    } else if (modulation_type == "inhibitory") {
+        applyModulation(ModulationType::Inhibitory, strength, duration);
+    } else if (modulation_type == "neuromodulatory") {
+        applyModulation(ModulationType::Neuromodulatory, strength, duration);
+    }
+}
+
+void MicroCircuit::releaseNeurotransmitter(Neurotransmitter neurotransmitter, double amount, double clearance_ms) {
+    auto& levels = current_state_.neurotransmitters;
+    switch (neurotransmitter) {
+        case Neurotransmitter::Glutamate:
+            levels.glutamate_level = std::max(0.1, std::min(2.0, levels.glutamate_level + amount));
+            break;
+        case Neurotransmitter::GABA:
+            levels.gaba_level = std::max(0.1, std::min(2.0, levels.gaba_level + amount));
+            break;
+        default:
+            if (clearance_ms > 0.0) {
+                modulations_.schedule(modulationChannel(neurotransmitter), amount, current_time_ + clearance_ms);
+                updateNeuromodulatorLevels();
+            }
+            break;
+    }
+}
+
+void MicroCircuit::releaseNeurotransmitter(const std::string& neurotransmitter, double amount) {
+    static const std::pair<const char*, Neurotransmitter> names[] = {
+        {"glutamate", Neurotransmitter::Glutamate}, {"gaba", Neurotransmitter::GABA},
+        {"dopamine", Neurotransmitter::Dopamine}, {"serotonin", Neurotransmitter::Serotonin},
+        {"norepinephrine", Neurotransmitter::Norepinephrine}, {"acetylcholine", Neurotransmitter::Acetylcholine}
+    };
+    for (const auto& [name, type] : names) {
+        if (neurotransmitter == name) {
+            releaseNeurotransmitter(type, amount);
+            return;
+        }
+    }
+}
+
+double MicroCircuit::getModulation(ModulationType modulation_type) const {
+    return modulations_.total(static_cast<size_t>(modulation_type));
+}
+
+size_t MicroCircuit::modulationChannel(Neurotransmitter neurotransmitter) {
+    // Neuromodulator channels follow the three modulation types
+    return 3 + static_cast<size_t>(neurotransmitter) - static_cast<size_t>(Neurotransmitter::Dopamine);
+}
+
+void MicroCircuit::updateNeuromodulatorLevels() {
+    // Baseline plus active releases, kept in [0, 1]
+    static const NeurotransmitterState baseline;
+    auto level = [&](double base, Neurotransmitter type) {
+        return std::max(0.0, std::min(1.0, base + modulations_.total(modulationChannel(type))));
+    };
+    auto& levels = current_state_.neurotransmitters;
+    levels.dopamine_level = level(baseline.dopamine_level, Neurotransmitter::Dopamine);
+    levels.serotonin_level = level(baseline.serotonin_level, Neurotransmitter::Serotonin);
+    levels.norepinephrine_level = level(baseline.norepinephrine_level, Neurotransmitter::Norepinephrine);
+    levels.acetylcholine_level = level(baseline.acetylcholine_level, Neurotransmitter::Acetylcholine);
+}
+
+void MicroCircuit::addNoise(double dt) {
+    if (step_mode_ == StepMode::Stochastic) {
+        double noise_strength = config_.noise_level * std::sqrt(dt);
+        current_state_.excitatory_activity += noise_generator_.normal() * noise_strength;
+        current_state_.inhibitory_activity += noise_generator_.normal() * noise_strength * 0.5;
+    }
     
-    // Estimate frequency from zero crossings in recent history
-    std::vector<double> recent_history(current_state_.activation_history.end() - 20, 
-                                     current_state_.activation_history.end());
+    // Ensure non-negative values
+    current_state_.excitatory_activity = std::max(0.0, current_state_.excitatory_activity);
+    current_state_.inhibitory_activity = std::max(0.0, current_state_.inhibitory_activity);
+}
+
+void MicroCircuit::applyAutismModifications(double dt) {
+    // The other integrators fold these gains into the dynamics
+    if (config_.integrator != IntegrationMethod::Euler) {
+        return;
+    }
     
-    double mean = std::accumulate(recent_history.begin(), recent_history.end(), 0.0) / recent_history.size();
-    int zero_crossings = 0;
+    // Enhanced E/I ratio
+    current_state_.excitatory_activity *= stepGain(config_.autism_ei_elevation, dt);
     
-    for (size_t i = 1; i < recent_history.size(); ++i) {
-        if ((recent_history[i-1] - mean) * (recent_history[i] - mean) < 0) {
-            zero_crossings++;
-        }
+    // Reduced inhibitory control
+    current_state_.inhibitory_activity *= stepGain(config_.autism_inhibition_deficit, dt);
+}
+
+void MicroCircuit::applyPTSDModifications(double dt) {
+    // Hyperarousal (folded into the dynamics by the other integrators)
+    if (config_.integrator == IntegrationMethod::Euler) {
+        current_state_.excitatory_activity *= stepGain(config_.ptsd_hyperarousal, dt);
+    }
+    
+    // Check for memory intrusion (its expected size in noise-free steps)
+    double intrusion = intrusionProbability(dt);
+    if (step_mode_ != StepMode::Stochastic) {
+        current_state_.excitatory_activity += intrusion;
+    } else if (noise_generator_.uniform() < intrusion) {
+        // Simulate memory intrusion as sudden excitatory burst
+        current_state_.excitatory_activity += 1.0;
     }
+}
+
+void MicroCircuit::detectOscillations(double dt) {
+    // Streaming spectral detector over a fixed-duration window (dt-correct)
+    oscillation_detector_.push(current_state_.net_activation, dt);
     
-    // Frequency = zero_crossings / (2 * time_window)
-    double time_window = 20.0; // ms (assuming 1ms per sample)
-    return (zero_crossings / 2.0) * (1000.0 / time_window); // Convert to Hz
+    current_state_.band_power = oscillation_detector_.bandPowers();
+    current_state_.in_oscillation = oscillation_detector_.isOscillating();
+    if (current_state_.in_oscillation) {
+        current_state_.oscillation_frequency = calculateOscillationFrequency();
+    }
+}
+
+double MicroCircuit::calculateOscillationFrequency() const {
+    // Strongest spectral bin within the theta-gamma range
+    return oscillation_detector_.peakFrequency();
 }
 
 bool MicroCircuit::detectHyperexcitability() const {
@@ -241,6 +999,31 @@ bool MicroCircuit::detectInhibitionFailure() const {
     return current_state_.inhibitory_activity < 0.2 && current_state_.excitatory_activity > 1.0;
 }
 
+bool MicroCircuit::detectSeizureActivity() const {
+    return pathology_detector_.seizure();
+}
+
+bool MicroCircuit::detectMemoryIntrusion() const {
+    return pathology_detector_.intrusion();
+}
+
+std::vector<std::string> MicroCircuit::detectPathologicalPatterns() const {
+    std::vector<std::string> patterns;
+    if (pathology_detector_.hyperexcitable()) {
+        patterns.push_back("hyperexcitability");
+    }
+    if (pathology_detector_.inhibitionFailure()) {
+        patterns.push_back("inhibition_failure");
+    }
+    if (detectSeizureActivity()) {
+        patterns.push_back("seizure_activity");
+    }
+    if (detectMemoryIntrusion()) {
+        patterns.push_back("memory_intrusion");
+    }
+    return patterns;
+}
+
 double MicroCircuit::calculateFiringRate(double net_activation) const {
     // Sigmoid activation function
     double sigmoid_output = 1.0 / (1.0 + std::exp(-net_activation));
@@ -248,18 +1031,35 @@ double MicroCircuit::calculateFiringRate(double net_activation) const {
 }
 
 void MicroCircuit::updateActivationHistory() {
-    current_state_.activation_history.push_back(current_state_.net_activation);
+    // Ring buffer: overwrite the oldest sample, no shifting or reallocation
+    net_history_[history_head_] = current_state_.net_activation;
+    history_head_ = (history_head_ + 1) % MAX_HISTORY_SIZE;
+    history_count_ = std::min(history_count_ + 1, MAX_HISTORY_SIZE);
     
-    // Limit history size
-    if (current_state_.activation_history.size() > MAX_HISTORY_SIZE) {
-        current_state_.activation_history.erase(current_state_.activation_history.begin());
+    if (!config_.record_history) {
+        return;
     }
-    
-    // Store in main history
-    activation_history_.push_back(current_state_);
-    if (activation_history_.size() > MAX_HISTORY_SIZE) {
-        activation_history_.erase(activation_history_.begin());
+    if (step_records_.empty()) {
+        step_records_.resize(MAX_HISTORY_SIZE);
     }
+    
+    StepRecord& record = step_records_[record_head_];
+    record.timestamp = current_time_;
+    record.excitatory_activity = static_cast<float>(current_state_.excitatory_activity);
+    record.inhibitory_activity = static_cast<float>(current_state_.inhibitory_activity);
+    record.net_activation = static_cast<float>(current_state_.net_activation);
+    record.firing_rate = static_cast<float>(current_state_.firing_rate);
+    record.adaptation_level = static_cast<float>(current_state_.adaptation_level);
+    record.hyperexcitable = current_state_.hyperexcitable;
+    record.inhibition_failure = current_state_.inhibition_failure;
+    record.in_oscillation = current_state_.in_oscillation;
+    
+    record_head_ = (record_head_ + 1) % MAX_HISTORY_SIZE;
+    record_count_ = std::min(record_count_ + 1, MAX_HISTORY_SIZE);
+}
+
+double MicroCircuit::recentNetActivation(size_t age) const {
+    return net_history_[(history_head_ + MAX_HISTORY_SIZE - 1 - age) % MAX_HISTORY_SIZE];
 }
 
 void MicroCircuit::enableAutismMode() {
@@ -281,12 +1081,52 @@ void MicroCircuit::reset() {
     current_state_.neurotransmitters.glutamate_level = 1.0;
     current_state_.neurotransmitters.gaba_level = 1.0;
     
-    activation_history_.clear();
+    history_head_ = 0;
+    history_count_ = 0;
+    record_head_ = 0;
+    record_count_ = 0;
+    oscillation_detector_.reset();
+    pathology_detector_.reset();
+    excitatory_delay_.fill(current_state_.excitatory_activity);
+    modulations_.clear();
     current_time_ = 0.0;
 }
 
 std::vector<MicroCircuit::ActivationState> MicroCircuit::getActivationHistory() const {
-    return activation_history_;
+    std::vector<ActivationState> history;
+    history.reserve(record_count_);
+    for (const auto& record : getStepRecords()) {
+        ActivationState state;
+        state.excitatory_activity = record.excitatory_activity;
+        state.inhibitory_activity = record.inhibitory_activity;
+        state.net_activation = record.net_activation;
+        state.firing_rate = record.firing_rate;
+        state.adaptation_level = record.adaptation_level;
+        state.hyperexcitable = record.hyperexcitable;
+        state.inhibition_failure = record.inhibition_failure;
+        state.in_oscillation = record.in_oscillation;
+        history.push_back(state);
+    }
+    return history;
+}
+
+std::vector<MicroCircuit::StepRecord> MicroCircuit::getStepRecords() const {
+    std::vector<StepRecord> records;
+    records.reserve(record_count_);
+    size_t oldest = (record_head_ + MAX_HISTORY_SIZE - record_count_) % MAX_HISTORY_SIZE;
+    for (size_t i = 0; i < record_count_; ++i) {
+        records.push_back(step_records_[(oldest + i) % MAX_HISTORY_SIZE]);
+    }
+    return records;
+}
+
+std::vector<double> MicroCircuit::getNetActivationHistory() const {
+    std::vector<double> history;
+    history.reserve(history_count_);
+    for (size_t age = history_count_; age-- > 0;) {
+        history.push_back(recentNetActivation(age));
+    }
+    return history;
 }
 
 void MicroCircuit::updateConfig(const CircuitConfig& config) {
@@ -295,13 +1135,88 @@ void MicroCircuit::updateConfig(const CircuitConfig& config) {
 
 // BrainRegion implementation
 BrainRegion::BrainRegion(const RegionConfig& config) 
-    : config_(config), current_activation_(0.0), current_time_(0.0) {
+    : config_(config), bank_slot_(0), current_activation_(0.0), current_time_(0.0),
+      deferred_stepping_(false), staged_input_(0.0) {
     
-    microcircuit_ = std::make_unique<MicroCircuit>(config.circuit_config);
+    if (config_.circuit_config.noise_stream == 0) {
+        config_.circuit_config.noise_stream = nameStream(config_.region_name);
+    }
+    microcircuit_ = std::make_unique<MicroCircuit>(config_.circuit_config);
+    if (config.spiking_population) {
+        spiking_population_ = std::make_unique<SpikingPopulation>(config.population_config);
+    }
+}
+
+double BrainRegion::processInput(double input, double dt) {
+    driveMicrocircuit(input, dt);
+    current_activation_ = std::max(0.0, std::min(config_.max_activation, input));
+    return current_activation_;
+}
+
+double BrainRegion::processInput(double input, const Eigen::Ref<const Eigen::VectorXd>& /*context*/,
+                                 double dt) {
+    return processInput(input, dt);
 }
 
 const MicroCircuit::ActivationState& BrainRegion::getMicrocircuitState() const {
+    if (circuit_bank_) {
+        circuit_bank_->getState(bank_slot_, bank_state_);
+        return bank_state_;
+    }
     return microcircuit_->getCurrentState();
 }
 
+bool BrainRegion::attachToBank(const std::shared_ptr<MicroCircuitBank>& bank) {
+    if (!bank || circuit_bank_) {
+        return false;
+    }
+
+    size_t slot = bank->add(config_.circuit_config);
+    if (slot == MicroCircuitBank::npos) {
+        return false;
+    }
+    circuit_bank_ = bank;
+    bank_slot_ = slot;
+    staged_input_ = 0.0;
+    microcircuit_.reset();
+    return true;
+}
+
+void BrainRegion::setDeferredStepping(bool deferred) {
+    deferred_stepping_ = deferred;
+    staged_input_ = 0.0;
+}
+
+void BrainRegion::stepMicrocircuit(double dt) {
+    if (circuit_bank_) {
+        circuit_bank_->addInput(bank_slot_, staged_input_);
+    } else {
+        microcircuit_->process(staged_input_, dt);
+    }
+    staged_input_ = 0.0;
+}
+
+bool BrainRegion::idleMicrocircuit(double duration, double dt) {
+    staged_input_ = 0.0;
+    if (circuit_bank_) {
+        return circuit_bank_->fastForward(bank_slot_, duration, dt);
+    }
+    return microcircuit_->fastForward(duration, dt, true);
+}
+
+void BrainRegion::driveMicrocircuit(double input, double dt) {
+    if (spiking_population_) {
+        spiking_population_->step(input, dt);
+    }
+    if (circuit_bank_) {
+        circuit_bank_->addInput(bank_slot_, input);
+        return;
+    }
+    if (deferred_stepping_) {
+        staged_input_ += input;
+        return;
+    }
+    microcircuit_->process(input, dt);
+}
+
 } // namespace neurosim
@@ -3,10 +3,50 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <cstdint>
+#include <complex>
 #include <Eigen/Dense>
+#include "oscillation_detector.hpp"
+#include "spiking_population.hpp"
+#include "modulation_scheduler.hpp"
+#include "pathology_detector.hpp"
+#include "delay_line.hpp"
+#include "noise_generator.hpp"
 
 namespace neurosim {
 
+class MicroCircuitBank;
+
+/**
+ * @brief Time integration scheme for microcircuit dynamics
+ */
+enum class IntegrationMethod {
+    Euler,          ///< Forward Euler (stable only for dt well below each tau)
+    Exponential,    ///< Exact exponential relaxation per variable (Rush-Larsen style)
+    AdaptiveRK45    ///< Dormand-Prince 5(4) with error-controlled substeps
+};
+
+/**
+ * @brief Kind of external modulation applied to a microcircuit
+ */
+enum class ModulationType {
+    Excitatory,     ///< Added to the excitatory drive
+    Inhibitory,     ///< Added to the inhibitory target
+    Neuromodulatory ///< Multiplicative gain on the input (1 + strength)
+};
+
+/**
+ * @brief Neurotransmitters tracked by a microcircuit
+ */
+enum class Neurotransmitter {
+    Glutamate,
+    GABA,
+    Dopamine,
+    Serotonin,
+    Norepinephrine,
+    Acetylcholine
+};
+
 /**
  * @brief Simulated neural microcircuit with GABA/Glutamate dynamics
  * 
@@ -38,21 +78,33 @@ public:
         double baseline_inhibition = 1.0;     ///< Baseline inhibitory drive
         double ei_ratio = 1.0;                ///< Excitation/Inhibition ratio
         double inhibition_delay_ms = 10.0;    ///< Inhibitory response delay
+        bool inhibition_delay_line = true;    ///< Delay inhibition's view of excitation (false: lengthen tau_I by the delay instead)
         double adaptation_rate = 0.1;         ///< Circuit adaptation rate
         double noise_level = 0.05;            ///< Neural noise level
+        uint64_t noise_seed = 0;              ///< Noise generator seed (0 = nondeterministic)
+        uint64_t noise_stream = 0;            ///< Noise stream under the seed (regions derive it from their name)
+        bool record_history = false;          ///< Keep a compact per-step record log
+        IntegrationMethod integrator = IntegrationMethod::Euler; ///< Time integration scheme
+        double rk45_tolerance = 1e-6;         ///< Relative/absolute error target (AdaptiveRK45)
         
         // Autism-specific parameters
         bool autism_mode = false;
-        double autism_ei_elevation = 1.4;     ///< Elevated E/I ratio in autism
-        double autism_inhibition_deficit = 0.7; ///< Reduced inhibitory control
+        double autism_ei_elevation = 1.4;     ///< Elevated E/I ratio in autism; per-ms gain on excitation
+        double autism_inhibition_deficit = 0.7; ///< Reduced inhibitory control; per-ms gain on inhibition
         
         // PTSD-specific parameters
         bool ptsd_mode = false;
         double ptsd_inhibition_delay = 50.0;  ///< Delayed inhibition in PTSD
-        double ptsd_hyperarousal = 1.5;       ///< Elevated baseline arousal
-        double ptsd_memory_intrusion = 0.3;   ///< Memory intrusion probability
+        double ptsd_hyperarousal = 1.5;       ///< Elevated baseline arousal; per-ms gain on excitation
+        double ptsd_memory_intrusion = 0.3;   ///< Memory intrusion probability per ms
     };
 
+    /**
+     * @brief Dynamical state (E, I, glutamate, GABA, adaptation) and its Jacobians
+     */
+    using DynamicsVector = Eigen::Matrix<double, 5, 1>;
+    using DynamicsMatrix = Eigen::Matrix<double, 5, 5>;
+
     /**
      * @brief Circuit activation state
      */
@@ -64,47 +116,175 @@ public:
         
         bool in_oscillation = false;          ///< Whether circuit is oscillating
         double oscillation_frequency = 0.0;   ///< Oscillation frequency (Hz)
+        std::array<double, OscillationDetector::BandCount> band_power{}; ///< Theta/alpha/beta/gamma power
         bool hyperexcitable = false;          ///< Hyperexcitability state
         bool inhibition_failure = false;      ///< Inhibitory control failure
         
         NeurotransmitterState neurotransmitters; ///< Neurotransmitter levels
         
         // Temporal dynamics
-        std::vector<double> activation_history; ///< Recent activation history
         double adaptation_level = 0.0;         ///< Current adaptation state
         double fatigue_level = 0.0;            ///< Neural fatigue level
     };
 
+    /**
+     * @brief Compact per-step record (see CircuitConfig::record_history)
+     */
+    struct StepRecord {
+        double timestamp = 0.0;               ///< Simulation time (ms)
+        float excitatory_activity = 0.0f;
+        float inhibitory_activity = 0.0f;
+        float net_activation = 0.0f;
+        float firing_rate = 0.0f;
+        float adaptation_level = 0.0f;
+        bool hyperexcitable = false;
+        bool inhibition_failure = false;
+        bool in_oscillation = false;
+    };
+
+    /**
+     * @brief Fixed point of the deterministic dynamics and its linear stability
+     */
+    struct SteadyStateAnalysis {
+        bool converged = false;               ///< A fixed point was found
+        DynamicsVector fixed_point = DynamicsVector::Zero(); ///< E, I, glutamate, GABA, adaptation
+        std::vector<std::complex<double>> eigenvalues; ///< Per-step multipliers, largest modulus first
+        double spectral_radius = 0.0;         ///< Largest multiplier modulus
+        double growth_rate = 0.0;             ///< Of the dominant mode, per ms (negative: decays)
+        double oscillation_frequency = 0.0;   ///< Of the dominant mode if complex (Hz)
+        bool stable = false;                  ///< Perturbations decay (spectral radius < 1)
+        bool oscillatory = false;             ///< Dominant mode rings (a limit cycle if not stable)
+        bool looping = false;                 ///< E/I above 2 at the fixed point (SimulationState looping)
+        bool hyperexcitable = false;          ///< Fixed point meets the hyperexcitability criterion
+    };
+
 public:
+    MicroCircuit();
+
     /**
      * @brief Constructor
      * @param config Circuit configuration
      */
-    explicit MicroCircuit(const CircuitConfig& config = CircuitConfig{});
+    explicit MicroCircuit(const CircuitConfig& config);
 
     /**
      * @brief Process input and update circuit state
      * @param input_strength Input activation strength
      * @param dt Time step in milliseconds
-     * @return Updated activation state
+     * @return Updated activation state (valid until the next call)
+     */
+    const ActivationState& process(double input_strength, double dt = 1.0);
+
+    /**
+     * @brief Advance an idle circuit over an input gap without stepping through it
+     *
+     * Stands for duration / dt calls of process(0.0, dt), as a linearized
+     * chunked relaxation rather than a closed-form solution. The start of
+     * the gap is stepped exactly without noise: one inhibition delay plus
+     * FAST_FORWARD_TRANSIENT_TAUS inhibitory time constants, then on until
+     * excitation moves less than FAST_FORWARD_TOLERANCE over one delay, at
+     * most FAST_FORWARD_TRANSIENT ms. With a delay line, glutamate and
+     * adaptation usually keep excitation moving for that whole span, so
+     * gaps shorter than about FAST_FORWARD_TRANSIENT cost as much as
+     * stepping them. After that the noise-free step map F over (E, I,
+     * glutamate, GABA, adaptation) is linearized at the start of each chunk
+     * of m steps (central-difference Jacobian, ten step evaluations),
+     * and the resulting affine map is applied m times (matrix power sums by
+     * repeated squaring). Chunks are checked against two half chunks and
+     * double while they agree, so beyond the transient the cost grows with
+     * log(duration / dt) once the circuit approaches its idle state. The
+     * linearized steps ignore the inhibition delay; the last delay-length
+     * of steps is taken exactly and refills the delay line. With the RK45
+     * integrator the chunks use the exponential scheme's map of the same
+     * equations, which is far cheaper to differentiate; the exact steps use
+     * RK45. Modulation expiries split the gap into
+     * segments. With inject_noise, one Gaussian sample per segment is added
+     * with the covariance that per-step noise (and PTSD intrusions) would
+     * accumulate through the linearized map. Detectors see the gap as a
+     * single sample.
+     *
+     * If the chunks stop growing, the rest of the segment is linearized
+     * around the idle fixed point (found by Newton iteration); without a
+     * stable one (e.g. the idle circuit oscillates) it is simulated step
+     * by step.
+     *
+     * @param duration Gap length in milliseconds
+     * @param dt Time step the gap stands for
+     * @param inject_noise Add moment-matched noise for the gap
+     * @return False if any part of the gap was simulated step by step
+     */
+    bool fastForward(double duration, double dt = 1.0, bool inject_noise = false);
+
+    /**
+     * @brief Solve for the steady state under constant input and classify its stability
+     *
+     * Damped Newton iteration on the noise-free step map (PTSD intrusions
+     * at their expected size), started from the current state and, failing
+     * that, from where it relaxes to (closed-form chunks as in fastForward).
+     * Stability follows from the eigenvalues of the step
+     * map's Jacobian at the fixed point, extended by the excitation history
+     * that delayed inhibition reads (delay rounded to whole steps), so
+     * delay-induced ringing is included. Costs a few hundred step
+     * evaluations and one eigenproblem of size 5 + delay / dt; the circuit
+     * is left unchanged.
+     *
+     * @param input_strength Constant input (active modulations are included)
+     * @param dt Time step of the analysed map
+     * @return Fixed point and stability (if converged is false, only the best
+     *         fixed-point estimate is set)
+     */
+    SteadyStateAnalysis analyzeSteadyState(double input_strength = 0.0, double dt = 1.0);
+
+    /**
+     * @brief Steady-state analysis of a configuration without simulating it
+     * @param config Circuit configuration (autism/PTSD modes applied)
      */
-    ActivationState process(double input_strength, double dt = 1.0);
+    static SteadyStateAnalysis analyzeSteadyState(const CircuitConfig& config, double input_strength = 0.0,
+                                                  double dt = 1.0);
 
     /**
      * @brief Apply external modulation (e.g., from other brain regions)
-     * @param modulation_type Type of modulation ("excitatory", "inhibitory", "neuromodulatory")
+     *
+     * Overlapping modulations add up; each costs O(log n) to schedule and
+     * to expire, and the per-step cost does not depend on how many are active.
+     *
+     * @param modulation_type Type of modulation
      * @param strength Modulation strength
      * @param duration Duration in milliseconds
      */
+    void applyModulation(ModulationType modulation_type, double strength, double duration = 100.0);
+
+    /**
+     * @brief Apply external modulation by name
+     * @param modulation_type "excitatory", "inhibitory" or "neuromodulatory" (others are ignored)
+     */
     void applyModulation(const std::string& modulation_type, double strength, double duration = 100.0);
 
     /**
      * @brief Simulate neurotransmitter release
-     * @param neurotransmitter Type ("glutamate", "gaba", "dopamine", etc.)
+     *
+     * Glutamate and GABA are raised at once and relax through the circuit
+     * dynamics; neuromodulators stay raised above baseline for the
+     * clearance time.
+     *
+     * @param neurotransmitter Neurotransmitter released
      * @param amount Release amount
+     * @param clearance_ms How long a neuromodulator release lasts
+     */
+    void releaseNeurotransmitter(Neurotransmitter neurotransmitter, double amount, double clearance_ms = 200.0);
+
+    /**
+     * @brief Simulate neurotransmitter release by name
+     * @param neurotransmitter "glutamate", "gaba", "dopamine", "serotonin",
+     *        "norepinephrine" or "acetylcholine" (others are ignored)
      */
     void releaseNeurotransmitter(const std::string& neurotransmitter, double amount);
 
+    /**
+     * @brief Total strength of the active modulations of a type
+     */
+    double getModulation(ModulationType modulation_type) const;
+
     /**
      * @brief Get current circuit state
      * @return Current activation state
@@ -140,40 +320,114 @@ public:
 
     /**
      * @brief Get activation history for analysis
-     * @return Vector of historical activation states
+     *
+     * Rebuilt from the compact step records; empty unless
+     * CircuitConfig::record_history is set.
+     *
+     * @return Historical activation states, oldest first
      */
     std::vector<ActivationState> getActivationHistory() const;
 
+    /**
+     * @brief Get the compact step records, oldest first
+     */
+    std::vector<StepRecord> getStepRecords() const;
+
+    /**
+     * @brief Get recent net activation, oldest first
+     */
+    std::vector<double> getNetActivationHistory() const;
+
+    /**
+     * @brief Get the streaming oscillation detector (band powers, frequency)
+     */
+    const OscillationDetector& getOscillationDetector() const { return oscillation_detector_; }
+
+    /**
+     * @brief Get the streaming pathological pattern detector
+     */
+    const PathologyDetector& getPathologyDetector() const { return pathology_detector_; }
+
     /**
      * @brief Detect pathological patterns in circuit activity
-     * @return Vector of detected pattern names
+     *
+     * Reads the streaming detector flags (constant time, no history scan).
+     *
+     * @return Vector of detected pattern names ("hyperexcitability",
+     *         "inhibition_failure", "seizure_activity", "memory_intrusion")
      */
     std::vector<std::string> detectPathologicalPatterns() const;
 
 private:
+    friend class MicroCircuitBank;
+
     CircuitConfig config_;
     ActivationState current_state_;
-    std::vector<ActivationState> activation_history_;
+    
+    // Fixed-size ring buffers (allocated once)
+    std::vector<double> net_history_;       // Net activation per step
+    size_t history_head_;                   // Next write position
+    size_t history_count_;
+    std::vector<StepRecord> step_records_;  // Optional compact log
+    size_t record_head_;
+    size_t record_count_;
+    OscillationDetector oscillation_detector_; // Sliding-DFT band power of net activation
+    PathologyDetector pathology_detector_;     // EWMA/line-length/CUSUM pattern flags
+    DelayLine excitatory_delay_;            // Excitation history seen by inhibition
+    NoiseGenerator noise_generator_;        // Per-circuit counter-based noise stream
     
     // Temporal dynamics
     double current_time_;
-    std::vector<std::pair<double, double>> pending_modulations_; // (end_time, strength)
+    double rk45_step_;                      // Last accepted RK45 substep (ms), warm start
+    ModulationScheduler modulations_;       // Modulation types, then neuromodulator releases
+    enum class StepMode {
+        Stochastic,     // Normal steps
+        NoiseFree,      // No noise, expected PTSD intrusion
+        Linearized,     // As NoiseFree, with undelayed inhibition and the delay line untouched
+        Held            // As Linearized, with inhibition seeing held_excitation_
+    };
+    StepMode step_mode_;                    // fastForward's deterministic step maps
+    double linearized_excitation_;          // Excitation a Linearized step would have pushed
+    double held_excitation_;                // Delayed excitation seen by Held steps
     
     // Internal processing methods
     void updateExcitatoryActivity(double input_strength, double dt);
     void updateInhibitoryActivity(double dt);
     void updateNeurotransmitters(double dt);
     void applyAdaptation(double dt);
+    void integrateAdaptive(double input_strength, double dt);
+    void advanceDynamics(double drive, double dt);
+    void pushExcitation();
+    DynamicsVector dynamicsState() const;
+    void setDynamicsState(const DynamicsVector& state);
+    DynamicsVector deterministicStep(StepMode mode, const DynamicsVector& state, double drive, double dt);
+    DynamicsVector idleStep(const DynamicsVector& state, double drive, double dt);
+    size_t relaxIdle(DynamicsVector& state, size_t steps, double drive, double dt);
+    DynamicsMatrix idleJacobian(const DynamicsVector& state, double drive, double dt);
+    bool idleFixedPoint(const DynamicsVector& start, double drive, double dt,
+                        DynamicsVector& fixed_point, DynamicsMatrix& jacobian);
+    DynamicsMatrix idleNoiseCovariance(double dt) const;
+    double relaxationFactor(double dt, double tau) const;
+    double inhibitionTau() const;
+    double inhibitionDelay() const;
+    double adaptationDecayRate(double adaptation_level) const;
+    double stepGain(double gain, double dt) const;
+    double excitationGainRate() const;
+    double inhibitionGainRate() const;
+    static double exponentialUpdate(double value, double source, double rate, double dt);
+    double intrusionProbability(double dt) const;
     void addNoise(double dt);
+    void updateNeuromodulatorLevels();
+    static size_t modulationChannel(Neurotransmitter neurotransmitter);
     
     // Autism-specific processing
-    void applyAutismModifications();
+    void applyAutismModifications(double dt);
     
     // PTSD-specific processing
-    void applyPTSDModifications();
+    void applyPTSDModifications(double dt);
     
     // Oscillation detection and analysis
-    void detectOscillations();
+    void detectOscillations(double dt);
     double calculateOscillationFrequency() const;
     
     // Pathological pattern detection
@@ -187,11 +441,22 @@ private:
     double applyActivationFunction(double input) const;
     void updateActivationHistory();
     void pruneOldHistory();
+    double recentNetActivation(size_t age) const;  // age 0 = newest
     
     // Constants
     static constexpr double MAX_FIRING_RATE = 200.0; // Hz
     static constexpr double HISTORY_LENGTH = 1000.0; // ms
     static constexpr size_t MAX_HISTORY_SIZE = 1000;
+    static constexpr size_t MODULATION_CHANNELS = 7; // 3 modulation types + 4 neuromodulators
+    static constexpr size_t FAST_FORWARD_CHUNKS = 256;      // Relaxation chunks per segment before stepping
+    static constexpr double FAST_FORWARD_TRANSIENT = 500.0; // Longest span at the start of a gap stepped exactly (ms)
+    static constexpr double FAST_FORWARD_TRANSIENT_TAUS = 5.0; // Inhibitory time constants (after one delay) always stepped exactly
+    static constexpr double FAST_FORWARD_TOLERANCE = 1e-2;  // Chunk vs. two half chunks, relative to its movement
+    static constexpr double FIXED_POINT_TOLERANCE = 1e-4;   // Step residual |F(x) - x| of an accepted fixed point
+    static constexpr double ANALYSIS_HORIZON = 3.6e6;       // Relaxation before retrying the steady-state solve (ms)
+    static constexpr double ANALYSIS_TOLERANCE = 1e-6;      // Newton correction of a converged steady state (relative)
+    static constexpr double DETERMINISTIC_RK45_TOLERANCE = 1e-10; // RK45 error target of the differentiated step maps
+    static constexpr double RK45_MIN_STEP = 1e-6;           // Smallest RK45 substep (ms); accepted regardless of error
 };
 
 /**
@@ -211,10 +476,16 @@ public:
         double activation_threshold = 0.5;
         double max_activation = 1.0;
         std::vector<std::string> connected_regions;
+        bool spiking_population = false;      ///< Also run a LIF population and read activation from it
+        SpikingPopulation::PopulationConfig population_config;
     };
 
     /**
      * @brief Constructor
+     *
+     * A circuit config without a noise stream gets one hashed from the
+     * region name, so regions sharing a noise seed draw independent noise.
+     *
      * @param config Region configuration
      */
     explicit BrainRegion(const RegionConfig& config);
@@ -226,11 +497,29 @@ public:
 
     /**
      * @brief Process region-specific input
+     *
+     * The generic region drives its microcircuit and follows the input,
+     * bounded by max_activation.
+     *
      * @param input Input activation
      * @param dt Time step
      * @return Region activation level
      */
-    virtual double processInput(double input, double dt = 1.0) = 0;
+    virtual double processInput(double input, double dt = 1.0);
+
+    /**
+     * @brief Process input together with the fused sensory context
+     *
+     * The context is passed by reference (no copy or allocation). Regions
+     * that do not use it fall back to the scalar overload.
+     *
+     * @param input Input activation (routed drive)
+     * @param context Fused multimodal embedding for this step
+     * @param dt Time step
+     * @return Region activation level
+     */
+    virtual double processInput(double input, const Eigen::Ref<const Eigen::VectorXd>& context,
+                                double dt = 1.0);
 
     /**
      * @brief Get region name
@@ -238,23 +527,108 @@ public:
      */
     const std::string& getName() const { return config_.region_name; }
 
+    /**
+     * @brief Get region configuration
+     */
+    const RegionConfig& getConfig() const { return config_; }
+
     /**
      * @brief Get current activation level
+     *
+     * With a spiking population this is its excitatory rate readout.
+     *
      * @return Current activation (0-1)
      */
-    double getCurrentActivation() const { return current_activation_; }
+    double getCurrentActivation() const {
+        return spiking_population_ ? spiking_population_->getActivation() : current_activation_;
+    }
+
+    /**
+     * @brief Get the spiking population (null unless enabled in RegionConfig)
+     */
+    const SpikingPopulation* getSpikingPopulation() const { return spiking_population_.get(); }
 
     /**
      * @brief Get microcircuit state
+     *
+     * For a region attached to a bank this is a snapshot of its slot
+     * (no history).
+     *
      * @return Current microcircuit state
      */
     const MicroCircuit::ActivationState& getMicrocircuitState() const;
 
+    /**
+     * @brief Back this region's microcircuit with a slot in a shared bank
+     *
+     * The region becomes a view of the slot: it only stages its drive in
+     * the bank, and the bank owner advances all circuits at once with
+     * MicroCircuitBank::step(). Its own MicroCircuit, with state history,
+     * modulations and oscillation/pathology detection, is released, and
+     * its noise comes from the bank's seed instead of its own stream.
+     *
+     * @param bank Bank that owns and steps the circuit state
+     * @return False (region unchanged) if the bank refuses the circuit
+     * configuration or the region is already attached
+     */
+    bool attachToBank(const std::shared_ptr<MicroCircuitBank>& bank);
+
+    /**
+     * @brief Let the owner advance the microcircuit once per tick
+     *
+     * processInput then only stages its drive; the owner adds network
+     * input with stageInput() and advances every region with
+     * stepMicrocircuit(), so regions without a routed drive still evolve.
+     *
+     * @param deferred Stage drives instead of stepping in processInput
+     */
+    void setDeferredStepping(bool deferred);
+
+    /**
+     * @brief Add input for the next stepMicrocircuit() call
+     */
+    void stageInput(double input) { staged_input_ += input; }
+
+    /**
+     * @brief Advance the microcircuit with the staged input, then clear it
+     *
+     * A region attached to a bank moves the staged input to its slot
+     * instead; the bank owner steps it.
+     *
+     * @param dt Time step in milliseconds
+     */
+    void stepMicrocircuit(double dt);
+
+    /**
+     * @brief Advance the microcircuit across a gap without input
+     *
+     * Drops any staged input and fast-forwards with moment-matched noise
+     * (see MicroCircuit::fastForward), through its bank slot when attached
+     * (see MicroCircuitBank::fastForward).
+     *
+     * @param duration Gap length in milliseconds
+     * @param dt Time step the gap stands for
+     * @return False if part of the gap had to be stepped
+     */
+    bool idleMicrocircuit(double duration, double dt);
+
 protected:
     RegionConfig config_;
-    std::unique_ptr<MicroCircuit> microcircuit_;
+    std::unique_ptr<MicroCircuit> microcircuit_;  // Null when attached to a bank
+    std::shared_ptr<MicroCircuitBank> circuit_bank_;
+    size_t bank_slot_;
+    mutable MicroCircuit::ActivationState bank_state_; // Snapshot of the bank slot
+    std::unique_ptr<SpikingPopulation> spiking_population_;
     double current_activation_;
     double current_time_;
+    bool deferred_stepping_;
+    double staged_input_;     // Drive and network input since the last step
+
+    /**
+     * @brief Drive the microcircuit (steps it, or stages the input in the
+     * bank or when stepping is deferred) and the spiking population, if any
+     */
+    void driveMicrocircuit(double input, double dt);
 };
 
 } // namespace neurosim
@@ -0,0 +1,291 @@
+#include "microcircuit_bank.hpp"
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace neurosim {
+
+namespace {
+// Same convention as CircuitConfig::noise_seed: 0 draws a nondeterministic seed
+uint64_t resolveSeed(uint64_t seed) {
+    if (seed != 0) {
+        return seed;
+    }
+    std::random_device rd;
+    return (static_cast<uint64_t>(rd()) << 32) | rd();
+}
+}
+
+MicroCircuitBank::MicroCircuitBank(uint64_t seed, uint64_t stream)
+    : size_(0), gain_dt_(std::numeric_limits<double>::quiet_NaN()), current_time_(0.0),
+      seed_(resolveSeed(seed)), fast_forwards_(0), noise_generator_(seed_, stream) {
+}
+
+bool MicroCircuitBank::supports(const MicroCircuit::CircuitConfig& config) {
+    return config.integrator == IntegrationMethod::Euler;
+}
+
+bool MicroCircuitBank::accepts(const MicroCircuit::CircuitConfig& config) const {
+    // A seeded circuit only joins a bank drawing from the same seed
+    return supports(config) && (config.noise_seed == 0 || config.noise_seed == seed_);
+}
+
+size_t MicroCircuitBank::add(const MicroCircuit::CircuitConfig& config) {
+    if (!accepts(config)) {
+        return npos;
+    }
+
+    // Geometric growth keeps a run of adds linear; step() trims the spare slots
+    Eigen::Index slot = size_;
+    if (slot == excitatory_.size()) {
+        resizeAll(std::max<Eigen::Index>(8, 2 * slot));
+    }
+    size_ = slot + 1;
+    excitatory_delay_.resize(size_);
+    configs_.push_back(config);
+    writeParameters(slot, config);
+
+    // Same initial state as a freshly constructed MicroCircuit
+    excitatory_(slot) = config.baseline_excitation;
+    inhibitory_(slot) = config.baseline_inhibition;
+    net_activation_(slot) = 0.0;
+    firing_rate_(slot) = 0.0;
+    glutamate_(slot) = 1.0;
+    gaba_(slot) = 1.0;
+    adaptation_(slot) = 0.0;
+    hyperexcitable_(slot) = false;
+    inhibition_failure_(slot) = false;
+    inputs_(slot) = 0.0;
+    excitatory_delay_.fill(slot, excitatory_(slot));
+    return static_cast<size_t>(slot);
+}
+
+void MicroCircuitBank::reserve(size_t count) {
+    Eigen::Index capacity = static_cast<Eigen::Index>(count);
+    if (capacity > excitatory_.size()) {
+        resizeAll(capacity);
+        excitatory_delay_.reserve(capacity);
+        configs_.reserve(count);
+    }
+}
+
+void MicroCircuitBank::configure(size_t slot, const MicroCircuit::CircuitConfig& config) {
+    if (slot < size() && accepts(config)) {
+        configs_[slot] = config;
+        writeParameters(static_cast<Eigen::Index>(slot), config);
+    }
+}
+
+void MicroCircuitBank::reset(size_t slot) {
+    if (slot >= size()) {
+        return;
+    }
+
+    Eigen::Index i = static_cast<Eigen::Index>(slot);
+    excitatory_(i) = baseline_excitation_(i);
+    inhibitory_(i) = baseline_inhibition_(i);
+    net_activation_(i) = 0.0;
+    firing_rate_(i) = 0.0;
+    glutamate_(i) = 1.0;
+    gaba_(i) = 1.0;
+    adaptation_(i) = 0.0;
+    hyperexcitable_(i) = false;
+    inhibition_failure_(i) = false;
+    inputs_(i) = 0.0;
+    excitatory_delay_.fill(i, excitatory_(i));
+}
+
+void MicroCircuitBank::step(double dt) {
+    if (size_ == 0) {
+        return;
+    }
+    if (excitatory_.size() != size_) {
+        // Array expressions below cover every entry, so drop the spare capacity once
+        resizeAll(size_);
+    }
+    current_time_ += dt;
+    updateStepGains(dt);
+
+    // Excitatory activity: exponential approach to glutamate-modulated target
+    excitatory_ += ((baseline_excitation_ + inputs_ * glutamate_) * ei_ratio_ - excitatory_) * (dt / 10.0);
+    excitatory_ = excitatory_.max(0.0).min(5.0);
+
+    // Inhibitory activity follows excitation seen through the (PTSD-lengthened) delay
+    excitatory_delay_.configure(dt);
+    excitatory_delay_.push(excitatory_);
+    excitatory_delay_.read(delayed_excitatory_);
+    inhibitory_ += (delayed_excitatory_ * gaba_ - inhibitory_) * dt * inverse_tau_inhibition_;
+    inhibitory_ = (inhibitory_ * inhibition_gain_).max(0.0).min(3.0);
+
+    // Neurotransmitters
+    glutamate_ += (1.0 + excitatory_ * 0.2 - glutamate_) * (dt / 100.0);
+    gaba_ += (1.0 + inhibitory_ * 0.15 - gaba_) * (dt / 100.0);
+    glutamate_ = glutamate_.max(0.1).min(2.0);
+    gaba_ = gaba_.max(0.1).min(2.0);
+
+    // Net activation and firing rate
+    net_activation_ = excitatory_ - inhibitory_;
+    sigmoid(net_activation_, firing_rate_);
+    firing_rate_ *= MicroCircuit::MAX_FIRING_RATE;
+
+    // Adaptation
+    adaptation_ += (firing_rate_ * 0.1 - adaptation_) * (dt / 500.0);
+    // Retention is per ms (MicroCircuit::stepGain); dt = 1 skips the pow
+    if (dt == 1.0) {
+        excitatory_ *= (1.0 - adaptation_ * adaptation_rate_).max(1e-12);
+    } else {
+        excitatory_ *= ((1.0 - adaptation_ * adaptation_rate_).max(1e-12).log() * dt).exp();
+    }
+
+    // Noise: one block of normals per population per step
+    noise_generator_.fill(excitatory_noise_);
+    noise_generator_.fill(inhibitory_noise_);
+    double noise_scale = std::sqrt(dt);
+    excitatory_ = (excitatory_ + excitatory_noise_ * noise_level_ * noise_scale).max(0.0);
+    inhibitory_ = (inhibitory_ + inhibitory_noise_ * noise_level_ * (noise_scale * 0.5)).max(0.0);
+
+    // Autism/PTSD modifications (scales are 1 and probabilities 0 when disabled)
+    excitatory_ *= excitation_gain_;
+    inhibitory_ *= inhibition_gain_;
+    if ((intrusion_rate_ > 0.0).any()) {
+        noise_generator_.fillUniform(intrusion_draw_);
+        excitatory_ += (intrusion_draw_ < intrusion_probability_).cast<double>();
+    }
+
+    // Pathological state flags
+    hyperexcitable_ = (excitatory_ > 3.0) || (excitatory_ / inhibitory_.max(0.1) > 3.0);
+    inhibition_failure_ = (inhibitory_ < 0.2) && (excitatory_ > 1.0);
+
+    inputs_.setZero();
+}
+
+bool MicroCircuitBank::fastForward(size_t slot, double duration, double dt) {
+    if (slot >= size() || duration <= 0.0 || dt <= 0.0) {
+        return true;
+    }
+
+    // Scratch circuit with the slot's configuration; its noise stream is kept
+    // apart from the streams banks step with
+    Eigen::Index i = static_cast<Eigen::Index>(slot);
+    MicroCircuit::CircuitConfig config = configs_[slot];
+    config.noise_seed = seed_;
+    config.noise_stream = (uint64_t{1} << 63) | fast_forwards_++;
+    MicroCircuit circuit(config);
+
+    auto& state = circuit.current_state_;
+    state.excitatory_activity = excitatory_(i);
+    state.inhibitory_activity = inhibitory_(i);
+    state.neurotransmitters.glutamate_level = glutamate_(i);
+    state.neurotransmitters.gaba_level = gaba_(i);
+    state.adaptation_level = adaptation_(i);
+
+    // Excitation history, oldest first, on the bank's spacing
+    double history_dt = excitatory_delay_.timeStep();
+    circuit.excitatory_delay_.configure(circuit.inhibitionDelay(), history_dt);
+    for (size_t age = circuit.excitatory_delay_.capacity(); age-- > 0;) {
+        circuit.excitatory_delay_.push(excitatory_delay_.sample(i, age));
+    }
+
+    bool closed_form = circuit.fastForward(duration, dt, true);
+
+    excitatory_(i) = state.excitatory_activity;
+    inhibitory_(i) = state.inhibitory_activity;
+    net_activation_(i) = state.net_activation;
+    firing_rate_(i) = state.firing_rate;
+    glutamate_(i) = state.neurotransmitters.glutamate_level;
+    gaba_(i) = state.neurotransmitters.gaba_level;
+    adaptation_(i) = state.adaptation_level;
+    hyperexcitable_(i) = state.hyperexcitable;
+    inhibition_failure_(i) = state.inhibition_failure;
+    inputs_(i) = 0.0;
+    for (size_t age = 0; age < excitatory_delay_.capacity(); ++age) {
+        excitatory_delay_.setSample(i, age, circuit.excitatory_delay_.read(static_cast<double>(age) * history_dt));
+    }
+    return closed_form;
+}
+
+void MicroCircuitBank::getState(size_t slot, MicroCircuit::ActivationState& state) const {
+    if (slot >= size()) {
+        return;
+    }
+
+    Eigen::Index i = static_cast<Eigen::Index>(slot);
+    state.excitatory_activity = excitatory_(i);
+    state.inhibitory_activity = inhibitory_(i);
+    state.net_activation = net_activation_(i);
+    state.firing_rate = firing_rate_(i);
+    state.hyperexcitable = hyperexcitable_(i);
+    state.inhibition_failure = inhibition_failure_(i);
+    state.neurotransmitters.glutamate_level = glutamate_(i);
+    state.neurotransmitters.gaba_level = gaba_(i);
+    state.adaptation_level = adaptation_(i);
+}
+
+void MicroCircuitBank::sigmoid(const Eigen::Ref<const Array>& x, Eigen::Ref<Array> out) {
+    out = (1.0 + (-x).exp()).inverse();
+}
+
+void MicroCircuitBank::resizeAll(Eigen::Index size) {
+    for (Array* array : {&excitatory_, &inhibitory_, &net_activation_, &firing_rate_, &glutamate_,
+                         &gaba_, &adaptation_, &inputs_, &baseline_excitation_, &baseline_inhibition_,
+                         &ei_ratio_, &inverse_tau_inhibition_, &inhibition_rate_, &excitation_rate_,
+                         &intrusion_rate_, &inhibition_gain_, &excitation_gain_,
+                         &intrusion_probability_, &adaptation_rate_, &noise_level_,
+                         &excitatory_noise_, &inhibitory_noise_, &intrusion_draw_, &delayed_excitatory_}) {
+        array->conservativeResize(size);
+    }
+    hyperexcitable_.conservativeResize(size);
+    inhibition_failure_.conservativeResize(size);
+    gain_dt_ = std::numeric_limits<double>::quiet_NaN();
+}
+
+void MicroCircuitBank::updateStepGains(double dt) {
+    // Per-ms rates turned into this step's factors; recomputed only when dt changes
+    if (dt == gain_dt_) {
+        return;
+    }
+    gain_dt_ = dt;
+    excitation_gain_ = (excitation_rate_ * dt).exp();
+    inhibition_gain_ = (inhibition_rate_ * dt).exp();
+    intrusion_probability_ = -(-intrusion_rate_ * dt).expm1();
+}
+
+void MicroCircuitBank::writeParameters(Eigen::Index slot, const MicroCircuit::CircuitConfig& config) {
+    double baseline_excitation = config.baseline_excitation;
+    double baseline_inhibition = config.baseline_inhibition;
+    double ei_ratio = config.ei_ratio;
+    double delay = config.inhibition_delay_ms;
+    double inhibition_rate = 0.0;
+    double excitation_rate = 0.0;
+    double intrusion_rate = 0.0;
+
+    // Mirrors MicroCircuit::enableAutismMode/enablePTSDMode and the per-step modifications
+    if (config.autism_mode) {
+        ei_ratio = config.autism_ei_elevation;
+        baseline_inhibition *= config.autism_inhibition_deficit;
+        inhibition_rate = std::log(std::max(1e-12, config.autism_inhibition_deficit));
+        excitation_rate += std::log(std::max(1e-12, config.autism_ei_elevation));
+    }
+    if (config.ptsd_mode) {
+        delay = config.ptsd_inhibition_delay;
+        baseline_excitation *= config.ptsd_hyperarousal;
+        excitation_rate += std::log(std::max(1e-12, config.ptsd_hyperarousal));
+        double intrusion = std::max(0.0, std::min(1.0, config.ptsd_memory_intrusion));
+        intrusion_rate = intrusion < 1.0 ? -std::log1p(-intrusion) : 1e300;
+    }
+
+    baseline_excitation_(slot) = baseline_excitation;
+    baseline_inhibition_(slot) = baseline_inhibition;
+    ei_ratio_(slot) = ei_ratio;
+    // Delay line or, without one, a slower inhibitory response
+    inverse_tau_inhibition_(slot) = 1.0 / (20.0 + (config.inhibition_delay_line ? 0.0 : delay));
+    excitatory_delay_.setDelay(slot, config.inhibition_delay_line ? delay : 0.0);
+    inhibition_rate_(slot) = inhibition_rate;
+    excitation_rate_(slot) = excitation_rate;
+    intrusion_rate_(slot) = intrusion_rate;
+    gain_dt_ = std::numeric_limits<double>::quiet_NaN();
+    adaptation_rate_(slot) = config.adaptation_rate;
+    noise_level_(slot) = config.noise_level;
+}
+
+} // namespace neurosim
@@ -0,0 +1,201 @@
+#pragma once
+
+#include "microcircuit.hpp"
+#include "delay_line.hpp"
+#include "noise_generator.hpp"
+#include <vector>
+#include <Eigen/Dense>
+
+namespace neurosim {
+
+/**
+ * @brief Structure-of-arrays store of many microcircuits stepped together
+ *
+ * Holds excitatory/inhibitory activity, neurotransmitter and adaptation
+ * state of N circuits in contiguous, aligned Eigen arrays and advances all
+ * of them with one set of array expressions per step. Eigen lowers these to
+ * SSE/AVX2/AVX-512 packets depending on the target flags (see the
+ * NEUROSIM_NATIVE_SIMD build option), including the sigmoid used for the
+ * firing rate.
+ *
+ * This is the batched engine behind parameter sweeps and, when every
+ * region uses the Euler integrator, behind the simulator's regions (see
+ * BrainRegion::attachToBank). Its step is the same as MicroCircuit::process
+ * with the Euler integrator (including autism/PTSD modifications), which
+ * the region dynamics tests check step by step. It has no modulations,
+ * oscillation/pathology detection, and add() refuses configurations with
+ * another integrator (see supports()). Idle gaps are skipped per slot with
+ * fastForward(). Inputs are staged per slot and consumed by the next
+ * step(), so circuits without staged input receive zero drive. Noise for
+ * all circuits is generated as one block per step by a counter-based
+ * NoiseGenerator under the bank's seed: each slot draws its own entries of
+ * the block, so slots are independent and a seeded bank is deterministic,
+ * but a slot's noise is not the sequence its own MicroCircuit would draw
+ * (CircuitConfig::noise_stream is not used).
+ *
+ * Storage grows geometrically as circuits are added (or once, with
+ * reserve()), and the first step() after adding trims it to size(), so
+ * building a bank of N circuits is O(N).
+ */
+class MicroCircuitBank {
+public:
+    using Array = Eigen::ArrayXd;
+    using Mask = Eigen::Array<bool, Eigen::Dynamic, 1>;
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+public:
+    /**
+     * @brief Constructor
+     * @param seed Seed for the bank's noise generator (0 = nondeterministic, as CircuitConfig::noise_seed)
+     * @param stream Noise stream (banks sharing a seed draw independent noise per stream)
+     */
+    explicit MicroCircuitBank(uint64_t seed = 0, uint64_t stream = 0);
+
+    /**
+     * @brief Whether the bank reproduces a circuit configuration
+     * @return True for the Euler integrator
+     */
+    static bool supports(const MicroCircuit::CircuitConfig& config);
+
+    /**
+     * @brief Add a circuit
+     * @param config Circuit configuration (autism/PTSD modes applied as in MicroCircuit)
+     * @return Slot index of the new circuit, or npos if !supports(config) or
+     * the config sets a noise_seed other than the bank's
+     */
+    size_t add(const MicroCircuit::CircuitConfig& config);
+
+    /**
+     * @brief Make room for count circuits so that adding them reallocates nothing
+     */
+    void reserve(size_t count);
+
+    /**
+     * @brief Replace the configuration of a circuit without resetting its state
+     *
+     * Ignored if add() would refuse the config.
+     */
+    void configure(size_t slot, const MicroCircuit::CircuitConfig& config);
+
+    /**
+     * @brief Reset a circuit to its baseline state
+     */
+    void reset(size_t slot);
+
+    /**
+     * @brief Stage input for the next step (accumulates)
+     */
+    void addInput(size_t slot, double input) { inputs_(static_cast<Eigen::Index>(slot)) += input; }
+
+    /**
+     * @brief Staged inputs for all circuits (writable)
+     */
+    Eigen::VectorBlock<Array> inputs() { return inputs_.head(size_); }
+
+    /**
+     * @brief Advance every circuit by one time step using the staged inputs
+     * @param dt Time step in milliseconds
+     */
+    void step(double dt = 1.0);
+
+    /**
+     * @brief Advance one circuit over an idle gap without stepping through it
+     *
+     * The slot's state and delay history are loaded into a scratch
+     * MicroCircuit with the slot's configuration, which runs
+     * MicroCircuit::fastForward with moment-matched noise (under the bank's
+     * seed, on a stream of its own per call); the result is written back.
+     * getCurrentTime() is not advanced.
+     *
+     * @param slot Circuit to advance
+     * @param duration Gap length in milliseconds
+     * @param dt Time step the gap stands for
+     * @return False if part of the gap had to be stepped (see MicroCircuit::fastForward)
+     */
+    bool fastForward(size_t slot, double duration, double dt = 1.0);
+
+    /**
+     * @brief Copy a circuit's state into an ActivationState (no history)
+     */
+    void getState(size_t slot, MicroCircuit::ActivationState& state) const;
+
+    /**
+     * @brief Vectorized logistic function
+     * @param x Input
+     * @param out Output, 1 / (1 + exp(-x))
+     */
+    static void sigmoid(const Eigen::Ref<const Array>& x, Eigen::Ref<Array> out);
+
+    size_t size() const { return static_cast<size_t>(size_); }
+    uint64_t seed() const { return seed_; }
+    size_t capacity() const { return static_cast<size_t>(excitatory_.size()); }
+    double getCurrentTime() const { return current_time_; }
+
+    Eigen::VectorBlock<const Array> excitatory() const { return excitatory_.head(size_); }
+    Eigen::VectorBlock<const Array> inhibitory() const { return inhibitory_.head(size_); }
+    Eigen::VectorBlock<const Array> netActivation() const { return net_activation_.head(size_); }
+    Eigen::VectorBlock<const Array> firingRate() const { return firing_rate_.head(size_); }
+    Eigen::VectorBlock<const Array> glutamate() const { return glutamate_.head(size_); }
+    Eigen::VectorBlock<const Array> gaba() const { return gaba_.head(size_); }
+    Eigen::VectorBlock<const Array> adaptation() const { return adaptation_.head(size_); }
+    Eigen::VectorBlock<const Mask> hyperexcitable() const { return hyperexcitable_.head(size_); }
+    Eigen::VectorBlock<const Mask> inhibitionFailure() const { return inhibition_failure_.head(size_); }
+
+private:
+    Eigen::Index size_;              // Circuits in use; arrays may hold spare capacity until step()
+
+    // Circuit state
+    Array excitatory_;
+    Array inhibitory_;
+    Array net_activation_;
+    Array firing_rate_;
+    Array glutamate_;
+    Array gaba_;
+    Array adaptation_;
+    Mask hyperexcitable_;
+    Mask inhibition_failure_;
+    Array inputs_;
+
+    // Per-circuit parameters (modes folded into per-ms rates)
+    Array baseline_excitation_;
+    Array baseline_inhibition_;
+    Array ei_ratio_;
+    Array inverse_tau_inhibition_;   // 1 / 20 (1 / (20 + delay) without a delay line)
+    Array inhibition_rate_;          // ln(autism inhibition deficit) (0 otherwise)
+    Array excitation_rate_;          // ln(autism E/I elevation * PTSD hyperarousal)
+    Array intrusion_rate_;           // -ln(1 - PTSD intrusion probability) (0 otherwise)
+    Array adaptation_rate_;
+    Array noise_level_;
+
+    // Rates as factors for a step of gain_dt_
+    Array inhibition_gain_;
+    Array excitation_gain_;
+    Array intrusion_probability_;
+    double gain_dt_;                 // NaN when the factors are stale
+
+    // Excitation history seen by inhibition (per-slot delays)
+    DelayLineBank excitatory_delay_;
+
+    // Slot configurations, for fastForward()'s scratch circuits
+    std::vector<MicroCircuit::CircuitConfig> configs_;
+
+    // Scratch arrays
+    Array excitatory_noise_;
+    Array inhibitory_noise_;
+    Array intrusion_draw_;
+    Array delayed_excitatory_;
+
+    double current_time_;
+    uint64_t seed_;                  // Resolved noise seed
+    uint64_t fast_forwards_;         // Scratch circuits created; numbers their noise streams
+    NoiseGenerator noise_generator_;
+
+    bool accepts(const MicroCircuit::CircuitConfig& config) const;
+
+    void resizeAll(Eigen::Index size);
+    void updateStepGains(double dt);
+    void writeParameters(Eigen::Index slot, const MicroCircuit::CircuitConfig& config);
+};
+
+} // namespace neurosim
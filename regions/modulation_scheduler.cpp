@@ -0,0 +1,46 @@
+#include "modulation_scheduler.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace neurosim {
+
+ModulationScheduler::ModulationScheduler(size_t channels) : totals_(channels, 0.0) {
+}
+
+void ModulationScheduler::schedule(size_t channel, double strength, double expiry_time) {
+    if (channel >= totals_.size()) {
+        return;
+    }
+
+    heap_.push_back({expiry_time, strength, static_cast<uint32_t>(channel)});
+    std::push_heap(heap_.begin(), heap_.end(), expiresLater);
+    totals_[channel] += strength;
+}
+
+void ModulationScheduler::advance(double time) {
+    while (!heap_.empty() && heap_.front().expiry_time <= time) {
+        std::pop_heap(heap_.begin(), heap_.end(), expiresLater);
+        totals_[heap_.back().channel] -= heap_.back().strength;
+        heap_.pop_back();
+
+        if (heap_.empty()) {
+            std::fill(totals_.begin(), totals_.end(), 0.0);
+        }
+    }
+}
+
+void ModulationScheduler::clear() {
+    heap_.clear();
+    std::fill(totals_.begin(), totals_.end(), 0.0);
+}
+
+bool ModulationScheduler::expiresLater(const Event& a, const Event& b) {
+    // std heap algorithms keep the largest element first; invert for a min-heap
+    return a.expiry_time > b.expiry_time;
+}
+
+double ModulationScheduler::nextExpiry() const {
+    return heap_.empty() ? std::numeric_limits<double>::infinity() : heap_.front().expiry_time;
+}
+
+} // namespace neurosim
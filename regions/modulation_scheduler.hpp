@@ -0,0 +1,74 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace neurosim {
+
+/**
+ * @brief Expiry-ordered store of timed additive modulations
+ *
+ * Each modulation adds a strength to one of a fixed number of channels
+ * until its expiry time. Pending modulations sit in a binary min-heap keyed
+ * by expiry, and the active total of every channel is kept incrementally:
+ * - schedule(): O(log n), adds to the channel total
+ * - advance(): O(log n) per expired modulation, O(1) when none expire
+ * - total(): O(1)
+ * Totals are reset to exactly zero whenever the heap drains, so repeated
+ * add/subtract rounding cannot accumulate.
+ */
+class ModulationScheduler {
+public:
+    /**
+     * @brief Constructor
+     * @param channels Number of independent modulation channels
+     */
+    explicit ModulationScheduler(size_t channels = 1);
+
+    /**
+     * @brief Add a modulation
+     * @param channel Channel index (ignored if out of range)
+     * @param strength Added to the channel total while active
+     * @param expiry_time Time at which the modulation ends (ms)
+     */
+    void schedule(size_t channel, double strength, double expiry_time);
+
+    /**
+     * @brief Remove every modulation that has expired by the given time
+     * @param time Current time (ms); modulations with expiry <= time end
+     */
+    void advance(double time);
+
+    /**
+     * @brief Drop all modulations
+     */
+    void clear();
+
+    /**
+     * @brief Sum of active modulation strengths on a channel
+     */
+    double total(size_t channel) const { return channel < totals_.size() ? totals_[channel] : 0.0; }
+
+    /**
+     * @brief Earliest pending expiry (infinity if none)
+     */
+    double nextExpiry() const;
+
+    size_t pending() const { return heap_.size(); }
+    size_t channels() const { return totals_.size(); }
+
+private:
+    struct Event {
+        double expiry_time;
+        double strength;
+        uint32_t channel;
+    };
+
+    std::vector<Event> heap_;     // Min-heap by expiry_time
+    std::vector<double> totals_;
+
+    static bool expiresLater(const Event& a, const Event& b);
+};
+
+} // namespace neurosim
@@ -0,0 +1,151 @@
+#include "noise_generator.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace neurosim {
+
+namespace {
+// Philox4x32 round multipliers and Weyl key increments
+constexpr uint32_t PHILOX_M0 = 0xD2511F53u;
+constexpr uint32_t PHILOX_M1 = 0xCD9E8D57u;
+constexpr uint32_t PHILOX_W0 = 0x9E3779B9u;
+constexpr uint32_t PHILOX_W1 = 0xBB67AE85u;
+constexpr int PHILOX_ROUNDS = 10;
+
+inline void philoxRound(uint32_t& c0, uint32_t& c1, uint32_t& c2, uint32_t& c3, uint32_t k0, uint32_t k1) {
+    uint64_t p0 = static_cast<uint64_t>(PHILOX_M0) * c0;
+    uint64_t p1 = static_cast<uint64_t>(PHILOX_M1) * c2;
+    uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+    uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+    c1 = static_cast<uint32_t>(p1);
+    c3 = static_cast<uint32_t>(p0);
+    c0 = n0;
+    c2 = n2;
+}
+
+// 53 random bits mapped to the open interval (0, 1)
+inline double toUniform(uint32_t high, uint32_t low) {
+    uint64_t bits = ((static_cast<uint64_t>(high) << 32) | low) >> 11;
+    return (static_cast<double>(bits) + 0.5) * (1.0 / 9007199254740992.0);
+}
+}
+
+NoiseGenerator::NoiseGenerator(uint64_t seed, uint64_t stream)
+    : key_{0, 0}, stream_(0), counter_(0), block_(BLOCK_SIZE), block_position_(BLOCK_SIZE) {
+    reseed(seed, stream);
+}
+
+void NoiseGenerator::reseed(uint64_t seed, uint64_t stream) {
+    key_ = {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+    stream_ = stream;
+    counter_ = 0;
+    block_position_ = block_.size();
+}
+
+void NoiseGenerator::fill(Eigen::Ref<Array> out) {
+    Eigen::Index n = out.size();
+    Eigen::Index pairs = (n + 1) / 2;
+    Eigen::Index produced = 0;
+
+    // Marsaglia polar method: points of the square inside the unit circle
+    // (pi/4 of them) give two normals each. Candidates are generated and
+    // transformed as whole blocks; only the compaction of accepted pairs
+    // is a scalar loop, and it is branch-free.
+    while (produced < pairs) {
+        Eigen::Index need = pairs - produced;
+        Eigen::Index candidates = need + need / 3 + LANES;
+        first_.resize(candidates);
+        second_.resize(candidates);
+        uniforms(candidates, first_, second_);
+        first_ = 2.0 * first_ - 1.0;
+        second_ = 2.0 * second_ - 1.0;
+        radius_ = first_.square() + second_.square();
+        scale_ = (-2.0 * radius_.log() / radius_).sqrt();
+
+        Eigen::Index accepted = 0;
+        for (Eigen::Index i = 0; i < candidates; ++i) {
+            first_(accepted) = first_(i) * scale_(i);
+            second_(accepted) = second_(i) * scale_(i);
+            accepted += radius_(i) < 1.0 && radius_(i) > 0.0;
+        }
+
+        // Cosine-half normals fill the front of out, sine-half normals the back
+        Eigen::Index taken = std::min(accepted, need);
+        Eigen::Index back = std::max<Eigen::Index>(0, std::min(taken, n - pairs - produced));
+        out.segment(produced, taken) = first_.head(taken);
+        out.segment(pairs + produced, back) = second_.head(back);
+        produced += taken;
+    }
+}
+
+void NoiseGenerator::fillUniform(Eigen::Ref<Array> out) {
+    Eigen::Index n = out.size();
+    if (n == 0) {
+        return;
+    }
+
+    Eigen::Index pairs = (n + 1) / 2;
+    first_.resize(pairs);
+    second_.resize(pairs);
+    uniforms(pairs, first_, second_);
+    out.head(pairs) = first_;
+    out.tail(n - pairs) = second_.head(n - pairs);
+}
+
+double NoiseGenerator::normal() {
+    if (block_position_ >= block_.size()) {
+        fill(block_);
+        block_position_ = 0;
+    }
+    return block_(block_position_++);
+}
+
+double NoiseGenerator::uniform() {
+    uint32_t c0 = static_cast<uint32_t>(counter_);
+    uint32_t c1 = static_cast<uint32_t>(counter_ >> 32);
+    uint32_t c2 = static_cast<uint32_t>(stream_);
+    uint32_t c3 = static_cast<uint32_t>(stream_ >> 32);
+    uint32_t k0 = key_[0];
+    uint32_t k1 = key_[1];
+    for (int round = 0; round < PHILOX_ROUNDS; ++round) {
+        philoxRound(c0, c1, c2, c3, k0, k1);
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    ++counter_;
+    return toUniform(c0, c1);
+}
+
+void NoiseGenerator::uniforms(Eigen::Index count, Eigen::Ref<Array> first, Eigen::Ref<Array> second) {
+    // Counters are encrypted LANES at a time in structure-of-arrays form so
+    // each round is one vectorizable loop over the lanes
+    uint32_t c0[LANES], c1[LANES], c2[LANES], c3[LANES];
+    for (Eigen::Index base = 0; base < count; base += LANES) {
+        for (int lane = 0; lane < LANES; ++lane) {
+            uint64_t counter = counter_ + static_cast<uint64_t>(base + lane);
+            c0[lane] = static_cast<uint32_t>(counter);
+            c1[lane] = static_cast<uint32_t>(counter >> 32);
+            c2[lane] = static_cast<uint32_t>(stream_);
+            c3[lane] = static_cast<uint32_t>(stream_ >> 32);
+        }
+
+        uint32_t k0 = key_[0];
+        uint32_t k1 = key_[1];
+        for (int round = 0; round < PHILOX_ROUNDS; ++round) {
+            for (int lane = 0; lane < LANES; ++lane) {
+                philoxRound(c0[lane], c1[lane], c2[lane], c3[lane], k0, k1);
+            }
+            k0 += PHILOX_W0;
+            k1 += PHILOX_W1;
+        }
+
+        int lanes = static_cast<int>(std::min<Eigen::Index>(LANES, count - base));
+        for (int lane = 0; lane < lanes; ++lane) {
+            first(base + lane) = toUniform(c0[lane], c1[lane]);
+            second(base + lane) = toUniform(c2[lane], c3[lane]);
+        }
+    }
+    counter_ += static_cast<uint64_t>(count);
+}
+
+} // namespace neurosim
@@ -0,0 +1,194 @@
+#include "oscillation_detector.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace neurosim {
+
+namespace {
+constexpr double TWO_PI = 6.283185307179586476925286766559;
+}
+
+OscillationDetector::OscillationDetector() : OscillationDetector(DetectorConfig{}) {
+}
+
+OscillationDetector::OscillationDetector(const DetectorConfig& config)
+    : config_(config), dt_ms_(0.0), head_(0), count_(0), since_resum_(0),
+      sum_(0.0), sum_squares_(0.0), crossing_count_(0), last_centered_(0.0) {
+    band_power_.fill(0.0);
+}
+
+void OscillationDetector::push(double sample, double dt_ms) {
+    if (dt_ms <= 0.0) {
+        return;
+    }
+    if (samples_.empty() || std::abs(dt_ms - dt_ms_) > 1e-9 * dt_ms_) {
+        configure(dt_ms);
+    }
+
+    size_t window = samples_.size();
+    bool full = count_ == window;
+    double leaving = full ? samples_[head_] : 0.0;
+
+    // Sliding DFT: S <- e^{-iw} S + x_new - e^{-iwN} x_leaving
+    for (size_t k = 0; k < spectrum_.size(); ++k) {
+        spectrum_[k] = step_rotation_[k] * spectrum_[k] + sample;
+        if (full) {
+            spectrum_[k] -= window_rotation_[k] * leaving;
+        }
+    }
+
+    // Running moments
+    sum_ += sample - leaving;
+    sum_squares_ += sample * sample - leaving * leaving;
+
+    // Mean crossings: one flag per sample, counted over the window
+    if (full) {
+        crossing_count_ -= crossings_[head_];
+    }
+    count_ = std::min(count_ + 1, window);
+    double centered = sample - sum_ / static_cast<double>(count_);
+    unsigned char crossed = count_ > 1 && last_centered_ * centered < 0.0 ? 1 : 0;
+    crossings_[head_] = crossed;
+    crossing_count_ += crossed;
+    last_centered_ = centered;
+
+    samples_[head_] = sample;
+    head_ = (head_ + 1) % window;
+
+    if (++since_resum_ >= window) {
+        resum();
+    }
+    updateBandPower();
+}
+
+void OscillationDetector::reset() {
+    head_ = 0;
+    count_ = 0;
+    since_resum_ = 0;
+    sum_ = 0.0;
+    sum_squares_ = 0.0;
+    crossing_count_ = 0;
+    last_centered_ = 0.0;
+    std::fill(spectrum_.begin(), spectrum_.end(), std::complex<double>(0.0));
+    std::fill(bin_power_.begin(), bin_power_.end(), 0.0);
+    std::fill(crossings_.begin(), crossings_.end(), 0);
+    band_power_.fill(0.0);
+}
+
+double OscillationDetector::mean() const {
+    return count_ > 0 ? sum_ / static_cast<double>(count_) : 0.0;
+}
+
+double OscillationDetector::variance() const {
+    if (count_ < 2) {
+        return 0.0;
+    }
+    double m = mean();
+    return std::max(0.0, sum_squares_ / static_cast<double>(count_) - m * m);
+}
+
+double OscillationDetector::frequency() const {
+    if (count_ < 2) {
+        return 0.0;
+    }
+    double window_seconds = static_cast<double>(count_) * dt_ms_ / 1000.0;
+    return (static_cast<double>(crossing_count_) / 2.0) / window_seconds;
+}
+
+double OscillationDetector::peakFrequency() const {
+    if (bin_power_.empty()) {
+        return 0.0;
+    }
+    size_t peak = static_cast<size_t>(std::max_element(bin_power_.begin(), bin_power_.end()) - bin_power_.begin());
+    if (bin_power_[peak] <= 0.0) {
+        return 0.0;
+    }
+    return bin_omega_[peak] / TWO_PI * (1000.0 / dt_ms_);
+}
+
+OscillationDetector::Band OscillationDetector::dominantBand() const {
+    return static_cast<Band>(std::max_element(band_power_.begin(), band_power_.end()) - band_power_.begin());
+}
+
+bool OscillationDetector::isOscillating() const {
+    double var = variance();
+    if (count_ < samples_.size() || var <= 1e-12) {
+        return false;
+    }
+    return band_power_[dominantBand()] >= config_.oscillation_threshold * var;
+}
+
+void OscillationDetector::configure(double dt_ms) {
+    dt_ms_ = dt_ms;
+    size_t window = static_cast<size_t>(std::lround(config_.window_ms / dt_ms));
+    window = std::max<size_t>(4, std::min(window, std::max<size_t>(4, config_.max_window_samples)));
+
+    samples_.assign(window, 0.0);
+    crossings_.assign(window, 0);
+
+    // Bins at whole cycles per window inside each band, below Nyquist
+    double sample_rate_hz = 1000.0 / dt_ms;
+    double resolution_hz = sample_rate_hz / static_cast<double>(window);
+    spectrum_.clear();
+    step_rotation_.clear();
+    window_rotation_.clear();
+    bin_omega_.clear();
+    bin_band_.clear();
+    for (size_t b = 0; b < BandCount; ++b) {
+        const auto& [low, high] = config_.band_ranges_hz[b];
+        double upper = std::min(high, sample_rate_hz / 2.0);
+        for (double k = std::max(1.0, std::ceil(low / resolution_hz)); k * resolution_hz < upper; k += 1.0) {
+            double omega = TWO_PI * k / static_cast<double>(window);
+            bin_omega_.push_back(omega);
+            bin_band_.push_back(static_cast<Band>(b));
+            step_rotation_.push_back(std::polar(1.0, -omega));
+            window_rotation_.push_back(std::polar(1.0, -omega * static_cast<double>(window)));
+        }
+    }
+    spectrum_.assign(bin_omega_.size(), 0.0);
+    bin_power_.assign(bin_omega_.size(), 0.0);
+    reset();
+}
+
+void OscillationDetector::resum() {
+    since_resum_ = 0;
+    sum_ = 0.0;
+    sum_squares_ = 0.0;
+    std::fill(spectrum_.begin(), spectrum_.end(), std::complex<double>(0.0));
+
+    // Oldest to newest, same recurrence without removal
+    size_t window = samples_.size();
+    size_t oldest = (head_ + window - count_) % window;
+    for (size_t i = 0; i < count_; ++i) {
+        double sample = samples_[(oldest + i) % window];
+        sum_ += sample;
+        sum_squares_ += sample * sample;
+        for (size_t k = 0; k < spectrum_.size(); ++k) {
+            spectrum_[k] = step_rotation_[k] * spectrum_[k] + sample;
+        }
+    }
+}
+
+void OscillationDetector::updateBandPower() {
+    band_power_.fill(0.0);
+    if (count_ == 0) {
+        return;
+    }
+
+    // Amplitude of a bin component is 2|S|/n; its mean square is half that squared
+    double n = static_cast<double>(count_);
+    double m = mean();
+    bool full = count_ == samples_.size();
+    for (size_t k = 0; k < spectrum_.size(); ++k) {
+        // Remove the mean's leakage (matters while the window is filling):
+        // DC response is sum_j e^{-iwj} = (1 - e^{-iwn}) / (1 - e^{-iw}),
+        // with e^{-iwn} precomputed once the window is full
+        std::complex<double> rotation = full ? window_rotation_[k] : std::polar(1.0, -bin_omega_[k] * n);
+        std::complex<double> dc_response = (1.0 - rotation) / (1.0 - step_rotation_[k]);
+        double amplitude = 2.0 * std::abs(spectrum_[k] - m * dc_response) / n;
+        bin_power_[k] = 0.5 * amplitude * amplitude;
+        band_power_[bin_band_[k]] += bin_power_[k];
+    }
+}
+
+} // namespace neurosim
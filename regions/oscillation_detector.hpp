@@ -0,0 +1,130 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <complex>
+#include <utility>
+#include <cstddef>
+
+namespace neurosim {
+
+/**
+ * @brief Streaming spectral oscillation detector for one signal
+ *
+ * Keeps a sliding window of samples and updates, in O(1) per sample
+ * (O(bins) for the spectrum):
+ * - Running mean and variance
+ * - Count of crossings of the running mean (frequency estimate)
+ * - A sliding DFT at every window bin (k / window) inside the
+ *   theta/alpha/beta/gamma ranges; band power is the sum over its bins
+ *
+ * The window spans a fixed duration, so frequencies and band powers are
+ * correct for any time step; the window is re-sized (and restarted) when
+ * the time step changes. Running sums are recomputed exactly once per
+ * window to cancel rounding drift. No allocation after configuration.
+ */
+class OscillationDetector {
+public:
+    /**
+     * @brief Frequency bands tracked by the detector
+     */
+    enum Band {
+        Theta = 0,
+        Alpha,
+        Beta,
+        Gamma,
+        BandCount
+    };
+
+    /**
+     * @brief Detector configuration
+     */
+    struct DetectorConfig {
+        double window_ms = 500.0;              ///< Analysis window length
+        size_t max_window_samples = 4096;      ///< Cap on samples held
+        double oscillation_threshold = 0.5;    ///< Min band power / variance for an oscillation
+        std::array<std::pair<double, double>, BandCount> band_ranges_hz = {{
+            {4.0, 8.0}, {8.0, 13.0}, {13.0, 30.0}, {30.0, 80.0}
+        }};                                    ///< [low, high) per band
+    };
+
+public:
+    OscillationDetector();
+    explicit OscillationDetector(const DetectorConfig& config);
+
+    /**
+     * @brief Add one sample
+     * @param sample Signal value
+     * @param dt_ms Time since the previous sample in milliseconds
+     */
+    void push(double sample, double dt_ms);
+
+    /**
+     * @brief Drop all samples (keeps the window allocation)
+     */
+    void reset();
+
+    double mean() const;
+    double variance() const;
+
+    /**
+     * @brief Frequency estimated from mean crossings in the window (Hz)
+     */
+    double frequency() const;
+
+    /**
+     * @brief Frequency of the strongest spectral bin (Hz, 0 if none)
+     */
+    double peakFrequency() const;
+
+    /**
+     * @brief Mean-square power of a band
+     */
+    double bandPower(Band band) const { return band_power_[band]; }
+    const std::array<double, BandCount>& bandPowers() const { return band_power_; }
+
+    /**
+     * @brief Band with the largest power
+     */
+    Band dominantBand() const;
+
+    /**
+     * @brief Whether a band carries at least the configured share of the variance
+     */
+    bool isOscillating() const;
+
+    size_t sampleCount() const { return count_; }
+    size_t windowSamples() const { return samples_.size(); }
+
+private:
+    DetectorConfig config_;
+    double dt_ms_;
+
+    // Sliding window (ring buffers)
+    std::vector<double> samples_;
+    std::vector<unsigned char> crossings_;
+    size_t head_;
+    size_t count_;
+    size_t since_resum_;
+
+    // Running statistics
+    double sum_;
+    double sum_squares_;
+    size_t crossing_count_;
+    double last_centered_;
+
+    // Sliding DFT per bin (bins below Nyquist only)
+    std::vector<std::complex<double>> spectrum_;
+    std::vector<std::complex<double>> step_rotation_;    // e^{-i w}
+    std::vector<std::complex<double>> window_rotation_;  // e^{-i w N}
+    std::vector<double> bin_omega_;                      // Radians per sample
+    std::vector<double> bin_power_;
+    std::vector<Band> bin_band_;
+    std::array<double, BandCount> band_power_;
+
+    void configure(double dt_ms);
+    void resum();
+    void updateBandPower();
+};
+
+} // namespace neurosim
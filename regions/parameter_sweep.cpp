@@ -0,0 +1,247 @@
+#include "parameter_sweep.hpp"
+#include "microcircuit_bank.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <fstream>
+#include <thread>
+
+namespace neurosim {
+
+ParameterSweep::ParameterSweep() : ParameterSweep(SweepConfig{}) {
+}
+
+ParameterSweep::ParameterSweep(const SweepConfig& config) : config_(config) {
+    config_.batch_size = std::max<size_t>(1, config_.batch_size);
+    config_.dt = std::max(config_.dt, 1e-6);
+}
+
+MicroCircuit::CircuitConfig ParameterSweep::defaultBase() {
+    MicroCircuit::CircuitConfig base;
+    base.autism_mode = true;
+    base.ptsd_mode = true;
+    base.adaptation_rate = 0.01;
+    base.ptsd_memory_intrusion = 0.001;
+    return base;
+}
+
+size_t ParameterSweep::run() {
+    size_t total = isRunnable() ? pointCount() : 0;
+    results_.assign(total, PointSummary{});
+    if (total == 0) {
+        return 0;
+    }
+
+    size_t batches = (total + config_.batch_size - 1) / config_.batch_size;
+    size_t workers = config_.threads > 0 ? config_.threads
+                                         : std::max<size_t>(1, std::thread::hardware_concurrency());
+    workers = std::min(workers, batches);
+
+    // Batches write disjoint result ranges, so workers share nothing but the counter
+    std::atomic<size_t> next_batch{0};
+    auto worker = [&]() {
+        for (size_t batch = next_batch++; batch < batches; batch = next_batch++) {
+            runBatch(batch);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t w = 1; w < workers; ++w) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    return total;
+}
+
+bool ParameterSweep::writeRegimeMap(const std::string& path) const {
+    if (results_.empty()) {
+        return false;
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    auto put = [&file](const auto& value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+
+    file.write("NSRM", 4);
+    put(uint32_t{1});
+    put(static_cast<uint32_t>(AxisCount));
+    for (const auto& range : config_.ranges) {
+        put(range.start);
+        put(range.stop);
+        put(static_cast<uint64_t>(range.steps));
+    }
+    put(static_cast<uint64_t>(results_.size()));
+
+    for (const auto& point : results_) {
+        for (float metric : {point.mean_excitation, point.mean_inhibition, point.mean_net_activation,
+                             point.net_activation_std, point.mean_firing_rate, point.looping_fraction,
+                             point.hyperexcitable_fraction, point.oscillation_amplitude,
+                             point.oscillation_frequency}) {
+            put(metric);
+        }
+        put(point.regime);
+    }
+    return static_cast<bool>(file);
+}
+
+bool ParameterSweep::isAxisActive(Axis axis) const {
+    switch (axis) {
+        case AutismInhibitionDeficit:
+            return config_.base.autism_mode;
+        case PTSDHyperarousal:
+            return config_.base.ptsd_mode;
+        default:
+            return axis < AxisCount;
+    }
+}
+
+std::vector<ParameterSweep::Axis> ParameterSweep::inertAxes() const {
+    std::vector<Axis> inert;
+    for (size_t axis = 0; axis < AxisCount; ++axis) {
+        if (config_.ranges[axis].steps > 1 && !isAxisActive(static_cast<Axis>(axis))) {
+            inert.push_back(static_cast<Axis>(axis));
+        }
+    }
+    return inert;
+}
+
+bool ParameterSweep::isRunnable() const {
+    return MicroCircuitBank::supports(config_.base) && inertAxes().empty();
+}
+
+size_t ParameterSweep::pointCount() const {
+    size_t count = 1;
+    for (const auto& range : config_.ranges) {
+        count *= range.steps;
+    }
+    return count;
+}
+
+size_t ParameterSweep::pointIndex(const std::array<size_t, AxisCount>& indices) const {
+    size_t index = 0;
+    for (size_t axis = AxisCount; axis-- > 0;) {
+        index = index * config_.ranges[axis].steps + indices[axis];
+    }
+    return index;
+}
+
+std::array<double, ParameterSweep::AxisCount> ParameterSweep::pointParameters(size_t index) const {
+    std::array<double, AxisCount> values{};
+    for (size_t axis = 0; axis < AxisCount; ++axis) {
+        size_t steps = std::max<size_t>(1, config_.ranges[axis].steps);
+        values[axis] = config_.ranges[axis].value(index % steps);
+        index /= steps;
+    }
+    return values;
+}
+
+MicroCircuit::CircuitConfig ParameterSweep::pointConfig(size_t index) const {
+    auto values = pointParameters(index);
+    MicroCircuit::CircuitConfig config = config_.base;
+    config.ei_ratio = values[EIRatio];
+    if (config.autism_mode) {
+        config.autism_ei_elevation = values[EIRatio];
+    }
+    config.inhibition_delay_ms = values[InhibitionDelay];
+    if (config.ptsd_mode) {
+        config.ptsd_inhibition_delay = values[InhibitionDelay];
+    }
+    config.autism_inhibition_deficit = values[AutismInhibitionDeficit];
+    config.ptsd_hyperarousal = values[PTSDHyperarousal];
+    return config;
+}
+
+void ParameterSweep::runBatch(size_t batch) {
+    size_t begin = batch * config_.batch_size;
+    size_t end = std::min(begin + config_.batch_size, results_.size());
+    Eigen::Index n = static_cast<Eigen::Index>(end - begin);
+
+    MicroCircuitBank bank(config_.seed, batch);
+    bank.reserve(end - begin);
+    for (size_t point = begin; point < end; ++point) {
+        bank.add(pointConfig(point));
+    }
+
+    using Array = Eigen::ArrayXd;
+    Array sum_excitation = Array::Zero(n);
+    Array sum_inhibition = Array::Zero(n);
+    Array sum_net = Array::Zero(n);
+    Array sum_net_squares = Array::Zero(n);
+    Array sum_rate = Array::Zero(n);
+    Array looping = Array::Zero(n);
+    Array hyperexcitable = Array::Zero(n);
+    Array band_fast = Array::Zero(n);
+    Array band_slow = Array::Zero(n);
+    Array band = Array::Zero(n);
+    Array band_previous = Array::Zero(n);
+    Array band_power = Array::Zero(n);
+    Array crossings = Array::Zero(n);
+
+    const double dt = config_.dt;
+    const size_t steps = std::max<size_t>(1, static_cast<size_t>(std::lround(config_.duration_ms / dt)));
+    const size_t settle = std::min(steps - 1, static_cast<size_t>(std::lround(config_.settle_ms / dt)));
+    const double fast = -std::expm1(-dt / config_.band_fast_tau_ms);
+    const double slow = -std::expm1(-dt / config_.band_slow_tau_ms);
+
+    for (size_t step = 0; step < steps; ++step) {
+        bank.inputs().setConstant(config_.input);
+        bank.step(dt);
+
+        const auto net = bank.netActivation();
+        band_fast += fast * (net - band_fast);
+        band_slow += slow * (net - band_slow);
+        band = band_fast - band_slow;
+        if (step >= settle) {
+            const auto excitation = bank.excitatory();
+            const auto inhibition = bank.inhibitory();
+            sum_excitation += excitation;
+            sum_inhibition += inhibition;
+            sum_net += net;
+            sum_net_squares += net.square();
+            sum_rate += bank.firingRate();
+            looping += (excitation / inhibition.max(0.1) > config_.looping_ei_ratio).cast<double>();
+            hyperexcitable += bank.hyperexcitable().cast<double>();
+            band_power += band.square();
+            crossings += (band * band_previous < 0.0).cast<double>();
+        }
+        band_previous = band;
+    }
+
+    double count = static_cast<double>(steps - settle);
+    double seconds = count * dt / 1000.0;
+    for (Eigen::Index i = 0; i < n; ++i) {
+        PointSummary& point = results_[begin + static_cast<size_t>(i)];
+        double mean_net = sum_net(i) / count;
+        point.mean_excitation = static_cast<float>(sum_excitation(i) / count);
+        point.mean_inhibition = static_cast<float>(sum_inhibition(i) / count);
+        point.mean_net_activation = static_cast<float>(mean_net);
+        point.net_activation_std = static_cast<float>(std::sqrt(std::max(0.0, sum_net_squares(i) / count - mean_net * mean_net)));
+        point.mean_firing_rate = static_cast<float>(sum_rate(i) / count);
+        point.looping_fraction = static_cast<float>(looping(i) / count);
+        point.hyperexcitable_fraction = static_cast<float>(hyperexcitable(i) / count);
+        point.oscillation_amplitude = static_cast<float>(std::sqrt(band_power(i) / count));
+        point.oscillation_frequency = static_cast<float>(crossings(i) / 2.0 / seconds);
+
+        uint8_t regime = Stable;
+        if (point.looping_fraction >= config_.regime_fraction) {
+            regime |= Looping;
+        }
+        if (point.hyperexcitable_fraction >= config_.regime_fraction) {
+            regime |= Hyperexcitable;
+        }
+        if (point.oscillation_amplitude >= config_.oscillation_amplitude) {
+            regime |= Oscillating;
+        }
+        point.regime = regime;
+    }
+}
+
+} // namespace neurosim
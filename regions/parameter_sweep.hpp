@@ -0,0 +1,196 @@
+#pragma once
+
+#include "microcircuit.hpp"
+#include <array>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace neurosim {
+
+/**
+ * @brief Grid sweep of E/I parameters for microcircuit regime maps
+ *
+ * Evaluates every point of a 4-D grid over ei_ratio, inhibition_delay_ms,
+ * autism_inhibition_deficit and ptsd_hyperarousal without constructing
+ * MicroCircuit objects:
+ * - Points are split into batches; each batch is one MicroCircuitBank
+ *   (structure-of-arrays, one slot per point) stepped with array
+ *   expressions, so the per-point update vectorizes
+ * - Batches are handed out to worker threads through an atomic counter,
+ *   and each batch draws noise from its own stream (the batch index),
+ *   so results do not depend on the thread count
+ * - Summary statistics are accumulated per step as array expressions
+ *   after a settling period; nothing per step is stored
+ *
+ * Oscillations are detected on a band-passed copy of net activation (a
+ * fast EWMA minus a slow EWMA): its RMS gives the amplitude and its
+ * zero-crossing rate the frequency.
+ *
+ * The autism/PTSD axes only take effect when the base configuration enables
+ * the corresponding mode, and a sweep that steps an axis without its mode is
+ * refused (see inertAxes()). With autism mode on, the ei_ratio axis sets
+ * autism_ei_elevation, which that mode substitutes for ei_ratio; with PTSD
+ * mode on, the delay axis also sets ptsd_inhibition_delay. The bank only
+ * implements Euler steps, so a base configuration with another integrator
+ * is refused as well.
+ *
+ * Grid index: ei + n_ei * (delay + n_delay * (deficit + n_deficit * hyperarousal)).
+ */
+class ParameterSweep {
+public:
+    /**
+     * @brief Swept parameters
+     */
+    enum Axis {
+        EIRatio = 0,
+        InhibitionDelay,
+        AutismInhibitionDeficit,
+        PTSDHyperarousal,
+        AxisCount
+    };
+
+    /**
+     * @brief Regime flags of a grid point (bit mask)
+     */
+    enum Regime : uint8_t {
+        Stable = 0,
+        Looping = 1 << 0,           ///< E/I ratio above looping_ei_ratio most of the time
+        Hyperexcitable = 1 << 1,    ///< Hyperexcitable flag set most of the time
+        Oscillating = 1 << 2        ///< Band-passed net activation above the amplitude threshold
+    };
+
+    /**
+     * @brief Evenly spaced values [start, stop] (steps = 1 uses start)
+     */
+    struct Range {
+        double start = 0.0;
+        double stop = 0.0;
+        size_t steps = 1;
+
+        double value(size_t i) const {
+            return steps > 1 ? start + (stop - start) * static_cast<double>(i) / static_cast<double>(steps - 1) : start;
+        }
+    };
+
+    /**
+     * @brief Base circuit of the default sweep
+     *
+     * Autism and PTSD modes on so every axis is active, weak adaptation so
+     * circuits do not all settle to silence, and rare intrusions. With the
+     * default ranges the grid covers stable, looping, hyperexcitable and
+     * oscillating points.
+     */
+    static MicroCircuit::CircuitConfig defaultBase();
+
+    /**
+     * @brief Sweep configuration
+     */
+    struct SweepConfig {
+        std::array<Range, AxisCount> ranges = {{
+            {0.9, 1.1, 16},     // ei_ratio (autism_ei_elevation, per-ms gain)
+            {0.0, 100.0, 16},   // inhibition_delay_ms
+            {0.85, 1.0, 8},     // autism_inhibition_deficit (per-ms gain)
+            {0.95, 1.05, 8}     // ptsd_hyperarousal (per-ms gain)
+        }};
+        MicroCircuit::CircuitConfig base = defaultBase(); ///< Remaining circuit parameters and modes (Euler only)
+        double input = 0.5;                     ///< Constant drive to every circuit
+        double duration_ms = 2000.0;            ///< Simulated time per point
+        double settle_ms = 500.0;               ///< Initial time excluded from statistics
+        double dt = 1.0;                        ///< Time step (ms)
+        size_t batch_size = 4096;               ///< Points per bank
+        size_t threads = 0;                     ///< Worker threads (0 = hardware concurrency)
+        unsigned int seed = 1;                  ///< Base noise seed (0 = nondeterministic)
+        double looping_ei_ratio = 2.0;          ///< E/I ratio counted as looping
+        double regime_fraction = 0.5;           ///< Share of time needed for Looping/Hyperexcitable
+        double oscillation_amplitude = 0.1;     ///< Band-passed RMS needed for Oscillating
+        double band_fast_tau_ms = 2.0;          ///< Band-pass: noise smoothing
+        double band_slow_tau_ms = 100.0;        ///< Band-pass: trend removal
+    };
+
+    /**
+     * @brief Summary metrics of one grid point
+     */
+    struct PointSummary {
+        float mean_excitation = 0.0f;
+        float mean_inhibition = 0.0f;
+        float mean_net_activation = 0.0f;
+        float net_activation_std = 0.0f;
+        float mean_firing_rate = 0.0f;          ///< Hz
+        float looping_fraction = 0.0f;          ///< Share of time E/I > looping_ei_ratio
+        float hyperexcitable_fraction = 0.0f;   ///< Share of time hyperexcitable
+        float oscillation_amplitude = 0.0f;     ///< RMS of band-passed net activation
+        float oscillation_frequency = 0.0f;     ///< Hz, from band-passed zero crossings
+        uint8_t regime = Stable;                ///< Regime flags
+    };
+
+public:
+    ParameterSweep();
+    explicit ParameterSweep(const SweepConfig& config);
+
+    /**
+     * @brief Evaluate every grid point (blocks until done)
+     * @return Number of points evaluated (0 if the sweep is not runnable)
+     */
+    size_t run();
+
+    /**
+     * @brief Whether an axis changes the circuits under the base configuration
+     */
+    bool isAxisActive(Axis axis) const;
+
+    /**
+     * @brief Axes with several steps that would not change the circuits
+     */
+    std::vector<Axis> inertAxes() const;
+
+    /**
+     * @brief Whether run() evaluates the grid: a supported integrator and no inert axes
+     */
+    bool isRunnable() const;
+
+    /**
+     * @brief Write the regime map
+     *
+     * Binary layout (native byte order): "NSRM", uint32 version (1), uint32 axis
+     * count, per axis {float64 start, float64 stop, uint64 steps}, uint64
+     * point count, then per point 9 float32 metrics in PointSummary order
+     * followed by the uint8 regime flags.
+     *
+     * @param path Output file
+     * @return False if the sweep has not run or the file cannot be written
+     */
+    bool writeRegimeMap(const std::string& path) const;
+
+    /**
+     * @brief Number of grid points
+     */
+    size_t pointCount() const;
+
+    /**
+     * @brief Grid index of a combination of axis indices
+     */
+    size_t pointIndex(const std::array<size_t, AxisCount>& indices) const;
+
+    /**
+     * @brief Parameter values of a grid point
+     */
+    std::array<double, AxisCount> pointParameters(size_t index) const;
+
+    /**
+     * @brief Circuit configuration of a grid point
+     */
+    MicroCircuit::CircuitConfig pointConfig(size_t index) const;
+
+    const std::vector<PointSummary>& results() const { return results_; }
+    const SweepConfig& getConfig() const { return config_; }
+
+private:
+    SweepConfig config_;
+    std::vector<PointSummary> results_;
+
+    void runBatch(size_t batch);
+};
+
+} // namespace neurosim
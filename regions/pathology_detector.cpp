@@ -0,0 +1,106 @@
+#include "pathology_detector.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace neurosim {
+
+namespace {
+// Exact EWMA weight of a new sample after dt for time constant tau
+double smoothing(double dt, double tau) {
+    return -std::expm1(-dt / std::max(tau, 1e-9));
+}
+}
+
+PathologyDetector::PathologyDetector() : PathologyDetector(DetectorConfig{}) {
+}
+
+PathologyDetector::PathologyDetector(const DetectorConfig& config) : config_(config) {
+    reset();
+}
+
+void PathologyDetector::push(double excitatory, double inhibitory, double dt_ms) {
+    if (dt_ms <= 0.0) {
+        return;
+    }
+
+    double net = excitatory - inhibitory;
+    if (!has_sample_) {
+        // First sample seeds the statistics
+        excitatory_mean_ = excitatory;
+        burst_excitation_ = excitatory;
+        smoothed_net_ = net;
+        last_net_ = net;
+        has_sample_ = true;
+    }
+    elapsed_ += dt_ms;
+
+    double slow = smoothing(dt_ms, config_.baseline_tau_ms);
+    double fast = smoothing(dt_ms, config_.burst_tau_ms);
+    double persist = smoothing(dt_ms, config_.persistence_tau_ms);
+
+    // CUSUM against the baseline before it absorbs this sample
+    double deviation = std::max(config_.min_deviation, std::sqrt(excitatory_variance_));
+    double z = (excitatory - excitatory_mean_) / deviation;
+    cusum_ = std::max(0.0, cusum_ + (z - config_.cusum_drift) * dt_ms);
+
+    // EWMA mean and variance (West's incremental form)
+    double delta = excitatory - excitatory_mean_;
+    excitatory_mean_ += slow * delta;
+    excitatory_variance_ = (1.0 - slow) * (excitatory_variance_ + slow * delta * delta);
+
+    // Line length of the smoothed net activation per ms
+    smoothed_net_ += smoothing(dt_ms, config_.signal_tau_ms) * (net - smoothed_net_);
+    double line_length = std::abs(smoothed_net_ - last_net_) / dt_ms;
+    last_net_ = smoothed_net_;
+    baseline_line_length_ += slow * (line_length - baseline_line_length_);
+    burst_line_length_ += fast * (line_length - burst_line_length_);
+    burst_excitation_ += fast * (excitatory - burst_excitation_);
+
+    // Persistence of the instantaneous criteria
+    bool over_excited = excitatory > config_.hyperexcitable_excitation ||
+                        excitatory / std::max(0.1, inhibitory) > config_.hyperexcitable_ei_ratio;
+    bool failing = inhibitory < config_.failure_inhibition && excitatory > config_.failure_excitation;
+    hyperexcitable_share_ += persist * ((over_excited ? 1.0 : 0.0) - hyperexcitable_share_);
+    failure_share_ += persist * ((failing ? 1.0 : 0.0) - failure_share_);
+}
+
+void PathologyDetector::reset() {
+    elapsed_ = 0.0;
+    smoothed_net_ = 0.0;
+    last_net_ = 0.0;
+    has_sample_ = false;
+    excitatory_mean_ = 0.0;
+    excitatory_variance_ = 0.0;
+    baseline_line_length_ = 0.0;
+    burst_excitation_ = 0.0;
+    burst_line_length_ = 0.0;
+    hyperexcitable_share_ = 0.0;
+    failure_share_ = 0.0;
+    cusum_ = 0.0;
+}
+
+bool PathologyDetector::hyperexcitable() const {
+    return hyperexcitable_share_ >= config_.persistence_threshold;
+}
+
+bool PathologyDetector::inhibitionFailure() const {
+    return failure_share_ >= config_.persistence_threshold;
+}
+
+bool PathologyDetector::seizure() const {
+    return elapsed_ >= config_.warmup_ms &&
+           burst_excitation_ >= config_.seizure_min_excitation &&
+           lineLengthRatio() >= config_.seizure_line_length_ratio;
+}
+
+bool PathologyDetector::intrusion() const {
+    return elapsed_ >= config_.warmup_ms && cusum_ >= config_.cusum_threshold;
+}
+
+double PathologyDetector::lineLengthRatio() const {
+    // Floor keeps a flat baseline from turning tiny wiggles into bursts
+    double floor = config_.min_deviation / std::max(config_.burst_tau_ms, 1e-9);
+    return burst_line_length_ / std::max(baseline_line_length_, floor);
+}
+
+} // namespace neurosim
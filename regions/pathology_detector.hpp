@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+
+namespace neurosim {
+
+/**
+ * @brief Streaming detector of pathological E/I activity patterns
+ *
+ * Updated once per step in constant time from the excitatory and
+ * inhibitory activity; no history is kept or scanned:
+ * - Hyperexcitability and inhibition failure: the instantaneous criteria
+ *   smoothed by an EWMA, so a flag needs the condition to persist
+ * - Seizure-like bursts: fast line length (EWMA of |dx/dt|) of the
+ *   lightly smoothed net activation well above its slow baseline while
+ *   excitation is high; the smoothing keeps per-step noise, whose |dx/dt|
+ *   grows as dt shrinks, out of the line length
+ * - Intrusion bursts: one-sided CUSUM of excitation standardized by its
+ *   slow EWMA mean and variance, so abrupt upward shifts accumulate and
+ *   baseline fluctuations drain away
+ *
+ * All smoothing uses time constants in milliseconds (exact per-step
+ * factors), so flags do not depend on the time step.
+ */
+class PathologyDetector {
+public:
+    /**
+     * @brief Detector configuration
+     */
+    struct DetectorConfig {
+        double baseline_tau_ms = 2000.0;        ///< Slow EWMA (baseline statistics)
+        double burst_tau_ms = 50.0;             ///< Fast EWMA (burst statistics)
+        double signal_tau_ms = 5.0;             ///< Smoothing of net activation before line length
+        double persistence_tau_ms = 100.0;      ///< Smoothing of instantaneous criteria
+        double persistence_threshold = 0.5;     ///< Smoothed share of time a criterion must hold
+        double warmup_ms = 200.0;               ///< No burst flags before the baseline settles
+        double hyperexcitable_excitation = 3.0; ///< Excitation above this is hyperexcitable
+        double hyperexcitable_ei_ratio = 3.0;   ///< E/I ratio above this is hyperexcitable
+        double failure_inhibition = 0.2;        ///< Inhibition below this ...
+        double failure_excitation = 1.0;        ///< ... with excitation above this is a failure
+        double seizure_line_length_ratio = 4.0; ///< Fast / baseline line length for a seizure
+        double seizure_min_excitation = 2.0;    ///< Fast mean excitation required for a seizure
+        double cusum_drift = 3.0;               ///< CUSUM allowance k (baseline SDs)
+        double cusum_threshold = 20.0;          ///< CUSUM alarm level h (baseline SD x ms)
+        double min_deviation = 0.05;            ///< Floor on the baseline SD
+    };
+
+public:
+    PathologyDetector();
+    explicit PathologyDetector(const DetectorConfig& config);
+
+    /**
+     * @brief Add one step of activity
+     * @param excitatory Excitatory activity
+     * @param inhibitory Inhibitory activity
+     * @param dt_ms Step length in milliseconds
+     */
+    void push(double excitatory, double inhibitory, double dt_ms);
+
+    /**
+     * @brief Clear all statistics and flags
+     */
+    void reset();
+
+    bool hyperexcitable() const;
+    bool inhibitionFailure() const;
+    bool seizure() const;
+    bool intrusion() const;
+
+    double excitatoryMean() const { return excitatory_mean_; }
+    double excitatoryVariance() const { return excitatory_variance_; }
+    double lineLengthRatio() const;
+    double cusum() const { return cusum_; }
+    double elapsed() const { return elapsed_; }
+
+private:
+    DetectorConfig config_;
+
+    double elapsed_;
+    double smoothed_net_;
+    double last_net_;
+    bool has_sample_;
+
+    // Slow baseline statistics
+    double excitatory_mean_;
+    double excitatory_variance_;
+    double baseline_line_length_;
+
+    // Fast burst statistics
+    double burst_excitation_;
+    double burst_line_length_;
+
+    // Smoothed instantaneous criteria (0-1)
+    double hyperexcitable_share_;
+    double failure_share_;
+
+    double cusum_;
+};
+
+} // namespace neurosim
@@ -1,18 +1,94 @@
 #include "prefrontal.hpp"
-
-// Stub implementation for prefrontal cortex
-// Owner: Darrell Mesa (darrell.mesa@pm-ss.org)
+#include <algorithm>
+#include <cmath>
 
 namespace neurosim {
 
+namespace {
+// Slots at full working-memory capacity
+constexpr double MAX_WORKING_MEMORY_SLOTS = 7.0;
+// Share of the amygdala's top-down inhibition that reaches the insula
+constexpr double INSULA_INHIBITION_SHARE = 0.5;
+}
+
+PrefrontalCortex::PrefrontalCortex(const RegionConfig& region_config) : PrefrontalCortex(region_config, PFCConfig{}) {
+}
+
 PrefrontalCortex::PrefrontalCortex(const RegionConfig& region_config, 
                                   const PFCConfig& pfc_config)
-    : BrainRegion(region_config), pfc_config_(pfc_config) {
+    : BrainRegion(region_config), pfc_config_(pfc_config),
+      working_memory_(workingMemoryConfig(pfc_config)) {
+    double control = pfc_config_.inhibitory_control_strength;
+    if (pfc_config_.autism_executive_differences) {
+        control *= pfc_config_.autism_inhibitory_deficit;
+    }
+    if (pfc_config_.ptsd_executive_dysfunction) {
+        control *= 1.0 - pfc_config_.ptsd_inhibitory_impairment;
+    }
+    pfc_state_.inhibitory_control = control;
 }
 
 double PrefrontalCortex::processInput(double input, double dt) {
-    // Simple stub implementation
-    current_activation_ = input * 0.4;
+    // Without a fused embedding nothing is offered to working memory
+    current_time_ += dt;
+    driveMicrocircuit(input, dt);
+
+    working_memory_.decay(dt);
+    pfc_state_.goal_match = 0.0;
+    pfc_state_.working_memory_updated = false;
+    return updateControl(input);
+}
+
+double PrefrontalCortex::processInput(double input, const Eigen::Ref<const Eigen::VectorXd>& context,
+                                      double dt) {
+    current_time_ += dt;
+    driveMicrocircuit(input, dt);
+
+    // PTSD: threat-laden input captures working memory more easily
+    double salience = input;
+    if (pfc_config_.ptsd_executive_dysfunction) {
+        salience *= pfc_config_.ptsd_hypervigilance_bias;
+    }
+
+    pfc_state_.goal_match = working_memory_.similarity(context);
+    pfc_state_.working_memory_updated =
+        working_memory_.update(context, salience, dt) != WorkingMemoryBuffer::npos;
+    return updateControl(input);
+}
+
+WorkingMemoryBuffer::Config PrefrontalCortex::workingMemoryConfig(const PFCConfig& config) {
+    WorkingMemoryBuffer::Config buffer_config;
+    buffer_config.slots = static_cast<size_t>(std::max(1L, std::lround(
+        std::max(0.0, std::min(1.0, config.working_memory_capacity)) * MAX_WORKING_MEMORY_SLOTS)));
+    buffer_config.decay_tau_ms = config.working_memory_decay_ms;
+    buffer_config.gate_threshold = config.working_memory_gate;
+    buffer_config.refresh_rate = config.cognitive_flexibility;
+
+    // Autism: held items persist and are harder to displace or update
+    if (config.autism_executive_differences) {
+        buffer_config.decay_tau_ms *= config.autism_cognitive_rigidity;
+        buffer_config.gate_threshold *= config.autism_cognitive_rigidity;
+        buffer_config.refresh_rate /= config.autism_cognitive_rigidity;
+    }
+
+    // PTSD: working memory is not maintained as long
+    if (config.ptsd_executive_dysfunction) {
+        buffer_config.decay_tau_ms *= 1.0 - config.ptsd_inhibitory_impairment;
+    }
+    return buffer_config;
+}
+
+double PrefrontalCortex::updateControl(double input) {
+    pfc_state_.working_memory_load = working_memory_.load();
+    pfc_state_.items_held = working_memory_.occupied();
+
+    // Maintained goals keep the PFC engaged beyond the current input
+    double activation = input * 0.4 +
+        0.5 * pfc_config_.executive_control_strength * pfc_state_.working_memory_load;
+    current_activation_ = std::max(0.0, std::min(config_.max_activation, activation));
+
+    top_down_signals_.amygdala_inhibition = pfc_state_.inhibitory_control * current_activation_;
+    top_down_signals_.insula_inhibition = top_down_signals_.amygdala_inhibition * INSULA_INHIBITION_SHARE;
     return current_activation_;
 }
 
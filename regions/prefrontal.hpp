@@ -1,6 +1,7 @@
 #pragma once
 
 #include "microcircuit.hpp"
+#include "working_memory_buffer.hpp"
 #include <Eigen/Dense>
 
 namespace neurosim {
@@ -37,15 +38,40 @@ public:
         bool ptsd_executive_dysfunction = false;
         double ptsd_inhibitory_impairment = 0.5; ///< Impaired inhibitory control
         double ptsd_hypervigilance_bias = 1.5;   ///< Attention bias to threats
+        
+        // Working memory
+        double working_memory_decay_ms = 2000.0; ///< Decay time constant of held items
+        double working_memory_gate = 0.3;        ///< Input strength needed to update working memory
     };
 
+    /**
+     * @brief Top-down inhibition sent to limbic regions
+     */
+    struct TopDownSignals {
+        double amygdala_inhibition = 0.0;       ///< Inhibitory drive onto the amygdala
+        double insula_inhibition = 0.0;         ///< Inhibitory drive onto the insula
+    };
+
+    /**
+     * @brief PFC executive state for the last step
+     */
+    struct PFCState {
+        double working_memory_load = 0.0;       ///< Mean slot strength (0-1 at unit salience)
+        size_t items_held = 0;                  ///< Occupied working-memory slots
+        double goal_match = 0.0;                ///< Match of the input to held items
+        bool working_memory_updated = false;    ///< Input passed the gate and was written
+        double inhibitory_control = 0.0;        ///< Effective inhibitory control strength
+    };
+
+    explicit PrefrontalCortex(const RegionConfig& region_config);
+
     /**
      * @brief Constructor
      * @param region_config Base region configuration
      * @param pfc_config PFC-specific configuration
      */
     PrefrontalCortex(const RegionConfig& region_config, 
-                    const PFCConfig& pfc_config = PFCConfig{});
+                    const PFCConfig& pfc_config);
 
     /**
      * @brief Process input with executive control and inhibition
@@ -55,8 +81,44 @@ public:
      */
     double processInput(double input, double dt = 1.0) override;
 
+    /**
+     * @brief Process input with the fused embedding offered to working memory
+     *
+     * Held items decay, then the embedding passes the working-memory gate
+     * if the (PTSD threat-biased) input is strong enough. Activation grows
+     * with working-memory load and sets the top-down inhibition.
+     *
+     * @param input Input activation strength
+     * @param context Fused multimodal embedding (referenced, not copied)
+     * @param dt Time step in milliseconds
+     * @return PFC activation level
+     */
+    double processInput(double input, const Eigen::Ref<const Eigen::VectorXd>& context,
+                        double dt = 1.0) override;
+
+    /**
+     * @brief Get the top-down inhibition computed in the last step
+     */
+    const TopDownSignals& getTopDownSignals() const { return top_down_signals_; }
+
+    /**
+     * @brief Get current PFC state
+     */
+    const PFCState& getPFCState() const { return pfc_state_; }
+
+    /**
+     * @brief Get the working-memory buffer
+     */
+    const WorkingMemoryBuffer& getWorkingMemory() const { return working_memory_; }
+
 private:
     PFCConfig pfc_config_;
+    PFCState pfc_state_;
+    TopDownSignals top_down_signals_;
+    WorkingMemoryBuffer working_memory_;
+
+    static WorkingMemoryBuffer::Config workingMemoryConfig(const PFCConfig& config);
+    double updateControl(double input);
 };
 
 } // namespace neurosim
@@ -0,0 +1,204 @@
+#include "spiking_population.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace neurosim {
+
+SpikingPopulation::SpikingPopulation() : SpikingPopulation(PopulationConfig{}) {
+}
+
+SpikingPopulation::SpikingPopulation(const PopulationConfig& config)
+    : config_(config), excitatory_count_(0), min_delay_steps_(1), step_index_(0), spike_count_(0),
+      decay_(0.0), noise_scale_(0.0), rate_decay_(0.0), refractory_steps_(0.0),
+      excitatory_rate_(0.0), inhibitory_rate_(0.0), current_time_(0.0), pending_time_(0.0),
+      noise_generator_(config.seed) {
+
+    config_.resolution_ms = std::max(config_.resolution_ms, 1e-3);
+    config_.membrane_tau_ms = std::max(config_.membrane_tau_ms, config_.resolution_ms);
+    config_.rate_tau_ms = std::max(config_.rate_tau_ms, config_.resolution_ms);
+
+    size_t n = config_.neuron_count;
+    excitatory_count_ = std::min(n, static_cast<size_t>(
+        std::lround(std::clamp(config_.excitatory_fraction, 0.0, 1.0) * static_cast<double>(n))));
+
+    double h = config_.resolution_ms;
+    decay_ = std::exp(-h / config_.membrane_tau_ms);
+    noise_scale_ = config_.noise_sigma * std::sqrt(1.0 - decay_ * decay_);
+    rate_decay_ = std::exp(-h / config_.rate_tau_ms);
+    refractory_steps_ = std::round(config_.refractory_ms / h);
+
+    potential_.resize(static_cast<Eigen::Index>(n));
+    refractory_.resize(static_cast<Eigen::Index>(n));
+    synaptic_input_.resize(static_cast<Eigen::Index>(n));
+    noise_.resize(static_cast<Eigen::Index>(n));
+
+    buildConnectivity();
+    reset();
+}
+
+double SpikingPopulation::step(double input, double dt) {
+    double drive = config_.background_drive + config_.input_gain * input;
+
+    pending_time_ += dt;
+    double h = config_.resolution_ms;
+    while (pending_time_ >= h * (1.0 - 1e-9)) {
+        substep(drive);
+        pending_time_ -= h;
+    }
+    current_time_ += dt;
+
+    return getActivation();
+}
+
+void SpikingPopulation::reset() {
+    // Potentials spread between reset and threshold so the population starts asynchronous
+    noise_generator_.fillUniform(potential_);
+    potential_ = config_.reset_potential + (config_.threshold - config_.reset_potential) * potential_;
+    refractory_.setZero();
+    synaptic_input_.setZero();
+    noise_.setZero();
+
+    for (auto& spikes : spike_ring_) {
+        spikes.clear();
+    }
+    step_index_ = 0;
+    spike_count_ = 0;
+    excitatory_rate_ = 0.0;
+    inhibitory_rate_ = 0.0;
+    current_time_ = 0.0;
+    pending_time_ = 0.0;
+}
+
+double SpikingPopulation::getActivation() const {
+    if (config_.max_rate_hz <= 0.0) {
+        return 0.0;
+    }
+    return std::clamp(excitatory_rate_ / config_.max_rate_hz, 0.0, 1.0);
+}
+
+const std::vector<uint32_t>& SpikingPopulation::getRecentSpikes() const {
+    // All slots are empty before the first substep
+    size_t slots = spike_ring_.size();
+    return spike_ring_[static_cast<size_t>((step_index_ + slots - 1) % slots)];
+}
+
+size_t SpikingPopulation::synapseCount() const {
+    size_t count = 0;
+    for (const auto& block : synapses_) {
+        count += block.targets.size();
+    }
+    return count;
+}
+
+void SpikingPopulation::buildConnectivity() {
+    size_t n = config_.neuron_count;
+    double h = config_.resolution_ms;
+    min_delay_steps_ = std::max<size_t>(1, static_cast<size_t>(std::lround(config_.min_delay_ms / h)));
+    size_t max_delay_steps = std::max(min_delay_steps_,
+                                      static_cast<size_t>(std::lround(config_.max_delay_ms / h)));
+
+    synapses_.assign(max_delay_steps + 1, SynapseBlock{});
+    spike_ring_.assign(max_delay_steps + 1, std::vector<uint32_t>{});
+    if (n < 2 || config_.connections_per_neuron == 0) {
+        return;
+    }
+
+    for (size_t d = min_delay_steps_; d <= max_delay_steps; ++d) {
+        synapses_[d].row_offsets.assign(n + 1, 0);
+    }
+
+    // Two passes over the same random stream (count, then fill) so no
+    // per-synapse staging buffer is needed
+    auto forEachSynapse = [&](auto&& visit) {
+        std::mt19937 rng(config_.seed);
+        std::uniform_int_distribution<size_t> target_dist(0, n - 2);
+        std::uniform_int_distribution<size_t> delay_dist(min_delay_steps_, max_delay_steps);
+        for (size_t pre = 0; pre < n; ++pre) {
+            for (size_t k = 0; k < config_.connections_per_neuron; ++k) {
+                size_t target = target_dist(rng);
+                target += target >= pre ? 1 : 0;  // No autapses
+                visit(pre, target, delay_dist(rng));
+            }
+        }
+    };
+
+    forEachSynapse([&](size_t pre, size_t, size_t delay) {
+        ++synapses_[delay].row_offsets[pre + 1];
+    });
+
+    std::vector<std::vector<uint32_t>> cursors(max_delay_steps + 1);
+    for (size_t d = min_delay_steps_; d <= max_delay_steps; ++d) {
+        auto& block = synapses_[d];
+        for (size_t i = 0; i < n; ++i) {
+            block.row_offsets[i + 1] += block.row_offsets[i];
+        }
+        block.targets.resize(block.row_offsets[n]);
+        block.weights.resize(block.row_offsets[n]);
+        cursors[d].assign(block.row_offsets.begin(), block.row_offsets.end() - 1);
+    }
+
+    float excitatory = static_cast<float>(config_.excitatory_weight);
+    float inhibitory = static_cast<float>(-config_.excitatory_weight * config_.inhibition_ratio);
+    forEachSynapse([&](size_t pre, size_t target, size_t delay) {
+        uint32_t slot = cursors[delay][pre]++;
+        synapses_[delay].targets[slot] = static_cast<uint32_t>(target);
+        synapses_[delay].weights[slot] = pre < excitatory_count_ ? excitatory : inhibitory;
+    });
+}
+
+void SpikingPopulation::deliverSpikes() {
+    synaptic_input_.setZero();
+
+    size_t slots = spike_ring_.size();
+    for (size_t d = min_delay_steps_; d < synapses_.size() && d <= step_index_; ++d) {
+        const auto& spikes = spike_ring_[static_cast<size_t>((step_index_ - d) % slots)];
+        const auto& block = synapses_[d];
+        for (uint32_t pre : spikes) {
+            for (uint32_t s = block.row_offsets[pre]; s < block.row_offsets[pre + 1]; ++s) {
+                synaptic_input_(block.targets[s]) += block.weights[s];
+            }
+        }
+    }
+}
+
+void SpikingPopulation::substep(double drive) {
+    deliverSpikes();
+
+    // Exact relaxation toward rest + drive, then PSP jumps and OU noise;
+    // refractory neurons stay clamped at reset
+    if (noise_scale_ > 0.0) {
+        noise_generator_.fill(noise_);
+    }
+    double target = config_.resting_potential + drive;
+    potential_ = (refractory_ > 0.0).select(config_.reset_potential,
+        target + (potential_ - target) * decay_ + synaptic_input_ + noise_ * noise_scale_);
+    refractory_ = (refractory_ - 1.0).max(0.0);
+
+    // Threshold crossings become this step's spike queue entry
+    auto& spikes = spike_ring_[static_cast<size_t>(step_index_ % spike_ring_.size())];
+    spikes.clear();
+    size_t excitatory_spikes = 0;
+    for (Eigen::Index i = 0; i < potential_.size(); ++i) {
+        if (potential_(i) >= config_.threshold) {
+            spikes.push_back(static_cast<uint32_t>(i));
+            potential_(i) = config_.reset_potential;
+            refractory_(i) = refractory_steps_;
+            excitatory_spikes += static_cast<size_t>(i) < excitatory_count_ ? 1 : 0;
+        }
+    }
+    spike_count_ += spikes.size();
+    ++step_index_;
+
+    // Low-pass filtered population rates (Hz)
+    double window_seconds = config_.resolution_ms / 1000.0;
+    size_t inhibitory_count = size() - excitatory_count_;
+    double excitatory_inst = excitatory_count_ > 0 ?
+        static_cast<double>(excitatory_spikes) / (static_cast<double>(excitatory_count_) * window_seconds) : 0.0;
+    double inhibitory_inst = inhibitory_count > 0 ?
+        static_cast<double>(spikes.size() - excitatory_spikes) / (static_cast<double>(inhibitory_count) * window_seconds) : 0.0;
+    excitatory_rate_ = excitatory_inst + (excitatory_rate_ - excitatory_inst) * rate_decay_;
+    inhibitory_rate_ = inhibitory_inst + (inhibitory_rate_ - inhibitory_inst) * rate_decay_;
+}
+
+} // namespace neurosim
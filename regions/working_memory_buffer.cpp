@@ -0,0 +1,116 @@
+#include "working_memory_buffer.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace neurosim {
+
+WorkingMemoryBuffer::WorkingMemoryBuffer() : WorkingMemoryBuffer(Config{}) {
+}
+
+WorkingMemoryBuffer::WorkingMemoryBuffer(const Config& config) : config_(config) {
+    config_.slots = std::max<size_t>(1, config_.slots);
+    config_.decay_tau_ms = std::max(config_.decay_tau_ms, 1e-9);
+    Eigen::Index slots = static_cast<Eigen::Index>(config_.slots);
+    strengths_.setZero(slots);
+    inverse_norms_.setZero(slots);
+    scores_.setZero(slots);
+}
+
+size_t WorkingMemoryBuffer::update(const Eigen::Ref<const Eigen::VectorXd>& item, double salience, double dt) {
+    decay(dt);
+
+    // Gate: weak items never reach the buffer
+    if (salience < config_.gate_threshold) {
+        return npos;
+    }
+    ensureStorage(item.size());
+    if (items_.rows() == 0 || cosines(item) == 0.0) {
+        return npos;
+    }
+
+    // Refresh the closest held item if it is the same one
+    Eigen::Index best = 0;
+    double best_score = -1.0;
+    for (Eigen::Index slot = 0; slot < strengths_.size(); ++slot) {
+        if (strengths_(slot) > 0.0 && scores_(slot) > best_score) {
+            best_score = scores_(slot);
+            best = slot;
+        }
+    }
+    if (best_score >= config_.match_threshold) {
+        write(static_cast<size_t>(best), item, config_.refresh_rate);
+        strengths_(best) = std::max(strengths_(best), salience);
+        return static_cast<size_t>(best);
+    }
+
+    // Otherwise displace the weakest slot, if the new item is stronger
+    Eigen::Index weakest;
+    strengths_.minCoeff(&weakest);
+    if (strengths_(weakest) >= salience) {
+        return npos;
+    }
+    write(static_cast<size_t>(weakest), item, 1.0);
+    strengths_(weakest) = salience;
+    return static_cast<size_t>(weakest);
+}
+
+void WorkingMemoryBuffer::decay(double dt) {
+    strengths_ *= std::exp(-dt / config_.decay_tau_ms);
+    for (Eigen::Index slot = 0; slot < strengths_.size(); ++slot) {
+        if (strengths_(slot) < config_.min_strength) {
+            strengths_(slot) = 0.0;
+        }
+    }
+}
+
+double WorkingMemoryBuffer::similarity(const Eigen::Ref<const Eigen::VectorXd>& cue) {
+    if (items_.rows() == 0 || cosines(cue) == 0.0) {
+        return 0.0;
+    }
+    return (strengths_.array() * scores_.array().max(0.0)).maxCoeff();
+}
+
+void WorkingMemoryBuffer::clear() {
+    strengths_.setZero();
+    inverse_norms_.setZero();
+    items_.setZero();
+}
+
+double WorkingMemoryBuffer::load() const {
+    return strengths_.mean();
+}
+
+size_t WorkingMemoryBuffer::occupied() const {
+    return static_cast<size_t>((strengths_.array() > 0.0).count());
+}
+
+void WorkingMemoryBuffer::ensureStorage(Eigen::Index dimension) {
+    if (items_.rows() == 0 && dimension > 0) {
+        items_.setZero(dimension, static_cast<Eigen::Index>(config_.slots));
+    }
+}
+
+double WorkingMemoryBuffer::cosines(const Eigen::Ref<const Eigen::VectorXd>& item) {
+    // Cosine of the item against every slot (empty slots score 0); returns 1 / |item|
+    Eigen::Index n = std::min(items_.rows(), item.size());
+    double norm = item.head(n).norm();
+    if (norm == 0.0) {
+        scores_.setZero();
+        return 0.0;
+    }
+    scores_.noalias() = items_.topRows(n).transpose() * item.head(n);
+    scores_.array() *= inverse_norms_.array() * (1.0 / norm);
+    return 1.0 / norm;
+}
+
+void WorkingMemoryBuffer::write(size_t slot, const Eigen::Ref<const Eigen::VectorXd>& item, double blend) {
+    Eigen::Index column = static_cast<Eigen::Index>(slot);
+    Eigen::Index n = std::min(items_.rows(), item.size());
+    items_.col(column) *= 1.0 - blend;
+    items_.col(column).head(n) += blend * item.head(n);
+
+    double norm = items_.col(column).norm();
+    inverse_norms_(column) = norm > 0.0 ? 1.0 / norm : 0.0;
+}
+
+} // namespace neurosim
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <Eigen/Dense>
+
+namespace neurosim {
+
+/**
+ * @brief Fixed-slot working-memory buffer with gated update and decay
+ *
+ * Items are embeddings held in the columns of one matrix (Eigen's
+ * aligned, contiguous storage), each with a strength that decays
+ * exponentially. An update is gated by salience:
+ * - Below the gate threshold nothing is written (items only decay)
+ * - An item close to a held one (cosine >= match_threshold) refreshes it
+ * - Otherwise it replaces the weakest slot, if it is stronger than that
+ *   slot (empty slots have zero strength)
+ *
+ * Storage is sized by the first item (shorter items are zero-padded,
+ * longer ones truncated); after that update() and similarity() do not
+ * allocate. Matching all slots is one matrix-vector product.
+ */
+class WorkingMemoryBuffer {
+public:
+    /**
+     * @brief Buffer parameters
+     */
+    struct Config {
+        size_t slots = 4;                   ///< Items held at once
+        double decay_tau_ms = 2000.0;       ///< Strength decay time constant
+        double gate_threshold = 0.3;        ///< Salience needed to write
+        double match_threshold = 0.9;       ///< Cosine at which an item refreshes a held one
+        double refresh_rate = 0.5;          ///< Blend of a refreshing item into its slot
+        double min_strength = 0.01;         ///< Slots weaker than this are freed
+    };
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+public:
+    WorkingMemoryBuffer();
+
+    /**
+     * @brief Constructor
+     * @param config Buffer parameters
+     */
+    explicit WorkingMemoryBuffer(const Config& config);
+
+    /**
+     * @brief Decay held items, then offer a new one through the gate
+     * @param item Item embedding
+     * @param salience Item salience (strength it is held with)
+     * @param dt Time step in milliseconds
+     * @return Slot written or refreshed, or npos if the gate stayed closed
+     */
+    size_t update(const Eigen::Ref<const Eigen::VectorXd>& item, double salience, double dt);
+
+    /**
+     * @brief Decay held items without offering a new one
+     * @param dt Time step in milliseconds
+     */
+    void decay(double dt);
+
+    /**
+     * @brief Strength-weighted best match of a cue against held items
+     * @param cue Cue embedding
+     * @return max over slots of strength * max(0, cosine) (0 if empty)
+     */
+    double similarity(const Eigen::Ref<const Eigen::VectorXd>& cue);
+
+    /**
+     * @brief Drop all items
+     */
+    void clear();
+
+    /**
+     * @brief Mean strength over all slots (0 = empty, 1 = full at unit salience)
+     */
+    double load() const;
+
+    /**
+     * @brief Number of occupied slots
+     */
+    size_t occupied() const;
+
+    size_t slots() const { return config_.slots; }
+    const Eigen::MatrixXd& items() const { return items_; }
+    const Eigen::VectorXd& strengths() const { return strengths_; }
+    const Config& getConfig() const { return config_; }
+
+private:
+    Config config_;
+    Eigen::MatrixXd items_;                 // dimension x slots
+    Eigen::VectorXd strengths_;             // Held strength per slot (0 = empty)
+    Eigen::VectorXd inverse_norms_;         // 1 / |item| per slot
+    Eigen::VectorXd scores_;                // Scratch: cosine of the offered item per slot
+
+    void ensureStorage(Eigen::Index dimension);
+    double cosines(const Eigen::Ref<const Eigen::VectorXd>& item);
+    void write(size_t slot, const Eigen::Ref<const Eigen::VectorXd>& item, double blend);
+};
+
+} // namespace neurosim
@@ -5,6 +5,9 @@
 
 using namespace neurosim;
 
+void testHighAuditoryLoadWithFlashback();
+void demonstrateExpectedOutput();
+
 /**
  * @brief Basic test of the NeuroSim Engine
  * 
@@ -0,0 +1,354 @@
+#include "../core/memory_overlay.hpp"
+#include "../core/trauma_template_matrix.hpp"
+#include "../core/trauma_cluster_index.hpp"
+#include "../core/trauma_template_library.hpp"
+#include "../core/flashback_overlay.hpp"
+#include "../core/streaming_trigger_detector.hpp"
+#include "../core/fear_conditioning_engine.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace neurosim;
+
+/**
+ * @brief Behavior checks for the memory engines
+ *
+ * Each engine is compared against a straightforward reference (brute-force
+ * scan, direct recomputation) on small inputs.
+ */
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+std::vector<size_t> bruteForce(const MemoryOverlay& overlay, const MemoryOverlay::MemoryFilter& filter) {
+    std::vector<size_t> indices;
+    const auto& memories = overlay.getAllMemories();
+    for (size_t i = 0; i < memories.size(); ++i) {
+        const auto& memory = memories[i];
+        if (filter.traumatic_only && !memory.is_traumatic) continue;
+        if (memory.timestamp < filter.min_timestamp || memory.timestamp > filter.max_timestamp) continue;
+        indices.push_back(i);
+    }
+    return indices;
+}
+
+void testMemoryIndexRing() {
+    MemoryOverlay::MemoryConfig config;
+    config.max_memory_traces = 4;
+    config.index_time_bucket_ms = 2.0;
+    MemoryOverlay overlay(config);
+
+    for (int t = 0; t < 10; ++t) {
+        Eigen::VectorXd content = Eigen::VectorXd::Constant(8, 1.0 + t);
+        if (t % 3 == 0) {
+            overlay.formMemory(content, 0.0, {}, static_cast<double>(t));
+            overlay.addTraumaticMemory(content, 0.8, 0.5);
+        } else {
+            overlay.formMemory(content, 0.0, {}, static_cast<double>(t));
+        }
+    }
+
+    const auto& memories = overlay.getAllMemories();
+    check(memories.size() == 4, "ring keeps max_memory_traces traces");
+    double oldest = memories.front().timestamp;
+    for (const auto& memory : memories) {
+        oldest = std::min(oldest, memory.timestamp);
+    }
+    check(oldest >= 7.0, "ring overwrites the oldest traces");
+
+    MemoryOverlay::MemoryFilter traumatic;
+    traumatic.traumatic_only = true;
+    check(overlay.findMemories(traumatic) == bruteForce(overlay, traumatic), "traumatic filter matches scan");
+
+    MemoryOverlay::MemoryFilter window;
+    window.min_timestamp = 8.0;
+    window.max_timestamp = 9.0;
+    check(overlay.findMemories(window) == bruteForce(overlay, window), "time filter matches scan");
+    check(overlay.getMemoryStats().traumatic_memories == bruteForce(overlay, traumatic).size(),
+          "traumatic count follows overwrites");
+
+    // Shrinking keeps the newest traces in formation order
+    config.max_memory_traces = 2;
+    overlay.updateConfig(config);
+    check(overlay.getAllMemories().size() == 2, "shrink drops to the new capacity");
+    check(overlay.getAllMemories()[0].timestamp <= overlay.getAllMemories()[1].timestamp,
+          "shrink unrolls the ring into formation order");
+    check(overlay.getAllMemories()[1].timestamp == 9.0, "shrink keeps the newest trace");
+    check(overlay.findMemories(MemoryOverlay::MemoryFilter{}).size() == 2, "index rebuilt after shrink");
+}
+
+// Cosine similarity after fitting b to a's length, the way the matrix does
+double fittedCosine(const Eigen::VectorXd& input, const Eigen::VectorXd& pattern, Eigen::Index dim) {
+    Eigen::VectorXd a = Eigen::VectorXd::Zero(dim);
+    Eigen::VectorXd b = Eigen::VectorXd::Zero(dim);
+    a.head(std::min(dim, input.size())) = input.head(std::min(dim, input.size()));
+    b.head(std::min(dim, pattern.size())) = pattern.head(std::min(dim, pattern.size()));
+    if (a.norm() == 0.0 || b.norm() == 0.0) return 0.0;
+    return a.dot(b) / (a.norm() * b.norm());
+}
+
+void testTraumaTemplateMatrix() {
+    std::mt19937 rng(7);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    auto random = [&](Eigen::Index n) {
+        Eigen::VectorXd v(n);
+        for (Eigen::Index i = 0; i < n; ++i) v(i) = normal(rng);
+        return v;
+    };
+
+    // Mixed lengths: the first template fixes the dimension
+    std::vector<Eigen::VectorXd> patterns;
+    std::vector<double> thresholds;
+    for (int i = 0; i < 40; ++i) {
+        patterns.push_back(random(i % 3 == 0 ? 24 : (i % 3 == 1 ? 32 : 40)));
+        thresholds.push_back(0.2 + 0.01 * i);
+    }
+    patterns[0] = random(32);
+
+    TraumaTemplateMatrix matrix;
+    TraumaTemplateMatrix twin;
+    for (size_t i = 0; i < patterns.size(); ++i) {
+        matrix.add(patterns[i], thresholds[i]);
+        twin.add(patterns[i], thresholds[i]);
+        if (i == 10) {
+            // Sharing mid-batch interns the prefix; later adds continue privately
+            check(matrix.sharedPatterns() && matrix.maxScore(patterns[3]) > 0.0, "query between adds");
+        }
+    }
+
+    check(matrix.size() == patterns.size() && matrix.dimension() == 32, "matrix shape");
+    const auto& rows = matrix.patterns();
+    double worst_norm = 0.0;
+    for (Eigen::Index r = 0; r < rows.rows(); ++r) {
+        worst_norm = std::max(worst_norm, std::abs(rows.row(r).norm() - 1.0));
+    }
+    check(worst_norm < 1e-12, "padded and truncated rows are unit norm");
+    check(matrix.sharedPatterns() == twin.sharedPatterns(), "same template list shares one matrix");
+
+    for (int q = 0; q < 20; ++q) {
+        Eigen::VectorXd input = q < 10 ? Eigen::VectorXd(patterns[q * 3] + 0.3 * random(patterns[q * 3].size()))
+                                       : random(28);
+        Eigen::VectorXd scores;
+        matrix.computeScores(input, scores);
+
+        long expected = -1;
+        double best_margin = 0.0;
+        double worst = 0.0;
+        for (size_t i = 0; i < patterns.size(); ++i) {
+            double cosine = fittedCosine(input, patterns[i], 32);
+            worst = std::max(worst, std::abs(std::max(0.0, cosine) - scores(static_cast<Eigen::Index>(i))));
+            double margin = cosine - thresholds[i];
+            if (margin >= 0.0 && (expected < 0 || margin > best_margin)) {
+                expected = static_cast<long>(i);
+                best_margin = margin;
+            }
+        }
+        check(worst < 1e-12, "GEMV scores match per-template cosine");
+        check(matrix.findTriggered(input).index == expected, "findTriggered picks the largest margin");
+    }
+}
+
+void testTraumaClusterIndex() {
+    std::mt19937 rng(11);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    auto random = [&](Eigen::Index n) {
+        Eigen::VectorXd v(n);
+        for (Eigen::Index i = 0; i < n; ++i) v(i) = normal(rng);
+        return v;
+    };
+
+    // Template families: tight clusters around a few random directions
+    const Eigen::Index dim = 48;
+    std::vector<Eigen::VectorXd> centers;
+    for (int f = 0; f < 12; ++f) centers.push_back(random(dim).normalized());
+
+    TraumaTemplateMatrix matrix;
+    for (int i = 0; i < 300; ++i) {
+        Eigen::VectorXd pattern = centers[i % centers.size()] + 0.15 * random(dim) / std::sqrt(double(dim));
+        matrix.add(pattern, 0.75 + 0.002 * (i % 50));
+    }
+
+    TraumaClusterIndex index;
+    index.build(matrix.sharedPatterns(), matrix.thresholds());
+    check(index.depth() > 1, "index splits the template set");
+
+    size_t far_visits = 0;
+    for (int q = 0; q < 40; ++q) {
+        Eigen::VectorXd input = q < 20 ? Eigen::VectorXd(centers[q % centers.size()] + 0.6 * random(dim) / std::sqrt(double(dim)))
+                                       : random(dim);
+        auto expected = matrix.findTriggered(input);
+        auto found = index.query(input);
+        check(found.triggered_template == expected.index, "pruned search finds the largest-margin template");
+        if (expected.index >= 0) {
+            check(std::abs(found.score - expected.score) < 1e-12, "pruned search reports the exact score");
+        }
+        if (q >= 20) {
+            far_visits += index.query(input, 0.5).clusters_visited;
+        }
+    }
+    check(far_visits < 20 * index.nodeCount(), "unrelated inputs skip clusters");
+
+    // Unrelated inputs leave the overlay idle; near-family inputs raise hypervigilance
+    FlashbackOverlay overlay;
+    for (int i = 0; i < 5; ++i) {
+        overlay.addTraumaTemplate(Eigen::VectorXd(centers[0] + 0.05 * random(dim) / std::sqrt(double(dim))), 0.99);
+    }
+    Eigen::VectorXd unrelated = random(dim);
+    unrelated -= unrelated.dot(centers[0]) * centers[0];
+    check(!overlay.checkTrigger(unrelated), "unrelated input does not trigger");
+    check(overlay.getCurrentState().phase == FlashbackOverlay::FlashbackPhase::Idle,
+          "sub-threshold generalization keeps the overlay idle");
+
+    Eigen::VectorXd near = centers[0] + 0.3 * centers[1];
+    check(!overlay.checkTrigger(near), "near-match below threshold does not trigger");
+    check(overlay.getCurrentState().hypervigilance_level > 0.0, "near-match raises hypervigilance");
+}
+
+void testTraumaTemplateLibrary() {
+    auto& library = TraumaTemplateLibrary::instance();
+    Eigen::VectorXd pattern = Eigen::VectorXd::LinSpaced(6, 1.0, 6.0);
+
+    // Same content under another name (or none) is one entry; names alias it
+    auto anonymous = library.intern(pattern);
+    auto first = library.named("library_test_first", [&]() { return Eigen::VectorXd(2.0 * pattern); });
+    auto second = library.named("library_test_second", [&]() { return pattern; });
+    check(first == anonymous && second == anonymous, "named templates reuse interned content");
+    check(library.find("library_test_first") == anonymous && library.find("library_test_second") == anonymous,
+          "every name resolves to the shared entry");
+    check(anonymous->name.empty(), "entry keeps the name it was created under");
+
+    auto other = library.named("library_test_other", [&]() { return Eigen::VectorXd(pattern.reverse()); });
+    check(other != anonymous && other->name == "library_test_other", "different content gets its own entry");
+}
+
+void testStreamingTriggerDetector() {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    // Incremental sums match decayed window sums recomputed from scratch,
+    // while filling, across wraps and across each exact re-accumulation
+    const size_t window = 7;
+    const double decay = 0.8;
+    StreamingTriggerDetector detector(window, decay);
+    std::vector<Eigen::VectorXd> pushed;
+    double worst = 0.0;
+    for (int t = 0; t < 40; ++t) {
+        Eigen::VectorXd step(3);
+        for (Eigen::Index j = 0; j < step.size(); ++j) step(j) = uniform(rng);
+        pushed.push_back(step);
+        const Eigen::VectorXd& scores = detector.push(step);
+
+        Eigen::VectorXd expected = Eigen::VectorXd::Zero(3);
+        double weight_sum = 0.0;
+        double weight = 1.0;
+        for (size_t k = 0; k < std::min(window, pushed.size()); ++k) {
+            expected += weight * pushed[pushed.size() - 1 - k];
+            weight_sum += weight;
+            weight *= decay;
+        }
+        worst = std::max(worst, (scores - expected / weight_sum).cwiseAbs().maxCoeff());
+    }
+    check(worst < 1e-12, "incremental window sums match brute-force decayed sums");
+    check(detector.getFilledSteps() == window, "window fills to its length");
+
+    // A trigger builds up over consecutive matching inputs and fires once per rise
+    FlashbackOverlay::FlashbackConfig config;
+    config.trigger_window_steps = 4;
+    config.trigger_window_decay = 1.0;
+    FlashbackOverlay overlay(config);
+    Eigen::VectorXd trauma = Eigen::VectorXd::Zero(8);
+    trauma(0) = 1.0;
+    Eigen::VectorXd unrelated = Eigen::VectorXd::Zero(8);
+    unrelated(1) = 1.0;
+    overlay.addTraumaTemplate(trauma, 0.6);
+
+    auto feed = [&](const Eigen::VectorXd& input, int steps) {
+        int triggers = 0;
+        for (int t = 0; t < steps; ++t) {
+            triggers += overlay.checkWindowedTrigger(input) ? 1 : 0;
+            overlay.processFlashback(1.0);
+        }
+        return triggers;
+    };
+    check(feed(unrelated, 4) == 0, "unrelated inputs do not trigger");
+    check(feed(trauma, 2) == 0, "two matching inputs in four stay below threshold");
+    check(feed(trauma, 1) == 1, "third matching input triggers");
+    check(overlay.getCurrentState().flashback_active, "windowed trigger starts a flashback");
+    check(feed(trauma, 10) == 0, "window held above threshold does not re-trigger");
+    check(feed(unrelated, 4) == 0 && feed(trauma, 3) == 1, "trigger re-arms after the window drops");
+}
+
+void testFearConditioningEngine() {
+    FearConditioningEngine::LearningParams params;
+    Eigen::VectorXd tone = Eigen::VectorXd::Zero(4);
+    tone(0) = 1.0;
+    Eigen::VectorXd light = Eigen::VectorXd::Zero(4);
+    light(1) = 1.0;
+
+    // Acquisition approaches the US asymptote, extinction returns toward zero
+    FearConditioningEngine single(params, 1, 4);
+    for (int t = 0; t < 40; ++t) single.trial(tone, 1.0);
+    check(std::abs(single.predict(tone) - params.us_asymptote) < 1e-3, "acquisition converges to lambda");
+    check(std::abs(single.predict(light)) < 1e-12, "unpaired stimulus stays neutral");
+    for (int t = 0; t < 60; ++t) single.trial(tone, 0.0);
+    check(single.predict(tone) < 0.01, "extinction removes the association");
+
+    // Per-subject streams match independent single-subject engines
+    FearConditioningEngine cohort(params, 3, 4);
+    Eigen::VectorXd scale(3);
+    scale << 1.0, 0.5, 2.0;
+    cohort.setSubjectRateScale(scale);
+    std::vector<FearConditioningEngine> reference;
+    for (int i = 0; i < 3; ++i) {
+        reference.emplace_back(params, 1, 4);
+        Eigen::VectorXd one = Eigen::VectorXd::Constant(1, scale(i));
+        reference.back().setSubjectRateScale(one);
+    }
+    for (int t = 0; t < 12; ++t) {
+        FearConditioningEngine::RowMatrix stimuli(3, 4);
+        Eigen::VectorXd us(3);
+        for (int i = 0; i < 3; ++i) {
+            stimuli.row(i) = ((t + i) % 2 == 0 ? tone : Eigen::VectorXd(tone + light)).transpose();
+            us(i) = (t + i) % 3 == 0 ? 0.0 : 1.0;
+            reference[static_cast<size_t>(i)].trial(stimuli.row(i).transpose(), us(i));
+        }
+        cohort.trial(stimuli, us);
+    }
+    double worst = 0.0;
+    for (int i = 0; i < 3; ++i) {
+        worst = std::max(worst, (cohort.weights().row(i) - reference[static_cast<size_t>(i)].weights().row(0)).cwiseAbs().maxCoeff());
+    }
+    check(worst < 1e-12, "per-subject trials match separate engines");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Memory engine tests ===" << std::endl;
+
+    testMemoryIndexRing();
+    testTraumaTemplateMatrix();
+    testTraumaClusterIndex();
+    testTraumaTemplateLibrary();
+    testStreamingTriggerDetector();
+    testFearConditioningEngine();
+
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All memory engine checks passed" << std::endl;
+    return 0;
+}
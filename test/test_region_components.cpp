@@ -0,0 +1,612 @@
+#include "../regions/oscillation_detector.hpp"
+#include "../regions/spiking_population.hpp"
+#include "../regions/modulation_scheduler.hpp"
+#include "../regions/pathology_detector.hpp"
+#include "../regions/noise_generator.hpp"
+#include "../regions/working_memory_buffer.hpp"
+#include "../regions/adaptive_filter_bank.hpp"
+#include "../regions/delay_line.hpp"
+#include "../core/region_connectivity.hpp"
+#include "../core/sparse_pattern_memory.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <limits>
+
+using namespace neurosim;
+
+/**
+ * @brief Behavior checks for the streaming region components
+ *
+ * Each component is compared against a direct reference (brute-force
+ * recomputation, a known signal or a closed-form result) on small inputs.
+ */
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+const double PI = 3.14159265358979323846;
+
+void testOscillationDetector() {
+    // Pure tones land in their band at any time step
+    struct Tone {
+        double hz;
+        double dt;
+        OscillationDetector::Band band;
+    };
+    for (const Tone& tone : {Tone{6.0, 1.0, OscillationDetector::Theta}, Tone{10.0, 1.0, OscillationDetector::Alpha},
+                             Tone{20.0, 0.5, OscillationDetector::Beta}, Tone{40.0, 0.25, OscillationDetector::Gamma}}) {
+        OscillationDetector detector;
+        for (int i = 0; i < static_cast<int>(2000.0 / tone.dt); ++i) {
+            double t = i * tone.dt;
+            detector.push(1.0 + std::sin(2.0 * PI * tone.hz * t / 1000.0), tone.dt);
+        }
+        std::string name = std::to_string(static_cast<int>(tone.hz)) + " Hz";
+        check(std::abs(detector.peakFrequency() - tone.hz) < 1e-9, name + " tone peaks at its bin");
+        check(std::abs(detector.frequency() - tone.hz) <= 2.0, name + " tone mean crossings give its frequency");
+        check(detector.dominantBand() == tone.band && detector.isOscillating(), name + " tone dominates its band");
+        check(std::abs(detector.mean() - 1.0) < 1e-3 && std::abs(detector.variance() - 0.5) < 1e-2,
+              name + " tone window statistics");
+    }
+
+    // White noise spreads its power over all bins
+    OscillationDetector detector;
+    std::mt19937 rng(3);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    for (int i = 0; i < 2000; ++i) {
+        detector.push(normal(rng), 1.0);
+    }
+    check(!detector.isOscillating(), "white noise is not an oscillation");
+}
+
+void testSpikingPopulation() {
+    SpikingPopulation::PopulationConfig config;
+    config.neuron_count = 400;
+    config.connections_per_neuron = 40;
+    SpikingPopulation coarse(config);
+    SpikingPopulation fine(config);
+    check(coarse.synapseCount() == config.neuron_count * config.connections_per_neuron, "fixed out-degree");
+    check(coarse.excitatoryCount() == 320, "excitatory share");
+
+    // The internal resolution is fixed, so the caller's dt does not change the spikes
+    for (int t = 0; t < 300; ++t) {
+        double input = t < 150 ? 0.2 : 0.8;
+        coarse.step(input, 1.0);
+        for (int k = 0; k < 4; ++k) {
+            fine.step(input, 0.25);
+        }
+    }
+    check(coarse.spikeCount() > 0 && coarse.spikeCount() == fine.spikeCount(), "spikes do not depend on dt");
+    check((coarse.membranePotentials() - fine.membranePotentials()).abs().maxCoeff() < 1e-9,
+          "potentials do not depend on dt");
+    check(std::abs(coarse.getCurrentTime() - fine.getCurrentTime()) < 1e-9, "time advances by dt");
+
+    // A fresh population with the same seed replays the run
+    SpikingPopulation replay(config);
+    for (int t = 0; t < 300; ++t) {
+        replay.step(t < 150 ? 0.2 : 0.8, 1.0);
+    }
+    check(replay.spikeCount() == coarse.spikeCount(), "same seed gives the same spikes");
+
+    // Stronger drive fires more
+    SpikingPopulation quiet(config);
+    SpikingPopulation driven(config);
+    for (int t = 0; t < 200; ++t) {
+        quiet.step(0.0, 1.0);
+        driven.step(1.0, 1.0);
+    }
+    check(driven.getExcitatoryRate() > quiet.getExcitatoryRate(), "rate grows with input");
+}
+
+void testRegionConnectivity() {
+    RegionConnectivity connectivity;
+    for (const char* name : {"A", "B", "C", "D"}) {
+        connectivity.addRegion(name);
+    }
+    check(connectivity.addRegion("B") == 1 && connectivity.indexOf("E") == RegionConnectivity::npos,
+          "regions are indexed once");
+    connectivity.connect("A", "B", 0.5, 1.0);
+    connectivity.connect("A", "B", 0.25, 1.0);     // Accumulates
+    connectivity.connect("B", "C", -0.3, 4.4);
+    connectivity.connect("C", "A", 0.7, 12.0);
+    connectivity.connect("D", "D", 0.2, 0.1);      // At least one tick
+    connectivity.connect("A", "C", 1.5, 7.0);
+    check(!connectivity.connect("A", "E", 1.0, 1.0), "unknown targets are refused");
+    check(connectivity.connectListed("D", {"A", "E"}) == 1, "listed edges skip unknown targets");
+
+    // u(t) = sum over edges of weight * y_source(t - delay + 1)
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<double> unit(-1.0, 1.0);
+    std::vector<Eigen::VectorXd> outputs;
+    double worst = 0.0;
+    for (int t = 0; t < 100; ++t) {
+        Eigen::VectorXd y(4);
+        for (Eigen::Index r = 0; r < 4; ++r) y(r) = unit(rng);
+        outputs.push_back(y);
+        const Eigen::VectorXd& u = connectivity.propagate(y);
+
+        Eigen::VectorXd expected = Eigen::VectorXd::Zero(4);
+        for (const auto& edge : connectivity.edges()) {
+            int source_tick = t - static_cast<int>(edge.delay_ticks) + 1;
+            if (source_tick >= 0) {
+                expected(static_cast<Eigen::Index>(edge.target)) += edge.weight * outputs[source_tick](edge.source);
+            }
+        }
+        worst = std::max(worst, (u - expected).cwiseAbs().maxCoeff());
+    }
+    check(worst < 1e-12, "propagation matches the delayed edge sum");
+
+    // A reset empties the ring
+    connectivity.reset();
+    Eigen::VectorXd silent = Eigen::VectorXd::Zero(4);
+    check(connectivity.propagate(silent).isZero(), "reset clears delayed outputs");
+}
+
+void testModulationScheduler() {
+    // Heap totals against a list of active modulations
+    struct Active {
+        size_t channel;
+        double strength;
+        double expiry;
+    };
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    ModulationScheduler scheduler(3);
+    std::vector<Active> reference;
+    double worst = 0.0;
+    for (int t = 0; t < 2000; ++t) {
+        double time = static_cast<double>(t);
+        int count = static_cast<int>(unit(rng) * 3.0);
+        for (int k = 0; k < count; ++k) {
+            size_t channel = static_cast<size_t>(unit(rng) * 4.0);  // 3 is out of range
+            double strength = unit(rng) - 0.5;
+            double expiry = time + 1.0 + unit(rng) * 200.0;
+            scheduler.schedule(channel, strength, expiry);
+            if (channel < 3) {
+                reference.push_back({channel, strength, expiry});
+            }
+        }
+        scheduler.advance(time);
+        reference.erase(std::remove_if(reference.begin(), reference.end(),
+                                       [&](const Active& active) { return active.expiry <= time; }),
+                        reference.end());
+
+        double next = std::numeric_limits<double>::infinity();
+        for (size_t channel = 0; channel < 3; ++channel) {
+            double total = 0.0;
+            for (const auto& active : reference) {
+                if (active.channel == channel) {
+                    total += active.strength;
+                }
+                next = std::min(next, active.expiry);
+            }
+            worst = std::max(worst, std::abs(total - scheduler.total(channel)));
+        }
+        check(scheduler.pending() == reference.size() && scheduler.nextExpiry() == next,
+              "pending modulations match the list");
+    }
+    check(worst < 1e-12, "channel totals match the active list");
+    check(scheduler.total(3) == 0.0, "out-of-range channel is ignored");
+
+    scheduler.advance(1e9);
+    check(scheduler.pending() == 0 && scheduler.total(0) == 0.0 && scheduler.total(1) == 0.0 &&
+          scheduler.total(2) == 0.0, "drained totals are exactly zero");
+}
+
+// Quiet baseline followed by a burst; records the flags raised
+struct PathologyFlags {
+    bool baseline_flagged = false;    ///< Any flag during the quiet baseline
+    bool hyperexcitable = false;
+    bool failure = false;
+    bool intrusion = false;
+    bool seizure_at_end = false;
+    double first_hyperexcitable = -1.0;  ///< Burst time at which hyperexcitability was flagged
+};
+
+PathologyFlags runPathology(double dt, double quiet_ms, double burst_ms,
+                            double (*excitation)(double), double inhibition) {
+    PathologyDetector detector;
+    PathologyFlags flags;
+    for (double t = 0.0; t < quiet_ms + burst_ms - 1e-9; t += dt) {
+        bool burst = t >= quiet_ms;
+        detector.push(burst ? excitation(t) : 0.5 + 0.02 * std::sin(t / 7.0), burst ? inhibition : 0.5, dt);
+        if (!burst) {
+            flags.baseline_flagged |= detector.hyperexcitable() || detector.inhibitionFailure() ||
+                                      detector.seizure() || detector.intrusion();
+            continue;
+        }
+        flags.hyperexcitable |= detector.hyperexcitable();
+        flags.failure |= detector.inhibitionFailure();
+        flags.intrusion |= detector.intrusion();
+        flags.seizure_at_end = detector.seizure();
+        if (detector.hyperexcitable() && flags.first_hyperexcitable < 0.0) {
+            flags.first_hyperexcitable = t - quiet_ms;
+        }
+    }
+    return flags;
+}
+
+void testPathologyDetector() {
+    auto high = [](double) { return 4.0; };
+    auto failing = [](double) { return 1.5; };
+    auto seizing = [](double t) { return 2.5 + 1.5 * std::sin(2.0 * PI * 10.0 * t / 1000.0); };
+
+    for (double dt : {1.0, 0.25}) {
+        std::string name = " (dt " + std::to_string(dt) + ")";
+        auto sustained = runPathology(dt, 3000.0, 300.0, high, 1.0);
+        check(!sustained.baseline_flagged, "quiet baseline raises no flags" + name);
+        check(sustained.hyperexcitable && sustained.intrusion, "sustained excitation is flagged" + name);
+        // Persistence share 1 - exp(-t / 100 ms) reaches 0.5 after 69.3 ms
+        check(std::abs(sustained.first_hyperexcitable - 100.0 * std::log(2.0)) <= dt,
+              "hyperexcitability needs the condition to persist" + name);
+
+        auto blip = runPathology(dt, 3000.0, 20.0, high, 1.0);
+        check(!blip.hyperexcitable, "a short blip is not hyperexcitable" + name);
+
+        auto failure = runPathology(dt, 3000.0, 300.0, failing, 0.1);
+        check(failure.failure, "weak inhibition under excitation is a failure" + name);
+
+        auto seizure = runPathology(dt, 3000.0, 300.0, seizing, 1.0);
+        check(seizure.seizure_at_end, "fast high-amplitude excitation is a seizure" + name);
+        check(!sustained.seizure_at_end, "flat excitation is not a seizure once settled" + name);
+    }
+
+    // Baseline mean is an exact EWMA, independent of the step
+    for (double dt : {1.0, 0.1}) {
+        PathologyDetector detector;
+        detector.push(0.0, 0.5, dt);
+        for (double t = dt; t < 1000.0 - 1e-9; t += dt) {
+            detector.push(1.0, 0.5, dt);
+        }
+        double expected = 1.0 - std::exp(-(1000.0 - dt) / 2000.0);
+        check(std::abs(detector.excitatoryMean() - expected) < 1e-9, "baseline mean is an exact EWMA");
+    }
+}
+
+void testNoiseGenerator() {
+    const Eigen::Index n = 200000;
+    NoiseGenerator generator(11, 0);
+    NoiseGenerator::Array samples(n);
+    generator.fill(samples);
+    double mean = samples.mean();
+    double variance = (samples - mean).square().mean();
+    double within = (samples.abs() < 1.0).cast<double>().mean();
+    check(std::abs(mean) < 0.01 && std::abs(variance - 1.0) < 0.02, "normal moments");
+    check(std::abs(within - 0.6827) < 0.005, "normal share within one sigma");
+
+    // Draws depend only on (seed, stream, counter)
+    NoiseGenerator same(11, 0);
+    NoiseGenerator::Array again(n);
+    same.fill(again);
+    check((samples == again).all(), "same seed and stream repeat");
+    same.reseed(11, 0);
+    same.fill(again);
+    check((samples == again).all(), "reseed restarts the sequence");
+
+    NoiseGenerator other(11, 1);
+    NoiseGenerator::Array independent(n);
+    other.fill(independent);
+    double correlation = ((samples - mean) * (independent - independent.mean())).mean() /
+                         std::sqrt(variance * (independent - independent.mean()).square().mean());
+    check(std::abs(correlation) < 0.01, "streams are uncorrelated");
+
+    // normal() serves blocks produced by fill()
+    NoiseGenerator single(11, 0);
+    NoiseGenerator::Array block(64);
+    NoiseGenerator blocked(11, 0);
+    blocked.fill(block);
+    bool matches = true;
+    for (Eigen::Index i = 0; i < block.size(); ++i) {
+        matches &= single.normal() == block(i);
+    }
+    check(matches, "normal() draws the fill() sequence");
+
+    NoiseGenerator::Array uniforms(n);
+    generator.fillUniform(uniforms);
+    check(uniforms.minCoeff() > 0.0 && uniforms.maxCoeff() < 1.0, "uniforms lie in (0, 1)");
+    check(std::abs(uniforms.mean() - 0.5) < 0.005 && std::abs(uniforms.square().mean() - 1.0 / 3.0) < 0.005,
+          "uniform moments");
+}
+
+void testSparsePatternMemory() {
+    std::mt19937 rng(17);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    auto random = [&](Eigen::Index n) {
+        Eigen::VectorXd v(n);
+        for (Eigen::Index i = 0; i < n; ++i) v(i) = normal(rng);
+        return v;
+    };
+
+    SparsePatternMemory::Config config;
+    config.code_bits = 1024;
+    config.active_bits = 32;
+    config.capacity = 150;
+    SparsePatternMemory memory(config);
+
+    std::vector<Eigen::VectorXd> patterns;
+    std::vector<uint64_t> ids;
+    SparsePatternMemory::Code code;
+    for (int i = 0; i < 200; ++i) {
+        patterns.push_back(random(64));
+        memory.encode(patterns.back(), code);
+        check(SparsePatternMemory::activeBits(code) == config.active_bits, "codes keep k winners");
+        ids.push_back(memory.store(code, static_cast<double>(i)));
+    }
+    check(memory.size() == config.capacity, "ring holds capacity episodes");
+    check(!memory.contains(ids[49]) && memory.contains(ids[50]), "oldest episodes are overwritten");
+
+    SparsePatternMemory twin(config);
+    SparsePatternMemory::Code twin_code;
+    twin.encode(patterns[0], twin_code);
+    memory.encode(patterns[0], code);
+    check(code == twin_code, "same seed gives the same code");
+
+    // Exact cues recall their episode; degraded cues are completed to it
+    size_t exact = 0;
+    size_t completed = 0;
+    SparsePatternMemory::Hit hit;
+    for (size_t i = 50; i < patterns.size(); ++i) {
+        memory.encode(patterns[i], code);
+        exact += memory.recall(code, hit) && hit.id == ids[i] && hit.overlap == config.active_bits &&
+                 hit.value == static_cast<double>(i);
+
+        Eigen::VectorXd cue = patterns[i] + 0.4 * random(64);
+        cue.tail(16).setZero();
+        memory.encode(cue, code);
+        completed += memory.recall(code, hit) && hit.id == ids[i];
+    }
+    check(exact == 150, "stored patterns recall themselves");
+    check(completed >= 140, "noisy partial cues recall the stored pattern");
+
+    // topK matches a brute-force overlap scan over the stored episodes
+    std::vector<SparsePatternMemory::Hit> hits;
+    SparsePatternMemory::Code stored;
+    double value = 0.0;
+    for (int q = 0; q < 20; ++q) {
+        memory.encode(q < 10 ? Eigen::VectorXd(patterns[60 + q] + random(64)) : random(64), code);
+        std::vector<size_t> overlaps;
+        for (uint64_t id : ids) {
+            if (memory.get(id, stored, value)) {
+                size_t shared = SparsePatternMemory::overlap(code, stored);
+                if (shared >= 2) overlaps.push_back(shared);
+            }
+        }
+        std::sort(overlaps.rbegin(), overlaps.rend());
+        overlaps.resize(std::min<size_t>(overlaps.size(), 5));
+
+        memory.topK(code, 5, 2, hits);
+        bool same = hits.size() == overlaps.size();
+        for (size_t i = 0; same && i < hits.size(); ++i) {
+            memory.get(hits[i].id, stored, value);
+            same = hits[i].overlap == overlaps[i] && SparsePatternMemory::overlap(code, stored) == overlaps[i];
+        }
+        check(same, "topK matches the overlap scan");
+    }
+
+    memory.clear();
+    memory.encode(patterns[199], code);
+    check(memory.size() == 0 && !memory.recall(code, hit) && !memory.contains(ids[199]), "clear drops every episode");
+}
+
+void testWorkingMemoryBuffer() {
+    WorkingMemoryBuffer::Config config;
+    config.slots = 3;
+    WorkingMemoryBuffer buffer(config);
+    auto unit = [](Eigen::Index i) {
+        Eigen::VectorXd v = Eigen::VectorXd::Zero(6);
+        v(i) = 1.0;
+        return v;
+    };
+
+    check(buffer.update(unit(0), 0.2, 1.0) == WorkingMemoryBuffer::npos && buffer.occupied() == 0,
+          "gate blocks weak items");
+    size_t first = buffer.update(unit(0), 0.8, 1.0);
+    buffer.update(unit(1), 0.6, 1.0);
+    buffer.update(unit(2), 0.5, 1.0);
+    check(buffer.occupied() == 3, "strong items fill the slots");
+
+    // A near copy refreshes its slot instead of taking another
+    Eigen::VectorXd near = unit(0);
+    near(3) = 0.1;
+    check(buffer.update(near, 0.9, 1.0) == first && buffer.occupied() == 3, "near copy refreshes its slot");
+    check(std::abs(buffer.strengths()(first) - 0.9) < 1e-12, "refresh raises the slot strength");
+
+    // A new item displaces the weakest slot only if it is stronger
+    check(buffer.update(unit(4), 0.4, 1.0) == WorkingMemoryBuffer::npos, "weaker item is dropped");
+    size_t replaced = buffer.update(unit(4), 0.7, 1.0);
+    check(replaced != WorkingMemoryBuffer::npos && buffer.similarity(unit(2)) == 0.0, "stronger item replaces the weakest");
+
+    // Similarity is the best strength-weighted cosine, decay is exact at any step
+    Eigen::VectorXd cue = unit(0) + unit(4);
+    double expected = 0.0;
+    for (Eigen::Index slot = 0; slot < buffer.strengths().size(); ++slot) {
+        double cosine = buffer.items().col(slot).dot(cue) / (buffer.items().col(slot).norm() * cue.norm());
+        expected = std::max(expected, buffer.strengths()(slot) * std::max(0.0, cosine));
+    }
+    check(std::abs(buffer.similarity(cue) - expected) < 1e-12, "similarity matches the per-slot cosine");
+
+    WorkingMemoryBuffer coarse = buffer;
+    Eigen::VectorXd before = buffer.strengths();
+    coarse.decay(500.0);
+    for (int i = 0; i < 2000; ++i) {
+        buffer.decay(0.25);
+    }
+    check((buffer.strengths() - coarse.strengths()).cwiseAbs().maxCoeff() < 1e-12 &&
+          std::abs(coarse.strengths()(first) - before(first) * std::exp(-0.25)) < 1e-12,
+          "decay is exponential at any step");
+
+    buffer.decay(20000.0);
+    check(buffer.occupied() == 0 && buffer.load() == 0.0, "faded items free their slots");
+}
+
+void testAdaptiveFilterBank() {
+    // Two channels driven by a known stable VAR(2) process
+    Eigen::MatrixXd lag1(2, 2);
+    lag1 << 1.2, 0.1,
+            0.0, 0.5;
+    Eigen::MatrixXd lag2(2, 2);
+    lag2 << -0.5, 0.0,
+            0.2, 0.0;
+    std::mt19937 rng(5);
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    for (auto algorithm : {AdaptiveFilterBank::Algorithm::RLS, AdaptiveFilterBank::Algorithm::NLMS}) {
+        bool rls = algorithm == AdaptiveFilterBank::Algorithm::RLS;
+        AdaptiveFilterBank::Config config;
+        config.taps = 2;
+        config.algorithm = algorithm;
+        config.forgetting_factor = 1.0;
+        config.step_size = 0.05;
+        AdaptiveFilterBank bank(config);
+
+        Eigen::VectorXd previous = Eigen::VectorXd::Zero(2);
+        Eigen::VectorXd current = Eigen::VectorXd::Zero(2);
+        double error_power = 0.0;
+        const int steps = rls ? 2000 : 40000;
+        for (int t = 0; t < steps; ++t) {
+            Eigen::VectorXd next = lag1 * current + lag2 * previous;
+            next(0) += normal(rng);
+            next(1) += normal(rng);
+            bank.step(next);
+            previous = current;
+            current = next;
+            if (t >= steps - 1000) {
+                error_power += bank.error().squaredNorm() / 2000.0;
+            }
+        }
+
+        // Regressor is the oldest frame, then the newest: [lag2 | lag1]
+        Eigen::MatrixXd expected(2, 4);
+        expected << lag2, lag1;
+        std::string name = rls ? "RLS" : "NLMS";
+        check((bank.weights() - expected).cwiseAbs().maxCoeff() < (rls ? 0.05 : 0.15),
+              name + " converges to the generating coefficients");
+        check(error_power < (rls ? 1.1 : 1.2), name + " error approaches the innovation power");
+    }
+}
+
+void testDelayLine() {
+    auto signal = [](double t) { return std::sin(0.05 * t) + 0.01 * t; };
+
+    // Interpolated reads against the full history
+    DelayLine line;
+    line.configure(37.5, 1.0);
+    std::vector<double> history;
+    double worst = 0.0;
+    for (int t = 0; t < 200; ++t) {
+        history.push_back(signal(t));
+        line.push(history.back());
+        if (t < 40) {
+            continue;
+        }
+        for (double delay : {0.0, 0.3, 7.0, 12.75, 37.5}) {
+            size_t near = static_cast<size_t>(delay);
+            double fraction = delay - static_cast<double>(near);
+            double expected = history[t - near] + (history[t - near - 1] - history[t - near]) * fraction;
+            worst = std::max(worst, std::abs(line.read(delay) - expected));
+        }
+    }
+    check(worst < 1e-12, "delay line interpolates its history");
+    check(line.read(1000.0) == history[history.size() - line.capacity()], "old reads return the oldest sample");
+
+    // Changing the step resamples: a linear signal reads the same afterwards
+    DelayLine ramp;
+    ramp.configure(20.0, 1.0);
+    for (int t = 0; t < 50; ++t) {
+        ramp.push(static_cast<double>(t));
+    }
+    ramp.configure(20.0, 0.5);
+    for (int k = 1; k <= 4; ++k) {
+        ramp.push(49.0 + 0.5 * k);
+    }
+    check(std::abs(ramp.read(10.25) - (51.0 - 10.25)) < 1e-12, "resampled history keeps the signal");
+
+    // A bank reads every channel like its own delay line, also across delay and dt changes.
+    // The bank's ring covers the longest delay, so each reference line does too.
+    const Eigen::Index channels = 5;
+    DelayLineBank bank;
+    bank.resize(channels);
+    std::vector<DelayLine> lines(channels);
+    std::vector<double> delays = {0.0, 2.5, 10.0, 3.25, 17.0};
+    for (Eigen::Index c = 0; c < channels; ++c) {
+        bank.setDelay(c, delays[c]);
+        lines[c].configure(17.0, 1.0);
+    }
+    bank.configure(1.0);
+
+    DelayLineBank::Array values(channels);
+    DelayLineBank::Array out(channels);
+    worst = 0.0;
+    double dt = 1.0;
+    double t = 0.0;
+    for (int step = 0; step < 400; ++step) {
+        if (step == 150) {
+            delays[2] = 30.0;
+            bank.setDelay(2, delays[2]);
+            for (auto& reference : lines) {
+                reference.configure(delays[2], dt);
+            }
+        }
+        if (step == 250) {
+            dt = 0.5;
+            bank.configure(dt);
+            for (auto& reference : lines) {
+                reference.configure(delays[2], dt);
+            }
+        }
+        t += dt;
+        for (Eigen::Index c = 0; c < channels; ++c) {
+            values(c) = signal(t + 13.0 * c);
+            lines[c].push(values(c));
+        }
+        bank.push(values);
+        bank.read(out);
+        for (Eigen::Index c = 0; c < channels; ++c) {
+            worst = std::max(worst, std::abs(out(c) - lines[c].read(delays[c])));
+        }
+    }
+    check(worst < 1e-12, "bank matches per-channel delay lines");
+
+    // Channels added later start with zero history; earlier ones keep theirs
+    bank.resize(channels + 1);
+    out.resize(channels + 1);
+    bank.read(out);
+    check(out(channels) == 0.0 && std::abs(out(1) - lines[1].read(delays[1])) < 1e-12,
+          "growing the bank keeps existing channels");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Region component tests ===" << std::endl;
+
+    testOscillationDetector();
+    testSpikingPopulation();
+    testRegionConnectivity();
+    testModulationScheduler();
+    testPathologyDetector();
+    testNoiseGenerator();
+    testSparsePatternMemory();
+    testWorkingMemoryBuffer();
+    testAdaptiveFilterBank();
+    testDelayLine();
+
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All region component checks passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,602 @@
+#include "../core/simulator.hpp"
+#include "../regions/amygdala.hpp"
+#include "../regions/microcircuit_bank.hpp"
+#include "../regions/parameter_sweep.hpp"
+#include <iostream>
+#include <string>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <utility>
+#include <memory>
+
+using namespace neurosim;
+
+/**
+ * @brief Behavior checks for the region and circuit engines
+ *
+ * Batched, closed-form and indexed paths are compared against the plain
+ * per-step model they replace.
+ */
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+void testAmygdalaTraumaThresholds() {
+    // Unit template and an input at cosine 0.85 to it
+    Eigen::VectorXd pattern = Eigen::VectorXd::Zero(16);
+    pattern(0) = 1.0;
+    Eigen::VectorXd input = Eigen::VectorXd::Zero(16);
+    input(0) = 0.85;
+    input(1) = std::sqrt(1.0 - 0.85 * 0.85);
+
+    BrainRegion::RegionConfig region_config;
+    region_config.region_name = "Amygdala";
+
+    Amygdala::AmygdalaConfig strict;
+    strict.trauma_templates.push_back({TraumaTemplateLibrary::instance().intern(pattern), 0.95});
+    Amygdala amygdala(region_config, strict);
+    amygdala.checkTraumaActivation(input);
+    check(!amygdala.getAmygdalaState().trauma_flashback_triggered, "stored threshold gates activation");
+
+    // Rebuilding from the config keeps each template's own threshold
+    amygdala.updateConfig(strict);
+    amygdala.checkTraumaActivation(input);
+    check(!amygdala.getAmygdalaState().trauma_flashback_triggered, "threshold survives updateConfig");
+
+    amygdala.addTraumaTemplate(pattern, 0.8);
+    amygdala.checkTraumaActivation(input);
+    check(amygdala.getAmygdalaState().trauma_flashback_triggered, "looser template triggers");
+}
+
+void testAmygdalaActiveMemories() {
+    BrainRegion::RegionConfig region_config;
+    region_config.region_name = "Amygdala";
+    Amygdala amygdala(region_config);
+
+    Eigen::VectorXd memory = Eigen::VectorXd::Zero(8);
+    memory(2) = 1.0;
+    amygdala.processInput(1.0, memory);
+    amygdala.processMemoryConsolidation(-0.8, memory);
+
+    // The next step in the same context reactivates the stored memory
+    amygdala.processInput(1.0, memory);
+    const auto& state = amygdala.getAmygdalaState();
+    check(state.active_memory_ids.size() == 1, "processInput populates active memory ids");
+    auto labels = amygdala.getActiveMemoryLabels();
+    check(labels.size() == 1 && labels.front() == "memory_" + std::to_string(state.active_memory_ids.front()),
+          "active memory labels follow the ids");
+
+    Eigen::VectorXd unrelated = Eigen::VectorXd::Zero(8);
+    unrelated(5) = 1.0;
+    amygdala.processInput(1.0, unrelated);
+    check(amygdala.getAmygdalaState().active_memory_ids.empty(), "unrelated context activates nothing");
+}
+
+void testAmygdalaThreatScale() {
+    BrainRegion::RegionConfig region_config;
+    region_config.region_name = "Amygdala";
+    Amygdala amygdala(region_config);
+
+    // Threat follows the routed drive, not the size or length of the fused embedding
+    Eigen::VectorXd context = Eigen::VectorXd::Constant(512, 0.9);
+    amygdala.processInput(0.2, context);
+    double threat = amygdala.getAmygdalaState().threat_level;
+    check(threat < 0.3, "threat does not grow with the embedding");
+    check(amygdala.getAmygdalaState().detected_threats == 0 && amygdala.getDetectedThreats().empty(),
+          "moderate drive detects no threat");
+
+    context = Eigen::VectorXd::Constant(512, 1.0).normalized();
+    amygdala.processInput(0.9, context);
+    check(amygdala.getAmygdalaState().threat_level > 0.5, "strong drive with a unit-norm context is a threat");
+    check(amygdala.getAmygdalaState().detected_threats == Amygdala::HighIntensityStimulus &&
+          amygdala.getDetectedThreats() == std::vector<std::string>{"high_intensity_stimulus"},
+          "strong drive is flagged and named on export");
+}
+
+void testSimulatorAmygdalaThreat() {
+    // A high-threat input through the whole PTSD pipeline still drives the amygdala
+    NeuroSimulator::Config config;
+    config.ptsd_overlay = true;
+    config.inhibition_delay = 50.0;
+    config.log_level = "ERROR";
+    NeuroSimulator sim(config);
+    auto result = sim.processText("I'm scared, loud explosion gunfire");
+    auto amygdala = result.region_activations.find("Amygdala");
+    check(amygdala != result.region_activations.end() && amygdala->second > 0.8,
+          "high-threat PTSD input drives the amygdala above 0.8");
+}
+
+// Noise-free configurations covering every branch of the Euler update
+std::vector<MicroCircuit::CircuitConfig> deterministicConfigs() {
+    MicroCircuit::CircuitConfig base;
+    base.noise_level = 0.0;
+    base.ptsd_memory_intrusion = 0.0;
+
+    std::vector<MicroCircuit::CircuitConfig> configs(5, base);
+    configs[1].autism_mode = true;
+    configs[2].ptsd_mode = true;
+    configs[3].inhibition_delay_line = false;
+    configs[3].inhibition_delay_ms = 30.0;
+    configs[4].autism_mode = true;
+    configs[4].ptsd_mode = true;
+    configs[4].ei_ratio = 1.8;
+    return configs;
+}
+
+double drive(size_t step) {
+    return 0.5 + 0.4 * std::sin(0.01 * static_cast<double>(step));
+}
+
+void testBankMatchesMicroCircuit() {
+    for (double dt : {1.0, 0.5}) {
+        auto configs = deterministicConfigs();
+        MicroCircuitBank bank(1);
+        std::vector<MicroCircuit> circuits;
+        for (const auto& config : configs) {
+            bank.add(config);
+            circuits.emplace_back(config);
+        }
+
+        double worst = 0.0;
+        for (size_t step = 0; step < 3000; ++step) {
+            for (size_t i = 0; i < circuits.size(); ++i) {
+                double input = drive(step) * (1.0 + 0.1 * static_cast<double>(i));
+                bank.addInput(i, input);
+                circuits[i].process(input, dt);
+            }
+            bank.step(dt);
+
+            MicroCircuit::ActivationState banked;
+            for (size_t i = 0; i < circuits.size(); ++i) {
+                bank.getState(i, banked);
+                const auto& state = circuits[i].getCurrentState();
+                worst = std::max({worst,
+                                  std::abs(banked.excitatory_activity - state.excitatory_activity),
+                                  std::abs(banked.inhibitory_activity - state.inhibitory_activity),
+                                  std::abs(banked.firing_rate - state.firing_rate) / 200.0,
+                                  std::abs(banked.adaptation_level - state.adaptation_level),
+                                  std::abs(banked.neurotransmitters.glutamate_level - state.neurotransmitters.glutamate_level),
+                                  std::abs(banked.neurotransmitters.gaba_level - state.neurotransmitters.gaba_level)});
+            }
+        }
+        check(worst < 1e-9, "bank steps match MicroCircuit (dt " + std::to_string(dt) + ")");
+    }
+
+    MicroCircuit::CircuitConfig rk45;
+    rk45.integrator = IntegrationMethod::AdaptiveRK45;
+    MicroCircuitBank bank(1);
+    check(!MicroCircuitBank::supports(rk45) && bank.add(rk45) == MicroCircuitBank::npos,
+          "bank refuses integrators it does not reproduce");
+
+    // A region attached to a bank stages its drive in its slot and reads its state back
+    auto shared = std::make_shared<MicroCircuitBank>(1);
+    BrainRegion::RegionConfig region_config;
+    region_config.circuit_config = deterministicConfigs().front();
+    BrainRegion region(region_config);
+    MicroCircuit reference(region_config.circuit_config);
+    check(region.attachToBank(shared) && !region.attachToBank(shared), "region attaches to a bank once");
+    for (size_t step = 0; step < 200; ++step) {
+        region.processInput(drive(step));
+        reference.process(drive(step), 1.0);
+        shared->step(1.0);
+    }
+    check(std::abs(region.getMicrocircuitState().excitatory_activity -
+                   reference.getCurrentState().excitatory_activity) < 1e-9,
+          "bank-backed region follows its MicroCircuit");
+
+    region_config.circuit_config = rk45;
+    BrainRegion unsupported(region_config);
+    check(!unsupported.attachToBank(shared) && shared->size() == 1,
+          "region keeps its MicroCircuit when the bank refuses it");
+}
+
+// Final state after driving a noise-free circuit for duration ms in steps of dt
+MicroCircuit::ActivationState settle(MicroCircuit::CircuitConfig config, double dt, double duration) {
+    config.noise_level = 0.0;
+    MicroCircuit circuit(config);
+    for (double t = 0.0; t < duration - 1e-9; t += dt) {
+        circuit.process(1.0, dt);
+    }
+    return circuit.getCurrentState();
+}
+
+void testModeGainsAreRates() {
+    // Autism and PTSD gains are per-ms rates, so the trajectory does not depend on dt
+    for (auto integrator : {IntegrationMethod::Exponential, IntegrationMethod::AdaptiveRK45}) {
+        MicroCircuit::CircuitConfig config;
+        config.integrator = integrator;
+        config.autism_mode = true;
+        config.ptsd_mode = true;
+        config.ptsd_memory_intrusion = 0.0;
+        auto coarse = settle(config, 1.0, 2000.0);
+        auto fine = settle(config, 0.25, 2000.0);
+        check(std::abs(coarse.excitatory_activity - fine.excitatory_activity) <
+                  1e-3 * std::max(0.1, fine.excitatory_activity) &&
+              std::abs(coarse.inhibitory_activity - fine.inhibitory_activity) <
+                  1e-3 * std::max(0.1, fine.inhibitory_activity),
+              "mode gains give the same state at dt 1 and 0.25");
+    }
+}
+
+void testAdaptiveStepTerminates() {
+    // A non-finite drive gives a non-finite error norm; the step gives up instead of shrinking forever
+    MicroCircuit::CircuitConfig config;
+    config.integrator = IntegrationMethod::AdaptiveRK45;
+    config.noise_level = 0.0;
+    MicroCircuit circuit(config);
+    circuit.process(std::numeric_limits<double>::quiet_NaN(), 1.0);
+    check(std::isfinite(circuit.getCurrentState().excitatory_activity), "RK45 keeps the last finite state");
+    circuit.process(1.0, 1.0);
+    check(std::isfinite(circuit.getCurrentState().excitatory_activity), "RK45 recovers after a NaN drive");
+}
+
+void testBankGrowth() {
+    // Circuits added after stepping grow the storage and the delay ring; earlier
+    // circuits keep their delayed history
+    auto configs = deterministicConfigs();
+    MicroCircuitBank bank(1);
+    std::vector<MicroCircuit> circuits;
+    double worst = 0.0;
+    for (size_t step = 0; step < 400; ++step) {
+        if (step % 100 == 0) {
+            for (const auto& config : configs) {
+                bank.add(config);
+                circuits.emplace_back(config);
+            }
+        }
+        for (size_t i = 0; i < circuits.size(); ++i) {
+            bank.addInput(i, drive(step));
+            circuits[i].process(drive(step), 1.0);
+        }
+        bank.step(1.0);
+        for (size_t i = 0; i < circuits.size(); ++i) {
+            worst = std::max(worst, std::abs(bank.excitatory()(static_cast<Eigen::Index>(i)) -
+                                             circuits[i].getCurrentState().excitatory_activity));
+        }
+    }
+    check(bank.size() == circuits.size() && bank.capacity() == bank.size(), "bank trims spare capacity");
+    check(worst < 1e-9, "circuits added between steps match MicroCircuit");
+
+    MicroCircuitBank reserved(1);
+    reserved.reserve(64);
+    check(reserved.capacity() == 64 && reserved.size() == 0, "reserve allocates without adding");
+}
+
+void testBankSeedsAndFastForward() {
+    // Seeded banks are deterministic, and a seeded circuit only joins a bank with its seed
+    MicroCircuit::CircuitConfig noisy;
+    noisy.noise_seed = 5;
+    MicroCircuitBank first(5);
+    MicroCircuitBank second(5);
+    MicroCircuit::CircuitConfig other_seed = noisy;
+    other_seed.noise_seed = 6;
+    check(first.add(noisy) == 0 && second.add(noisy) == 0 && first.add(other_seed) == MicroCircuitBank::npos,
+          "bank refuses circuits seeded differently");
+    for (size_t step = 0; step < 100; ++step) {
+        first.addInput(0, drive(step));
+        second.addInput(0, drive(step));
+        first.step(1.0);
+        second.step(1.0);
+    }
+    check(first.excitatory()(0) == second.excitatory()(0), "seeded banks draw the same noise");
+
+    // A slot fast-forwards like its MicroCircuit, delay history included
+    for (double gap : {300.0, 5000.0}) {
+        auto configs = deterministicConfigs();
+        MicroCircuitBank bank(1);
+        std::vector<MicroCircuit> circuits;
+        for (const auto& config : configs) {
+            bank.add(config);
+            circuits.emplace_back(config);
+        }
+        for (size_t step = 0; step < 200; ++step) {
+            for (size_t i = 0; i < circuits.size(); ++i) {
+                bank.addInput(i, drive(step));
+                circuits[i].process(drive(step), 1.0);
+            }
+            bank.step(1.0);
+        }
+        double worst = 0.0;
+        for (size_t i = 0; i < circuits.size(); ++i) {
+            bank.fastForward(i, gap);
+            circuits[i].fastForward(gap);
+        }
+        for (size_t step = 0; step < 50; ++step) {
+            for (size_t i = 0; i < circuits.size(); ++i) {
+                bank.addInput(i, 1.0);
+                circuits[i].process(1.0, 1.0);
+            }
+            bank.step(1.0);
+        }
+        for (size_t i = 0; i < circuits.size(); ++i) {
+            const auto& state = circuits[i].getCurrentState();
+            worst = std::max({worst, std::abs(bank.excitatory()(static_cast<Eigen::Index>(i)) - state.excitatory_activity),
+                              std::abs(bank.inhibitory()(static_cast<Eigen::Index>(i)) - state.inhibitory_activity)});
+        }
+        check(worst < 1e-9, "bank fastForward matches MicroCircuit over a " +
+                            std::to_string(static_cast<int>(gap)) + " ms gap");
+    }
+}
+
+void testSimulatorCircuitBank() {
+    // Bank backing is opt-in; a bank-backed simulator idles long gaps by fast-forward
+    NeuroSimulator::Config config;
+    config.log_level = "ERROR";
+    config.noise_seed = 3;
+    NeuroSimulator unbanked(config);
+    config.circuit_bank = true;
+    config.idle_across_gaps = true;
+    NeuroSimulator banked(config);
+
+    NeuroSimulator::MultiModalInput input;
+    input.text_tokens = "hello";
+    input.visual_embedding = Eigen::VectorXd::Zero(512);
+    input.audio_embedding = Eigen::VectorXd::Zero(256);
+    input.vestibular_embedding = Eigen::VectorXd::Zero(128);
+    input.interoceptive_embedding = Eigen::VectorXd::Zero(64);
+    input.timestamp = 3.6e7;  // Ten hours; stepped once per ms this would take minutes
+    auto result = banked.process(input);
+    check(result.timestamp == input.timestamp && std::isfinite(result.microcircuit_state.excitation),
+          "bank-backed simulator fast-forwards a long gap");
+    check(std::isfinite(unbanked.processText("hello").microcircuit_state.excitation),
+          "default simulator runs without a bank");
+}
+
+void testRegionNoiseStreams() {
+    // Regions sharing a noise seed draw independent noise unless they share a name
+    auto run = [](const std::string& name) {
+        BrainRegion::RegionConfig config;
+        config.region_name = name;
+        config.circuit_config.noise_seed = 7;
+        BrainRegion region(config);
+        for (int step = 0; step < 50; ++step) {
+            region.processInput(0.5);
+        }
+        return region.getMicrocircuitState().excitatory_activity;
+    };
+    check(run("Amygdala") == run("Amygdala"), "same seed and name reproduce the noise");
+    check(run("Amygdala") != run("Insula"), "regions sharing a seed get their own noise stream");
+}
+
+void testFastForwardMatchesStepping() {
+    // Noise-free gaps after a driven period: exact over the transient (which
+    // lasts the whole short gap when inhibition reads the delay line), close once settled
+    for (auto integrator : {IntegrationMethod::Euler, IntegrationMethod::Exponential,
+                            IntegrationMethod::AdaptiveRK45}) {
+        auto configs = deterministicConfigs();
+        for (size_t c = 0; c < configs.size(); ++c) {
+            for (double gap : {300.0, 20000.0}) {
+                if (gap > 1000.0 && c != 0 && c != 2) {
+                    continue;  // Long gaps only for the plain and PTSD circuits (slow to step)
+                }
+                MicroCircuit::CircuitConfig config = configs[c];
+                config.integrator = integrator;
+                config.noise_seed = 1;
+                MicroCircuit skipped(config);
+                MicroCircuit stepped(config);
+                for (int t = 0; t < 200; ++t) {
+                    skipped.process(1.0, 1.0);
+                    stepped.process(1.0, 1.0);
+                }
+                bool closed_form = skipped.fastForward(gap, 1.0);
+                for (double t = 0.0; t < gap; t += 1.0) {
+                    stepped.process(0.0, 1.0);
+                }
+                const auto& a = skipped.getCurrentState();
+                const auto& b = stepped.getCurrentState();
+                double tolerance = gap < 1000.0 && config.inhibition_delay_line ? 1e-9 : 1e-3;
+                check(closed_form && std::abs(a.excitatory_activity - b.excitatory_activity) < tolerance &&
+                          std::abs(a.inhibitory_activity - b.inhibitory_activity) < tolerance &&
+                          std::abs(a.adaptation_level - b.adaptation_level) < 100.0 * tolerance,
+                      "fastForward matches stepping over a " + std::to_string(static_cast<int>(gap)) + " ms gap");
+            }
+        }
+    }
+}
+
+// Noise-free trajectory under drive(); returns E and I per ms
+std::vector<double> trajectory(MicroCircuit::CircuitConfig config, double dt, double duration) {
+    MicroCircuit circuit(config);
+    std::vector<double> samples;
+    size_t per_ms = static_cast<size_t>(std::lround(1.0 / dt));
+    for (size_t step = 0; step < static_cast<size_t>(std::lround(duration / dt)); ++step) {
+        const auto& state = circuit.process(drive(step / per_ms), dt);
+        if ((step + 1) % per_ms == 0) {
+            samples.push_back(state.excitatory_activity);
+            samples.push_back(state.inhibitory_activity);
+        }
+    }
+    return samples;
+}
+
+double maxDifference(const std::vector<double>& a, const std::vector<double>& b) {
+    double worst = 0.0;
+    for (size_t i = 0; i < std::min(a.size(), b.size()); ++i) {
+        worst = std::max(worst, std::abs(a[i] - b[i]));
+    }
+    return a.size() == b.size() ? worst : std::numeric_limits<double>::infinity();
+}
+
+void testIntegratorsAgree() {
+    // The three schemes discretize the same equations: against a tight RK45
+    // reference, Euler and Exponential converge as dt shrinks and RK45 matches
+    for (const auto& base : deterministicConfigs()) {
+        MicroCircuit::CircuitConfig config = base;
+        config.integrator = IntegrationMethod::AdaptiveRK45;
+        config.rk45_tolerance = 1e-9;
+        auto reference = trajectory(config, 0.125, 500.0);
+
+        double coarse[3];
+        double fine[3];
+        for (auto integrator : {IntegrationMethod::Euler, IntegrationMethod::Exponential, IntegrationMethod::AdaptiveRK45}) {
+            config.integrator = integrator;
+            config.rk45_tolerance = 1e-6;
+            size_t i = static_cast<size_t>(integrator);
+            coarse[i] = maxDifference(trajectory(config, 1.0, 500.0), reference);
+            fine[i] = maxDifference(trajectory(config, 0.125, 500.0), reference);
+        }
+        check(fine[0] < 0.2 * coarse[0], "Euler converges to the reference");
+        check(fine[1] < 0.3 * coarse[1] && fine[1] < 0.03, "Exponential converges to the reference");
+        check(fine[2] < 5e-3 && coarse[2] < 0.1, "RK45 matches the reference");
+    }
+}
+
+void testSteadyStateAnalysis() {
+    // A driven circuit settles onto the fixed point, approaching it at the dominant growth rate
+    std::vector<std::pair<MicroCircuit::CircuitConfig, double>> cases;
+    for (const auto& config : deterministicConfigs()) {
+        cases.emplace_back(config, 0.5);
+    }
+    MicroCircuit::CircuitConfig ringing = cases.front().first;
+    ringing.ei_ratio = 1.6;
+    ringing.adaptation_rate = 0.01;
+    cases.emplace_back(ringing, 2.0);
+    for (const auto& [config, input] : cases) {
+        auto analysis = MicroCircuit::analyzeSteadyState(config, input);
+        check(analysis.converged && analysis.stable && analysis.spectral_radius < 1.0, "fixed point found and stable");
+
+        MicroCircuit circuit(config);
+        auto member = circuit.analyzeSteadyState(input);
+        check((member.fixed_point - analysis.fixed_point).cwiseAbs().maxCoeff() < 1e-9 &&
+              std::abs(member.spectral_radius - analysis.spectral_radius) < 1e-9,
+              "configuration analysis matches a fresh circuit");
+
+        auto distance = [&]() {
+            const auto& state = circuit.getCurrentState();
+            MicroCircuit::DynamicsVector current;
+            current << state.excitatory_activity, state.inhibitory_activity, state.neurotransmitters.glutamate_level,
+                state.neurotransmitters.gaba_level, state.adaptation_level;
+            return (current - analysis.fixed_point).cwiseAbs().maxCoeff();
+        };
+        std::vector<double> distances;
+        for (int t = 1; t <= 6000; ++t) {
+            circuit.process(input, 1.0);
+            if (t % 1000 == 0) {
+                distances.push_back(distance());
+            }
+        }
+        check(distances.back() < 1e-3, "circuit settles onto the fixed point");
+        if (!analysis.oscillatory) {
+            double rate = std::log(distances[3] / distances[1]) / 2000.0;
+            check(std::abs(rate - analysis.growth_rate) < 0.05 * std::abs(analysis.growth_rate),
+                  "distance decays at the dominant growth rate");
+        }
+    }
+    check(MicroCircuit::analyzeSteadyState(ringing, 2.0).oscillatory, "adaptation-limited drive rings");
+}
+
+void testParameterSweepAxes() {
+    // Default sweep: every axis moves the circuits and the grid spans several regimes
+    ParameterSweep::SweepConfig config;
+    for (auto& range : config.ranges) {
+        range.steps = std::min<size_t>(range.steps, 4);
+    }
+    ParameterSweep sweep(config);
+    check(sweep.isRunnable() && sweep.inertAxes().empty(), "default sweep has no inert axes");
+    check(sweep.run() == sweep.pointCount(), "default sweep evaluates every point");
+    std::set<uint8_t> regimes;
+    for (const auto& point : sweep.results()) {
+        regimes.insert(point.regime);
+    }
+    check(regimes.size() >= 3 && regimes.count(ParameterSweep::Stable) == 1, "default sweep spans the regimes");
+
+    // The PTSD delay replaces inhibition_delay_ms, so the delay axis must set it
+    auto near = sweep.pointConfig(sweep.pointIndex({0, 0, 0, 0}));
+    auto far = sweep.pointConfig(sweep.pointIndex({0, 3, 0, 0}));
+    check(near.ptsd_inhibition_delay != far.ptsd_inhibition_delay, "delay axis reaches PTSD circuits");
+
+    // Axes without their mode, or integrators the bank does not implement, are refused
+    ParameterSweep::SweepConfig no_modes = config;
+    no_modes.base = MicroCircuit::CircuitConfig{};
+    ParameterSweep inert(no_modes);
+    auto axes = inert.inertAxes();
+    check(axes.size() == 2 && axes[0] == ParameterSweep::AutismInhibitionDeficit &&
+              axes[1] == ParameterSweep::PTSDHyperarousal, "mode axes are inert without their modes");
+    check(inert.run() == 0 && inert.results().empty(), "sweep with inert axes is refused");
+
+    ParameterSweep::SweepConfig rk45 = config;
+    rk45.base.integrator = IntegrationMethod::AdaptiveRK45;
+    check(ParameterSweep(rk45).run() == 0, "sweep with an unsupported integrator is refused");
+}
+
+void testParameterSweepMatchesMicroCircuit() {
+    // Every grid point summarizes what its own MicroCircuit does under the same drive
+    ParameterSweep::SweepConfig config;
+    for (auto& range : config.ranges) {
+        range.steps = 2;
+    }
+    config.base.noise_level = 0.0;
+    config.base.ptsd_memory_intrusion = 0.0;
+    config.duration_ms = 600.0;
+    config.settle_ms = 100.0;
+    config.batch_size = 5;
+    ParameterSweep sweep(config);
+    check(sweep.run() == 16, "small sweep evaluates every point");
+
+    double worst = 0.0;
+    for (size_t point = 0; point < sweep.pointCount(); ++point) {
+        MicroCircuit circuit(sweep.pointConfig(point));
+        double excitation = 0.0, inhibition = 0.0, net = 0.0, rate = 0.0, looping = 0.0, hyperexcitable = 0.0;
+        for (int step = 0; step < 600; ++step) {
+            const auto& state = circuit.process(config.input, 1.0);
+            if (step >= 100) {
+                excitation += state.excitatory_activity / 500.0;
+                inhibition += state.inhibitory_activity / 500.0;
+                net += state.net_activation / 500.0;
+                rate += state.firing_rate / 500.0;
+                looping += (state.excitatory_activity / std::max(0.1, state.inhibitory_activity) > 2.0) / 500.0;
+                hyperexcitable += state.hyperexcitable / 500.0;
+            }
+        }
+        const auto& summary = sweep.results()[point];
+        worst = std::max({worst,
+                          std::abs(summary.mean_excitation - excitation),
+                          std::abs(summary.mean_inhibition - inhibition),
+                          std::abs(summary.mean_net_activation - net),
+                          std::abs(summary.mean_firing_rate - rate) / 200.0,
+                          std::abs(summary.looping_fraction - looping),
+                          std::abs(summary.hyperexcitable_fraction - hyperexcitable)});
+    }
+    check(worst < 1e-5, "sweep summaries match per-point MicroCircuit runs");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Region dynamics tests ===" << std::endl;
+
+    testAmygdalaTraumaThresholds();
+    testAmygdalaActiveMemories();
+    testAmygdalaThreatScale();
+    testSimulatorAmygdalaThreat();
+    testBankMatchesMicroCircuit();
+    testModeGainsAreRates();
+    testAdaptiveStepTerminates();
+    testBankGrowth();
+    testRegionNoiseStreams();
+    testBankSeedsAndFastForward();
+    testSimulatorCircuitBank();
+    testIntegratorsAgree();
+    testSteadyStateAnalysis();
+    testFastForwardMatchesStepping();
+    testParameterSweepAxes();
+    testParameterSweepMatchesMicroCircuit();
+
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All region dynamics checks passed" << std::endl;
+    return 0;
+}